@@ -0,0 +1,296 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "geocode.hpp"
+#include "polygon.hpp"
+#include "impl/parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace spt::geocode
+{
+  /**
+   * An Open Location Code cell packed into 64 bits.  Up to 12 digits are held in 5 bits each, most significant
+   * digit first from the top bit, and the number of digits is held in the low 4 bits.  Cells therefore sort in
+   * the same order as their codes, a cell sorts immediately before its descendants, and all the descendants of a
+   * cell occupy the contiguous range `[rangeMin(), rangeMax()]`.
+   *
+   * Valid lengths are those of full codes: 2, 4, 6, 8, 10, 11 and 12 digits.
+   */
+  class CellId
+  {
+  public:
+    /// The maximum number of digits held.  12 digit cells are roughly 3.5 by 2.8 metres at the equator.
+    static constexpr std::size_t maxLength{ 12 };
+
+    constexpr CellId() = default;
+
+    /// Wrap a packed value, as returned by *value*.
+    constexpr explicit CellId( std::uint64_t value ) : id{ value } {}
+
+    /**
+     * Pack a full Open Location Code.
+     * @param code The code to pack.  Digits beyond *maxLength* are dropped.
+     * @return The cell, or an error string if the code is not a valid full code.
+     */
+    static std::expected<CellId, std::string> fromCode( std::string_view code );
+
+    /**
+     * The cell that contains the specified geo-location.
+     * @param latitude The latitude in degrees.
+     * @param longitude The longitude in degrees.
+     * @param length The number of digits.  Values above *maxLength* are treated as *maxLength*, values below 2 as
+     *   2, and odd values below 10 are rounded up, as for *toLocationCode*.
+     * @return The cell that contains the location.
+     */
+    static CellId fromPoint( double latitude, double longitude, std::size_t length = 10 );
+
+    /**
+     * The cell that contains the specified geo-coordinate point.
+     * @tparam P A geo-coordinate structure that conforms to the *LatLng* concept.
+     * @param point The point.
+     * @param length The number of digits.
+     * @return The cell that contains the point.
+     */
+    template <LatLng P>
+    static CellId fromPoint( const P& point, std::size_t length = 10 ) { return fromPoint( point.latitude, point.longitude, length ); }
+
+    /**
+     * The normalised number of digits for the requested length.
+     * @param length The requested number of digits.
+     * @return A valid length no greater than *maxLength*.
+     */
+    static constexpr std::size_t validLength( std::size_t length )
+    {
+      return std::min( impl::olc::validLength( length ), maxLength );
+    }
+
+    /// The packed value.
+    [[nodiscard]] constexpr std::uint64_t value() const { return id; }
+
+    /// The number of digits in the cell's code, or `0` for the default constructed (invalid) cell.
+    [[nodiscard]] constexpr std::size_t length() const { return static_cast<std::size_t>( id & 0xF ); }
+
+    [[nodiscard]] constexpr bool valid() const { return length() > 0; }
+
+    /// The smallest packed value of the cell and its descendants.
+    [[nodiscard]] constexpr std::uint64_t rangeMin() const { return id & ~mask( length() ); }
+
+    /// The largest packed value of the cell and its descendants.
+    [[nodiscard]] constexpr std::uint64_t rangeMax() const { return id | mask( length() ); }
+
+    /**
+     * The ancestor of the cell with the specified number of digits.
+     * @param length The number of digits of the ancestor.  Normalised as for *fromPoint*.
+     * @return The ancestor, or the cell itself if it is not longer than the requested length.
+     */
+    [[nodiscard]] constexpr CellId parent( std::size_t length ) const
+    {
+      length = validLength( length );
+      if ( length >= this->length() ) return *this;
+      return CellId{ ( id & ~mask( length ) & ~std::uint64_t{ 0xF } ) | length };
+    }
+
+    /// Whether the other cell is this cell or one of its descendants.
+    [[nodiscard]] constexpr bool contains( CellId other ) const
+    {
+      return valid() && other.length() >= length() && other.id >= rangeMin() && other.id <= rangeMax();
+    }
+
+    /// The Open Location Code of the cell.
+    [[nodiscard]] FixedCode code() const;
+
+    /// The area covered by the cell.
+    [[nodiscard]] BoundingBox bounds() const;
+
+    /**
+     * The eight cells of the same length that surround this cell, computed arithmetically from the row and column
+     * of the cell.  Longitudes wrap at the antimeridian.  Neighbours beyond a pole do not exist, and are returned
+     * as invalid cells.
+     * @return The neighbours, starting with the cell to the south west, row by row to the north east.
+     */
+    [[nodiscard]] std::array<CellId, 8> neighbours() const;
+
+    constexpr auto operator<=>( const CellId& ) const = default;
+
+  private:
+    // Bits below the digits of a cell of the specified length, excluding the length field.
+    static constexpr std::uint64_t mask( std::size_t length )
+    {
+      return ( ( std::uint64_t{ 1 } << ( 60 - 5 * length ) ) - 1 ) << 4;
+    }
+
+    std::uint64_t id{ 0 };
+  };
+
+  /**
+   * The set of cells, of mixed lengths, that together cover a polygon.  Cells are refined hierarchically from the
+   * 2 digit cells down, using *PreparedPolygon::relate* to drop cells outside the polygon and to keep cells
+   * entirely inside it without refining them further.  Cells on the boundary are refined while the result stays
+   * within *maxCells*, and complete sets of sibling cells are replaced by their parent.  A query against data
+   * keyed by cell is then a handful of range scans, such as *CellIndex::within*.
+   *
+   * The covering is conservative: every point within the polygon lies in one of the cells, but cells on the
+   * boundary also cover points outside it.
+   *
+   * @param polygon The prepared polygon to cover.
+   * @param maxCells The desired maximum number of cells.  Refining a cell shorter than 10 digits adds up to 400
+   *   cells, and longer cells up to 20, so small values give coarse coverings.  More cells may be returned if
+   *   *minLength* requires.
+   * @param minLength The minimum number of digits of the cells.
+   * @param maxLength The maximum number of digits of the cells.
+   * @return The cells in sorted order.  No cell contains another.
+   */
+  std::vector<CellId> cover( const PreparedPolygon& polygon, std::size_t maxCells = 32,
+    std::size_t minLength = 2, std::size_t maxLength = 10 );
+
+  /**
+   * The set of cells, of mixed lengths, that together cover a polygon.
+   * @param polygon The polygon to cover.  It is prepared once for the covering.
+   * @param maxCells The desired maximum number of cells.
+   * @param minLength The minimum number of digits of the cells.
+   * @param maxLength The maximum number of digits of the cells.
+   * @return The cells in sorted order.  No cell contains another.
+   */
+  inline std::vector<CellId> cover( const Polygon& polygon, std::size_t maxCells = 32,
+    std::size_t minLength = 2, std::size_t maxLength = 10 )
+  {
+    return cover( PreparedPolygon{ polygon }, maxCells, minLength, maxLength );
+  }
+
+  /**
+   * The set of cells, of mixed lengths, that together cover a bounding box.  Cells that only touch the edges of
+   * the box are not included, so a box that matches a cell is covered by that cell alone.
+   * @param bounds The area to cover.  Boxes that cross the antimeridian extend beyond a longitude of 180.
+   * @param maxCells The desired maximum number of cells.
+   * @param minLength The minimum number of digits of the cells.
+   * @param maxLength The maximum number of digits of the cells.
+   * @return The cells in sorted order.  No cell contains another.
+   */
+  std::vector<CellId> cover( const BoundingBox& bounds, std::size_t maxCells = 32,
+    std::size_t minLength = 2, std::size_t maxLength = 10 );
+
+  /**
+   * An index from Open Location Code cells to values, held as sorted flat arrays of packed cells and values.  All
+   * the values in a cell, at any level, are found with two binary searches and returned as a contiguous span, and
+   * the neighbourhood of a cell is found with nine such searches.  There is no tree, and the arrays are compact and
+   * scanned sequentially.
+   *
+   * The index is immutable once built.  Rebuild it to add or remove entries.
+   *
+   * @tparam T The type of value to index, typically a record identifier.
+   */
+  template <typename T>
+  class CellIndex
+  {
+  public:
+    using Entry = std::pair<CellId, T>;
+
+    CellIndex() = default;
+
+    /**
+     * Build an index over the specified entries.  Entries are sorted using multiple threads.
+     * @param entries The cells and their values.  Entries with invalid cells are dropped.
+     */
+    explicit CellIndex( std::vector<Entry> entries )
+    {
+      std::erase_if( entries, []( const Entry& entry ) { return !entry.first.valid(); } );
+      impl::parallelSort( entries, []( const Entry& lhs, const Entry& rhs ) { return lhs.first < rhs.first; } );
+
+      cells.reserve( entries.size() );
+      values.reserve( entries.size() );
+      for ( auto& [cell, value] : entries )
+      {
+        cells.push_back( cell.value() );
+        values.push_back( std::move( value ) );
+      }
+    }
+
+    /**
+     * The values in the specified cell or any of its descendants.
+     * @param cell The cell to look up.
+     * @return The values, in cell order.
+     */
+    [[nodiscard]] std::span<const T> within( CellId cell ) const
+    {
+      if ( !cell.valid() ) return {};
+      return range( cell.rangeMin(), cell.rangeMax() );
+    }
+
+    /**
+     * Invoke the callback with the values indexed at the specified cell and at each of its ancestors, from the
+     * coarsest ancestor down.  These are the entries whose cell contains the specified cell.
+     * @tparam F A callable with signature `void( CellId, std::span<const T> )`.
+     * @param cell The cell to look up.
+     * @param fn The function to invoke for each level that has values.
+     */
+    template <typename F>
+    void containing( CellId cell, F&& fn ) const
+    {
+      for ( const auto length : std::array<std::size_t, 7>{ 2, 4, 6, 8, 10, 11, 12 } )
+      {
+        if ( length > cell.length() ) break;
+        const auto ancestor = cell.parent( length );
+        if ( const auto values = range( ancestor.value(), ancestor.value() ); !values.empty() ) fn( ancestor, values );
+      }
+    }
+
+    /**
+     * The values in the specified cell and in each of its eight neighbours, including their descendants.
+     * @param cell The cell to look up.
+     * @return The values in the cell followed by those in each neighbour, in the order of *CellId::neighbours*.
+     *   Neighbours beyond a pole have no values.
+     */
+    [[nodiscard]] std::array<std::span<const T>, 9> neighbourhood( CellId cell ) const
+    {
+      auto result = std::array<std::span<const T>, 9>{};
+      result[0] = within( cell );
+      const auto others = cell.neighbours();
+      for ( std::size_t i = 0; i < others.size(); ++i ) result[i + 1] = within( others[i] );
+      return result;
+    }
+
+    /// The number of entries in the index.
+    [[nodiscard]] std::size_t size() const { return values.size(); }
+
+    /// The packed cells of the entries, in sorted order.
+    [[nodiscard]] std::span<const std::uint64_t> keys() const { return cells; }
+
+    /// The values of the entries, in the same order as *keys*.
+    [[nodiscard]] std::span<const T> entries() const { return values; }
+
+  private:
+    [[nodiscard]] std::span<const T> range( std::uint64_t min, std::uint64_t max ) const
+    {
+      const auto begin = std::ranges::lower_bound( cells, min );
+      const auto end = std::upper_bound( begin, cells.end(), max );
+      return std::span<const T>{ values }.subspan(
+        static_cast<std::size_t>( begin - cells.begin() ), static_cast<std::size_t>( end - begin ) );
+    }
+
+    std::vector<std::uint64_t> cells;
+    std::vector<T> values;
+  };
+}
+
+template <>
+struct std::hash<spt::geocode::CellId>
+{
+  std::size_t operator()( const spt::geocode::CellId& cell ) const noexcept
+  {
+    return std::hash<std::uint64_t>{}( cell.value() );
+  }
+};
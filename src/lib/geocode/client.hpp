@@ -0,0 +1,312 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "geocode.hpp"
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace spt::geocode
+{
+  namespace impl
+  {
+    class ForwardCache;
+    class ReverseCache;
+    class SessionPool;
+    class WorkQueue;
+
+    /// Queue a task on the worker threads of a *Client*.
+    void submit( WorkQueue& queue, std::move_only_function<void()> task );
+  }
+
+  /// Counters and size of a cache of lookup results.
+  struct CacheStats
+  {
+    /// Lookups answered from the cache.
+    std::uint64_t hits{ 0 };
+
+    /// Lookups not found in the cache, including those for expired entries.
+    std::uint64_t misses{ 0 };
+
+    /// Entries removed to stay within the memory bound.
+    std::uint64_t evictions{ 0 };
+
+    /// Entries removed because they had expired.
+    std::uint64_t expirations{ 0 };
+
+    /// The number of entries held.
+    std::size_t entries{ 0 };
+
+    /// The estimated memory used by the entries.
+    std::size_t bytes{ 0 };
+  };
+
+  /**
+   * Options for caching the results of reverse lookups in a *Client*.  Locations are quantised to a cell, and all
+   * the locations in a cell share the address looked up for the first of them.
+   */
+  struct ReverseCacheOptions
+  {
+    /// The cells that locations are quantised to.
+    enum class Cell : std::uint8_t { LocationCode, Hilbert };
+    Cell cell{ Cell::LocationCode };
+
+    /// The number of Open Location Code digits for *Cell::LocationCode* cells.  10 digits are about 14 metres square.
+    std::size_t codeLength{ 10 };
+
+    /// The level of *Cell::Hilbert* cells.  Level 20 cells are about 19 by 38 metres at the equator.
+    std::size_t level{ 20 };
+
+    /// Time after which a cached address is looked up again.
+    std::chrono::seconds ttl{ std::chrono::hours{ 24 } };
+
+    /// Bound on the estimated memory used by cached addresses.
+    std::size_t maxBytes{ 64 * 1024 * 1024 };
+
+    /// The number of independently locked shards of the cache, rounded up to a power of two.
+    std::size_t shards{ 16 };
+  };
+
+  /**
+   * Options for caching the results of forward lookups in a *Client*.  Addresses are cached under their normalised
+   * form, see *normaliseAddress*, so differently written forms of the same address share one lookup.  Addresses
+   * for which the API returns no results are cached as well, for a shorter time.
+   */
+  struct ForwardCacheOptions
+  {
+    /// Time after which cached coordinates are looked up again.
+    std::chrono::seconds ttl{ std::chrono::hours{ 24 } };
+
+    /// Time after which an address for which no results were returned is looked up again.
+    std::chrono::seconds negativeTtl{ std::chrono::minutes{ 10 } };
+
+    /// Bound on the number of cached addresses.
+    std::size_t maxEntries{ 100'000 };
+
+    /// Bound on the estimated memory used by cached addresses.  `0` bounds the cache by *maxEntries* only.
+    std::size_t maxBytes{ 0 };
+
+    /// The number of independently locked shards of the cache, rounded up to a power of two.
+    std::size_t shards{ 16 };
+  };
+
+  /**
+   * The canonical form of an address used as the key of the forward lookup cache.  Letters are lower cased,
+   * apostrophes are removed, and runs of other punctuation and whitespace become a single space.  Words are then
+   * replaced with their common abbreviations, such as `avenue` with `ave` and `north` with `n`, ordinal numbers with
+   * their digits, such as `fifth` and `5th` with `5`, and `usa` with `us`.  Bytes outside ASCII are kept as is.
+   * @param address The address to normalise.
+   * @return The normalised address, which is empty if the address has no letters or digits.
+   */
+  std::string normaliseAddress( std::string_view address );
+
+  /// Options for a *Client* of the *positionstack* API.
+  struct ClientOptions
+  {
+    /// The *positionstack* API key to use for requests.
+    std::string key;
+
+    /// The base URL of the API, without a trailing slash.  Override to go through a proxy or to a mock server.
+    std::string baseUrl{ "https://api.positionstack.com/v1" };
+
+    /// Maximum number of sessions, and so of open connections and of concurrent requests.
+    std::size_t poolSize{ 4 };
+
+    /// Maximum time to establish a connection, including the TLS handshake.
+    std::chrono::milliseconds connectTimeout{ 5'000 };
+
+    /// Maximum time for a request, including establishing a connection if needed.  `0` waits indefinitely.
+    std::chrono::milliseconds timeout{ 30'000 };
+
+    /// Negotiate HTTP/2 for HTTPS connections, falling back to HTTP/1.1 if the server does not support it.
+    bool http2{ false };
+
+    /**
+     * Maximum number of asynchronous lookups in flight at the same time, which is the number of worker threads
+     * that run them.  Further lookups are queued until a worker is free.  `0` uses *poolSize*.
+     */
+    std::size_t maxInFlight{ 0 };
+
+    /// Maximum number of queries sent in one batch request.  *positionstack* accepts at most 80.
+    std::size_t batchSize{ 80 };
+
+    /// Cache addresses returned by reverse lookups.  Not cached if not set.
+    std::optional<ReverseCacheOptions> reverseCache{ std::nullopt };
+
+    /// Cache coordinates returned by forward lookups.  Not cached if not set.
+    std::optional<ForwardCacheOptions> forwardCache{ std::nullopt };
+  };
+
+  /**
+   * A lookup that is run when awaited in a coroutine.  The awaiting coroutine is suspended while the lookup runs
+   * on one of the worker threads of the *Client*, and resumes on that thread with the result.
+   * @tparam T The result of the lookup.
+   */
+  template <typename T>
+  class AsyncLookup
+  {
+  public:
+    AsyncLookup( impl::WorkQueue& queue, std::move_only_function<T()> work ) :
+      queue{ &queue }, work{ std::move( work ) } {}
+
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+    void await_suspend( std::coroutine_handle<> handle )
+    {
+      impl::submit( *queue, [this, handle]
+      {
+        result.emplace( work() );
+        handle.resume();
+      } );
+    }
+
+    T await_resume() { return std::move( *result ); }
+
+  private:
+    impl::WorkQueue* queue;
+    std::move_only_function<T()> work;
+    std::optional<T> result;
+  };
+
+  /**
+   * A client for the *positionstack* API that reuses connections across lookups.  The client holds a pool of HTTP
+   * sessions, each of which keeps its connection alive between requests, so only the first request on a session
+   * pays for the TCP and TLS handshakes.  Sessions are created on demand up to *ClientOptions::poolSize*, and
+   * lookups wait for a session to become free when all of them are in use.
+   *
+   * Lookups may also be run asynchronously, returning a *std::future* or an awaitable for use in coroutines.
+   * Asynchronous lookups are run by up to *ClientOptions::maxInFlight* worker threads, which share the session
+   * pool with synchronous lookups.  Destroying the client waits for queued asynchronous lookups to complete.
+   *
+   * Sets of lookups may be sent as batch requests, which *positionstack* answers with one result per query.
+   * Results of reverse and forward lookups may be cached, see *ClientOptions::reverseCache* and
+   * *ClientOptions::forwardCache*.
+   *
+   * A client is safe to use from multiple threads.  Create one per API key and share it.
+   */
+  class Client
+  {
+  public:
+    /**
+     * Create a client.  No connection is made until the first lookup.
+     * @param options The API key, pool size and connection options for the client.
+     */
+    explicit Client( ClientOptions options );
+    ~Client();
+
+    Client( const Client& ) = delete;
+    Client& operator=( const Client& ) = delete;
+    Client( Client&& ) noexcept;
+    Client& operator=( Client&& ) noexcept;
+
+    /**
+     * Look up the closest approximate address for the specified geo-location.
+     * @param latitude The latitude for the geo-location to look up closest address for.
+     * @param longitude The longitude for the geo-location to look up closest address for.
+     * @return The returned address or an error string if the lookup fails.
+     */
+    [[nodiscard]] std::expected<Address, std::string> address( double latitude, double longitude ) const;
+
+    /**
+     * Look up the closest approximate address for the specified geo-coordinates.
+     * @param point The geo-coordinates for which the closest address is to be looked up.
+     * @return The returned address or an error string if the lookup fails.
+     */
+    [[nodiscard]] std::expected<Address, std::string> address( const Point& point ) const { return address( point.latitude, point.longitude ); }
+
+    /**
+     * Look up the geo-coordinates for the specified address.
+     * @param address The text address to look up geo-coordinates for.
+     * @return The geo-coordinates for the address or an error string if the lookup fails.
+     */
+    [[nodiscard]] std::expected<Point, std::string> fromAddress( const std::string& address ) const;
+
+    /**
+     * Look up the geo-coordinates for the specified address.
+     * @param address The address to look up geo-coordinates for.
+     * @return The geo-coordinates for the address or an error string if the lookup fails.
+     */
+    [[nodiscard]] std::expected<Point, std::string> fromAddress( const Address& address ) const { return fromAddress( address.text ); }
+
+    /**
+     * Look up the closest approximate addresses for a set of geo-coordinates.  The coordinates are sent in batch
+     * requests of up to *ClientOptions::batchSize* queries, and the requests are sent concurrently on the worker
+     * threads of the client, with the calling thread sending batches as well.
+     * @param points The geo-coordinates for which the closest addresses are to be looked up.
+     * @return The returned address or an error string for each point, in the same order as the points.  A failed
+     *   batch request produces an error for each of the points in the batch.
+     */
+    [[nodiscard]] std::vector<std::expected<Address, std::string>> addresses( std::span<const Point> points ) const;
+
+    /**
+     * Look up the geo-coordinates for a set of addresses.  The addresses are sent in batch requests in the same
+     * way as *addresses*.
+     * @param addresses The text addresses to look up geo-coordinates for.
+     * @return The geo-coordinates or an error string for each address, in the same order as the addresses.  Empty
+     *   addresses produce an error without being sent.
+     */
+    [[nodiscard]] std::vector<std::expected<Point, std::string>> fromAddresses( std::span<const std::string> addresses ) const;
+
+    /**
+     * Look up the closest approximate address for the specified geo-location asynchronously.
+     * @param latitude The latitude for the geo-location to look up closest address for.
+     * @param longitude The longitude for the geo-location to look up closest address for.
+     * @return A future for the returned address or an error string if the lookup fails.
+     */
+    [[nodiscard]] std::future<std::expected<Address, std::string>> addressAsync( double latitude, double longitude ) const;
+
+    /**
+     * Look up the geo-coordinates for the specified address asynchronously.
+     * @param address The text address to look up geo-coordinates for.
+     * @return A future for the geo-coordinates for the address or an error string if the lookup fails.
+     */
+    [[nodiscard]] std::future<std::expected<Point, std::string>> fromAddressAsync( std::string address ) const;
+
+    /**
+     * Look up the closest approximate address for the specified geo-location in a coroutine.
+     * @param latitude The latitude for the geo-location to look up closest address for.
+     * @param longitude The longitude for the geo-location to look up closest address for.
+     * @return An awaitable that produces the returned address or an error string if the lookup fails.
+     */
+    [[nodiscard]] AsyncLookup<std::expected<Address, std::string>> awaitAddress( double latitude, double longitude ) const;
+
+    /**
+     * Look up the geo-coordinates for the specified address in a coroutine.
+     * @param address The text address to look up geo-coordinates for.
+     * @return An awaitable that produces the geo-coordinates for the address or an error string if the lookup fails.
+     */
+    [[nodiscard]] AsyncLookup<std::expected<Point, std::string>> awaitFromAddress( std::string address ) const;
+
+    /// The options the client was created with.
+    [[nodiscard]] const ClientOptions& options() const { return opts; }
+
+    /// The number of sessions created so far, which is at most *ClientOptions::poolSize*.
+    [[nodiscard]] std::size_t sessions() const;
+
+    /// The counters and size of the reverse lookup cache, which are all zero if the cache is not enabled.
+    [[nodiscard]] CacheStats reverseCacheStats() const;
+
+    /// The counters and size of the forward lookup cache, which are all zero if the cache is not enabled.
+    [[nodiscard]] CacheStats forwardCacheStats() const;
+
+  private:
+    ClientOptions opts;
+    std::unique_ptr<impl::SessionPool> pool;
+    std::unique_ptr<impl::ReverseCache> reverseCache;
+    std::unique_ptr<impl::ForwardCache> forwardCache;
+    std::unique_ptr<impl::WorkQueue> queue;
+  };
+}
@@ -0,0 +1,90 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "fenceindex.hpp"
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <string>
+
+namespace spt::geocode
+{
+  /**
+   * Write the prepared fences and the spatial index over them to a binary file, which can then be opened by
+   * *MappedFenceIndex* without parsing or copying.  All references within the file are offsets from its start,
+   * so the file is position independent, and arrays are 8 byte aligned.  The file is written to a temporary file
+   * alongside the destination and renamed into place, so readers never observe a partially written file.
+   *
+   * The format uses the native byte order and IEEE 754 doubles of the writer.  Files are versioned, and readers
+   * reject files with a different version or byte order.
+   *
+   * @param index The fences and index to write.
+   * @param path The path of the file to write.
+   * @return An error message if the file could not be written.
+   */
+  std::expected<void, std::string> writeFenceFile( const FenceIndex& index, const std::filesystem::path& path );
+
+  /**
+   * A read only *FenceIndex* over a file written by *writeFenceFile*, memory mapped so that opening it costs a
+   * header check, a check of the tree nodes and the creation of a small view for each fence.  The vertex and grid
+   * data are read directly from the mapping, and are not read at all when opening, so processes that open the
+   * same file share a single copy in the page cache.
+   *
+   * Opening checks that every array lies within the file, which is enough for a file written by *writeFenceFile*.
+   * The contents of the grid arrays are only checked by *validate*, which reads the whole file.  Call it before
+   * querying a file that may be corrupt or comes from an untrusted source.
+   *
+   * The index and the fences it returns view the mapping, and must not be used (or copied from) once the
+   * *MappedFenceIndex* has been destroyed.
+   */
+  class MappedFenceIndex
+  {
+  public:
+    /// The version of the file format written and read by this library.
+    static constexpr std::uint32_t version{ 1 };
+
+    /**
+     * Open and map the specified file.
+     * @param path The path of a file written by *writeFenceFile*.
+     * @return The mapped index, or an error message if the file could not be opened or is not valid.
+     */
+    static std::expected<MappedFenceIndex, std::string> open( const std::filesystem::path& path );
+
+    /**
+     * Check the contents of the grid arrays of every fence, so that queries stay within the mapping even if the
+     * file is corrupt.  The cost is proportional to the size of the file.
+     * @return An error message if the file is not valid.
+     */
+    [[nodiscard]] std::expected<void, std::string> validate() const;
+
+    ~MappedFenceIndex();
+    MappedFenceIndex( const MappedFenceIndex& ) = delete;
+    MappedFenceIndex& operator=( const MappedFenceIndex& ) = delete;
+    MappedFenceIndex( MappedFenceIndex&& other ) noexcept;
+    MappedFenceIndex& operator=( MappedFenceIndex&& other ) noexcept;
+
+    /// The index over the mapped fences.
+    [[nodiscard]] const FenceIndex& index() const { return fenceIndex; }
+
+    /// The size in bytes of the mapping.
+    [[nodiscard]] std::size_t bytes() const { return length; }
+
+  private:
+    MappedFenceIndex() = default;
+    void release();
+
+    FenceIndex fenceIndex;
+    void* data{ nullptr };
+    std::size_t length{ 0 };
+#if defined( _WIN32 )
+    // No mmap, the file is read into memory instead.
+    std::vector<std::uint64_t> buffer;
+#endif
+
+    friend struct impl::FenceFile;
+  };
+}
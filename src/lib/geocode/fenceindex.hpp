@@ -0,0 +1,196 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "polygon.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace spt::geocode
+{
+  /**
+   * A static R-tree over the bounding boxes of a set of geo-fences, bulk loaded using the Sort-Tile-Recursive (STR)
+   * algorithm.  Queries return the identifiers of all the fences that contain a point, testing only the fences whose
+   * bounding boxes match.  The identifier of a fence is its position in the input used to build the index.
+   *
+   * The index is immutable once built, and may be queried concurrently from multiple threads without locking.
+   */
+  class FenceIndex
+  {
+  public:
+    FenceIndex() = default;
+    ~FenceIndex() = default;
+    FenceIndex( const FenceIndex& other );
+    FenceIndex& operator=( const FenceIndex& other );
+    FenceIndex( FenceIndex&& other ) noexcept;
+    FenceIndex& operator=( FenceIndex&& other ) noexcept;
+
+    /**
+     * Build the index over the specified prepared fences.
+     * @param fences The prepared fences to index.
+     */
+    explicit FenceIndex( std::vector<PreparedPolygon> fences );
+
+    /**
+     * Prepare and build the index over the specified fences.
+     * @param polygons The fences to index.
+     */
+    explicit FenceIndex( std::span<const Polygon> polygons );
+
+    /**
+     * Invoke the callback with the identifier of each fence that contains the specified coordinate.
+     * @tparam F A callable with signature `void( std::size_t )`.
+     * @param latitude The latitude in degrees of the point to look up.
+     * @param longitude The longitude in degrees of the point to look up.
+     * @param fn The callback to invoke for each containing fence.
+     */
+    template <typename F>
+    void visit( double latitude, double longitude, F&& fn ) const
+    {
+      if ( nodes.empty() ) return;
+
+      // Fences that cross the antimeridian have bounding boxes beyond 180, and are matched by the shifted point.
+      const auto wraps = nodes.back().box.maxLongitude > 180.0;
+      const auto shifted = longitude + 360.0;
+
+      // Stack depth is bounded by (fanout - 1) * height + 1, which is checked when a mapped index is loaded.
+      auto stack = std::array<std::uint32_t, stackSize>{};
+      std::size_t top{ 0 };
+      stack[top++] = static_cast<std::uint32_t>( nodes.size() - 1 );
+
+      while ( top > 0 )
+      {
+        const auto index = stack[--top];
+        const auto& node = nodes[index];
+        if ( !node.box.contains( latitude, longitude ) && !( wraps && node.box.contains( latitude, shifted ) ) ) continue;
+
+        if ( index < leaves )
+        {
+          for ( auto i = node.first; i < node.first + node.count; ++i )
+          {
+            if ( fences[entries[i]].contains( latitude, longitude ) ) fn( static_cast<std::size_t>( entries[i] ) );
+          }
+        }
+        else
+        {
+          for ( auto i = node.first; i < node.first + node.count; ++i ) stack[top++] = i;
+        }
+      }
+    }
+
+    /**
+     * Invoke the callback with the identifier of each fence whose bounding box intersects the specified area.
+     * @tparam F A callable with signature `void( std::size_t )`.
+     * @param bounds The area to look up, in the same longitude range as the query points.
+     * @param fn The callback to invoke for each candidate fence.
+     */
+    template <typename F>
+    void visit( const BoundingBox& bounds, F&& fn ) const
+    {
+      if ( nodes.empty() ) return;
+
+      const auto wraps = nodes.back().box.maxLongitude > 180.0;
+      auto shifted = bounds;
+      shifted.minLongitude += 360.0;
+      shifted.maxLongitude += 360.0;
+      const auto matches = [&]( const BoundingBox& box )
+      {
+        return box.intersects( bounds ) || ( wraps && box.intersects( shifted ) );
+      };
+
+      auto stack = std::array<std::uint32_t, stackSize>{};
+      std::size_t top{ 0 };
+      stack[top++] = static_cast<std::uint32_t>( nodes.size() - 1 );
+
+      while ( top > 0 )
+      {
+        const auto index = stack[--top];
+        const auto& node = nodes[index];
+        if ( !matches( node.box ) ) continue;
+
+        if ( index < leaves )
+        {
+          for ( auto i = node.first; i < node.first + node.count; ++i )
+          {
+            if ( matches( fences[entries[i]].bounds() ) ) fn( static_cast<std::size_t>( entries[i] ) );
+          }
+        }
+        else
+        {
+          for ( auto i = node.first; i < node.first + node.count; ++i ) stack[top++] = i;
+        }
+      }
+    }
+
+    /**
+     * Append the identifiers of the fences that contain the specified point to the output vector.
+     * @tparam P A geo-coordinate structure that conforms to the *LatLng* concept.
+     * @param point The point to look up.
+     * @param out The vector to append the identifiers to.  Reuse the vector across calls to avoid allocation.
+     */
+    template <LatLng P>
+    void query( const P& point, std::vector<std::size_t>& out ) const
+    {
+      visit( point.latitude, point.longitude, [&out]( std::size_t id ) { out.push_back( id ); } );
+    }
+
+    /**
+     * Look up the identifiers of the fences that contain the specified point.
+     * @tparam P A geo-coordinate structure that conforms to the *LatLng* concept.
+     * @param point The point to look up.
+     * @return The identifiers of the containing fences, in no particular order.
+     */
+    template <LatLng P>
+    [[nodiscard]] std::vector<std::size_t> query( const P& point ) const
+    {
+      auto out = std::vector<std::size_t>{};
+      query( point, out );
+      return out;
+    }
+
+    /// The prepared fence with the specified identifier.
+    [[nodiscard]] const PreparedPolygon& fence( std::size_t id ) const { return fences[id]; }
+
+    /// The number of fences in the index.
+    [[nodiscard]] std::size_t size() const { return fences.size(); }
+
+    /// Maximum number of children of a node.
+    static constexpr std::uint32_t fanout{ 16 };
+
+    /// Maximum height of the tree above the leaves, so that a traversal fits in the fixed size stack.
+    static constexpr std::uint32_t maxHeight{ 16 };
+
+  private:
+    static constexpr std::size_t stackSize{ ( fanout - 1 ) * maxHeight + 1 };
+
+    struct Node
+    {
+      BoundingBox box;
+      // Range of child nodes, or of entries for leaf nodes.
+      std::uint32_t first{ 0 };
+      std::uint32_t count{ 0 };
+    };
+
+    void build();
+    void bind();
+
+    std::vector<PreparedPolygon> fences;
+    // Fence identifiers in STR order.  Leaf nodes reference contiguous ranges.
+    std::span<const std::uint32_t> entries;
+    // All levels of the tree, leaves first and the root last.
+    std::span<const Node> nodes;
+
+    // Storage for the views when the index is built in memory.  Empty for an index over a mapped file.
+    std::vector<std::uint32_t> entryStorage;
+    std::vector<Node> nodeStorage;
+    bool owned{ true };
+
+    friend struct impl::FenceFile;
+    std::uint32_t leaves{ 0 };
+  };
+}
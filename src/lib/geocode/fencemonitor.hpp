@@ -0,0 +1,241 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "fenceindex.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numbers>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace spt::geocode
+{
+  /// The type of membership change reported by a *FenceMonitor*.
+  enum class FenceTransition : std::uint8_t { Enter, Exit };
+
+  /**
+   * A change in the fence membership of a device.
+   * @tparam Id The type used to identify devices.
+   */
+  template <typename Id>
+  struct FenceEvent
+  {
+    Id device;
+    std::chrono::system_clock::time_point time;
+    std::size_t fence{ 0 };
+    FenceTransition transition{ FenceTransition::Enter };
+  };
+
+  /// Options that control when a *FenceMonitor* re-evaluates the membership of a device.
+  struct FenceMonitorOptions
+  {
+    /**
+     * Minimum distance in metres a device must move from the position at which it was last evaluated before it is
+     * evaluated again.  Suppresses enter/exit flapping from GPS jitter around a boundary.  `0` evaluates every
+     * update that is not skipped by the cell check.
+     */
+    double hysteresis{ 0.0 };
+
+    /**
+     * Size in degrees of the cells used to skip evaluation.  When no fence boundary crosses the cell a device was
+     * last evaluated in, its membership cannot change until it leaves the cell.  `0` disables the cell check.
+     */
+    double cellSize{ 0.01 };
+  };
+
+  /**
+   * Tracks the fence membership of a population of devices from a stream of position updates, and reports the
+   * fences each device enters and exits.
+   *
+   * An update is only evaluated against the index when the device has left the cell it was last evaluated in, or
+   * that cell is crossed by a fence boundary, and the device has moved further than the hysteresis distance.  Most
+   * updates for devices away from fence boundaries are resolved with a hash lookup and a couple of comparisons.
+   *
+   * Updates with a timestamp older than the last accepted update for the device are ignored.
+   *
+   * A monitor is not safe for concurrent updates.  Partition devices across monitors (for instance by hash of the
+   * device identifier) to process updates on multiple threads.
+   *
+   * @tparam Id The type used to identify devices.
+   * @tparam Hash The hash function for device identifiers.
+   */
+  template <typename Id, typename Hash = std::hash<Id>>
+  class FenceMonitor
+  {
+  public:
+    using Clock = std::chrono::system_clock;
+    using Event = FenceEvent<Id>;
+
+    /**
+     * Create a monitor over the specified fences.
+     * @param index The fences to monitor.  Fence identifiers in events are the identifiers in the index.
+     * @param options Options that control when devices are re-evaluated.
+     */
+    explicit FenceMonitor( FenceIndex index, FenceMonitorOptions options = {} ) :
+      fenceIndex{ std::move( index ) }, opts{ options } {}
+
+    /**
+     * Process a position update for a device.
+     * @tparam P A geo-coordinate structure that conforms to the *LatLng* concept.
+     * @param device The identifier of the device.
+     * @param point The reported position of the device.
+     * @param time The time at which the position was reported.
+     * @param out The vector to append enter and exit events to.  Reuse the vector across calls to avoid allocation.
+     * @return The number of events appended to the output vector.
+     */
+    template <LatLng P>
+    std::size_t update( const Id& device, const P& point, Clock::time_point time, std::vector<Event>& out )
+    {
+      const auto latitude = static_cast<double>( point.latitude );
+      const auto longitude = static_cast<double>( point.longitude );
+
+      auto [iter, inserted] = devices.try_emplace( device );
+      auto& state = iter->second;
+      if ( !inserted && time < state.time ) return 0;
+      state.time = time;
+      if ( !inserted && !moved( state, latitude, longitude ) ) return 0;
+
+      const auto cell = cellOf( latitude, longitude );
+      // The index is immutable, so the uniformity of a cell only needs computing when the device enters it.
+      if ( inserted || cell != state.cell ) state.uniform = isUniform( cell );
+      state.cell = cell;
+      state.latitude = latitude;
+      state.longitude = longitude;
+
+      scratch.clear();
+      fenceIndex.visit( latitude, longitude, [this]( std::size_t id ) { scratch.push_back( id ); } );
+      std::ranges::sort( scratch );
+
+      // Both lists are sorted, so a merge yields the fences entered and exited.
+      const auto size = out.size();
+      auto i = state.fences.begin();
+      auto j = scratch.begin();
+      while ( i != state.fences.end() || j != scratch.end() )
+      {
+        if ( j == scratch.end() || ( i != state.fences.end() && *i < *j ) )
+        {
+          out.push_back( Event{ .device = device, .time = time, .fence = *i++, .transition = FenceTransition::Exit } );
+        }
+        else if ( i == state.fences.end() || *j < *i )
+        {
+          out.push_back( Event{ .device = device, .time = time, .fence = *j++, .transition = FenceTransition::Enter } );
+        }
+        else
+        {
+          ++i;
+          ++j;
+        }
+      }
+
+      state.fences.assign( scratch.begin(), scratch.end() );
+      return out.size() - size;
+    }
+
+    /**
+     * Stop tracking a device, and report an exit from each fence it is currently within.
+     * @param device The identifier of the device.
+     * @param time The time to record against the exit events.
+     * @param out The vector to append exit events to.
+     * @return The number of events appended to the output vector.
+     */
+    std::size_t remove( const Id& device, Clock::time_point time, std::vector<Event>& out )
+    {
+      const auto iter = devices.find( device );
+      if ( iter == devices.end() ) return 0;
+
+      for ( const auto fence : iter->second.fences )
+      {
+        out.push_back( Event{ .device = device, .time = time, .fence = fence, .transition = FenceTransition::Exit } );
+      }
+      const auto count = iter->second.fences.size();
+      devices.erase( iter );
+      return count;
+    }
+
+    /**
+     * The fences the device was within as of its last evaluated update.
+     * @param device The identifier of the device.
+     * @return The sorted fence identifiers.  Empty for unknown devices.  Invalidated by the next update for the device.
+     */
+    [[nodiscard]] std::span<const std::size_t> fences( const Id& device ) const
+    {
+      const auto iter = devices.find( device );
+      if ( iter == devices.end() ) return {};
+      return iter->second.fences;
+    }
+
+    /// The number of devices being tracked.
+    [[nodiscard]] std::size_t size() const { return devices.size(); }
+
+    /// The fences being monitored.
+    [[nodiscard]] const FenceIndex& index() const { return fenceIndex; }
+
+  private:
+    struct Cell
+    {
+      std::int32_t row{ 0 };
+      std::int32_t column{ 0 };
+      bool operator==( const Cell& ) const = default;
+    };
+
+    struct State
+    {
+      Clock::time_point time;
+      std::vector<std::size_t> fences;
+      double latitude{ 0.0 };
+      double longitude{ 0.0 };
+      Cell cell;
+      bool uniform{ false };
+    };
+
+    [[nodiscard]] Cell cellOf( double latitude, double longitude ) const
+    {
+      if ( opts.cellSize <= 0.0 ) return {};
+      return Cell{ .row = static_cast<std::int32_t>( std::floor( latitude / opts.cellSize ) ),
+        .column = static_cast<std::int32_t>( std::floor( longitude / opts.cellSize ) ) };
+    }
+
+    [[nodiscard]] bool isUniform( const Cell& cell ) const
+    {
+      if ( opts.cellSize <= 0.0 ) return false;
+
+      const auto bounds = BoundingBox{
+        .minLatitude = cell.row * opts.cellSize, .minLongitude = cell.column * opts.cellSize,
+        .maxLatitude = ( cell.row + 1 ) * opts.cellSize, .maxLongitude = ( cell.column + 1 ) * opts.cellSize };
+
+      bool uniform{ true };
+      fenceIndex.visit( bounds, [&]( std::size_t id )
+      {
+        if ( uniform && fenceIndex.fence( id ).relate( bounds ) == PreparedPolygon::Relation::Partial ) uniform = false;
+      } );
+      return uniform;
+    }
+
+    [[nodiscard]] bool moved( const State& state, double latitude, double longitude ) const
+    {
+      if ( state.uniform && cellOf( latitude, longitude ) == state.cell ) return false;
+      if ( opts.hysteresis <= 0.0 ) return true;
+
+      // Equirectangular approximation, which is accurate to well under a percent over hysteresis scale distances.
+      constexpr double metresPerDegree = 6371008.8 * std::numbers::pi / 180.0;
+      auto dlng = std::abs( longitude - state.longitude );
+      if ( dlng > 180.0 ) dlng = 360.0 - dlng;
+      const auto y = ( latitude - state.latitude ) * metresPerDegree;
+      const auto x = dlng * metresPerDegree * std::cos( ( latitude + state.latitude ) * std::numbers::pi / 360.0 );
+      return x * x + y * y > opts.hysteresis * opts.hysteresis;
+    }
+
+    FenceIndex fenceIndex;
+    std::unordered_map<Id, State, Hash> devices;
+    std::vector<std::size_t> scratch;
+    FenceMonitorOptions opts;
+  };
+}
@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <compare>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
 #include <expected>
@@ -13,10 +17,13 @@
 #include <ranges>
 #include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <boost/math/constants/constants.hpp>
 
+#include "impl/locationcode.hpp"
+
 namespace spt::geocode
 {
   struct Point
@@ -56,20 +63,125 @@ namespace spt::geocode
    */
   inline std::string toLocationCode( const Point& point ) { return toLocationCode( point.latitude, point.longitude ); }
 
+  /**
+   * The number of characters in an Open Location Code with the specified number of significant digits, including
+   * the separator and any padding.
+   * @param codeLength The number of significant digits in the code.  Values above `15` are treated as `15`, values
+   *   below `2` as `2`, and odd values below `10` are rounded up.
+   * @return The number of characters in the code.
+   */
+  constexpr std::size_t locationCodeSize( std::size_t codeLength )
+  {
+    codeLength = impl::olc::validLength( codeLength );
+    return codeLength > 8 ? codeLength + 1 : 9;
+  }
+
+  /**
+   * Convert the specified geo-location to the Open Location Code representation, writing into a caller supplied
+   * buffer.  The code is identical to the one returned by the *std::string* overload for the same code length, and
+   * is computed with integer arithmetic without any heap allocation, at compile time if the arguments are constant.
+   * No terminating null character is written.
+   * @param latitude The latitude in degrees for the geo-location.
+   * @param longitude The longitude in degrees for the geo-location.
+   * @param out The buffer to write the code to.  A buffer of *FixedCode::capacity* characters fits any code.
+   * @param codeLength The number of significant digits in the code, from `2` up to `15`.  Odd lengths below `10`
+   *   are rounded up, as codes of those lengths are not valid.  The default of `10` matches the *std::string*
+   *   overload, and is approximately 13x13 metres at the equator.
+   * @return The number of characters written, or `0` if the buffer is too small for the code.
+   */
+  constexpr std::size_t toLocationCode( double latitude, double longitude, std::span<char> out, std::size_t codeLength = 10 )
+  {
+    if ( out.size() < locationCodeSize( codeLength ) ) return 0;
+    return impl::olc::encode( latitude, longitude, codeLength, out.data() );
+  }
+
+  /**
+   * Encode a batch of geo-locations held in structure-of-arrays form as fixed width Open Location Codes written
+   * back to back into a single buffer.  Code `i` occupies `out[i * w, (i + 1) * w)` where `w` is
+   * *locationCodeSize( codeLength )*, and is identical to the code returned by *toLocationCode* for the same
+   * point and code length.
+   *
+   * The coordinates are converted to integer grid values a block at a time in a loop the compiler can vectorise,
+   * and the digits are extracted with lookup tables.  Large batches are split across threads.
+   * @param latitudes The latitudes in degrees of the points to encode.
+   * @param longitudes The longitudes in degrees of the points to encode.
+   * @param out The buffer to write the codes to.  No terminating null characters are written.
+   * @param codeLength The number of significant digits in each code, adjusted as for *toLocationCode*.
+   * @return The number of codes written, which is `min( latitudes.size(), longitudes.size(), out.size() / w )`.
+   */
+  std::size_t encodeBatch( std::span<const double> latitudes, std::span<const double> longitudes,
+    std::span<char> out, std::size_t codeLength = 10 );
+
+  /**
+   * An Open Location Code held inline, for use as a cache or partition key without heap allocation.  Holds codes
+   * of up to 15 digits and the separator.
+   */
+  class FixedCode
+  {
+  public:
+    /// The maximum number of characters in a code, including the separator.
+    static constexpr std::size_t capacity{ 16 };
+
+    constexpr FixedCode() = default;
+
+    /**
+     * Encode the specified geo-location.
+     * @param latitude The latitude in degrees for the geo-location.
+     * @param longitude The longitude in degrees for the geo-location.
+     * @param codeLength The number of significant digits in the code, up to `15`.
+     */
+    constexpr FixedCode( double latitude, double longitude, std::size_t codeLength = 10 ) :
+      length{ static_cast<std::uint8_t>( toLocationCode( latitude, longitude, chars, codeLength ) ) } {}
+
+    /**
+     * Encode the specified geo-coordinate point.
+     * @param point The *Point* representing the geo-coordinates to be encoded.
+     * @param codeLength The number of significant digits in the code, up to `15`.
+     */
+    constexpr explicit FixedCode( const Point& point, std::size_t codeLength = 10 ) :
+      FixedCode( point.latitude, point.longitude, codeLength ) {}
+
+    /**
+     * Hold an existing code.  The characters are copied as is, without validation.
+     * @param code The code to hold.  Characters beyond *capacity* are dropped.
+     */
+    constexpr explicit FixedCode( std::string_view code ) : length{ static_cast<std::uint8_t>( std::min( code.size(), capacity ) ) }
+    {
+      std::copy_n( code.data(), length, chars.data() );
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const { return { chars.data(), length }; }
+    [[nodiscard]] std::string str() const { return std::string{ view() }; }
+    [[nodiscard]] constexpr const char* data() const { return chars.data(); }
+    [[nodiscard]] constexpr std::size_t size() const { return length; }
+    [[nodiscard]] constexpr bool empty() const { return length == 0; }
+
+    constexpr operator std::string_view() const { return view(); }
+
+    constexpr bool operator==( const FixedCode& other ) const { return view() == other.view(); }
+    constexpr auto operator<=>( const FixedCode& other ) const { return view() <=> other.view(); }
+
+  private:
+    std::array<char, capacity> chars{};
+    std::uint8_t length{ 0 };
+  };
+
   /**
    * Decode the Open Location Code value to a representative geo-coordinate point.
    *
    * **Note:** The Google API returns a pair of coordinates that represent the code.  Our implementation returns the
-   * average values for the latitude and longitude.
-   * @param code Convert the specified Open Location Code to a representative geo-coordinate point.
-   * @return The decoded geo-coordinate, or an error string if the specified code is invalid.
+   * centre of the area they represent, with the number of significant digits in the code as the accuracy.
+   * @param code Convert the specified full Open Location Code to a representative geo-coordinate point.
+   * @return The decoded geo-coordinate, or an error string if the specified code is invalid or is a short code.
    */
-  std::expected<Point, std::string> fromLocationCode( const std::string& code );
+  std::expected<Point, std::string> fromLocationCode( std::string_view code );
 
-  inline std::expected<Point, std::string> fromLocationCode( std::string_view code ) { return fromLocationCode( std::string{ code } ); };
+  inline std::expected<Point, std::string> fromLocationCode( const std::string& code ) { return fromLocationCode( std::string_view{ code } ); };
 
   /**
    * Look up the closest approximate address for the specified geo-location from the *positionstack* API.
+   * Connections are reused across calls, without limiting concurrent lookups or adding timeouts.  Use *Client* to
+   * bound concurrency and set timeouts.
    * @param latitude The latitude for the geo-location to look up closest address for.
    * @param longitude The longitude for the geo-location to look up closest address for.
    * @param key The *positionstack* API key to use to make the request to their web service.
@@ -86,7 +198,8 @@ namespace spt::geocode
   inline std::expected<Address, std::string> address( const Point& point, const std::string& key ) { return address( point.latitude, point.longitude, key ); }
 
   /**
-   * Look up the geo-coordinates for the specified address usnig the *positionstack* API.
+   * Look up the geo-coordinates for the specified address usnig the *positionstack* API.  Connections are reused
+   * as for *address*.
    * @param address The text address to look up geo-coordinates for.
    * @param key The *positionstack* API key to use to make the request to their web service.
    * @return The geo-coordinates for the address or an error string if the lookup fails.
@@ -103,6 +216,163 @@ namespace spt::geocode
 
   using Polygon = std::vector<Point>;
 
+  /**
+   * An axis aligned box in geo-coordinate space.  Latitudes and longitudes are in degrees.
+   */
+  struct BoundingBox
+  {
+    double minLatitude{ std::numeric_limits<double>::max() };
+    double minLongitude{ std::numeric_limits<double>::max() };
+    double maxLatitude{ std::numeric_limits<double>::lowest() };
+    double maxLongitude{ std::numeric_limits<double>::lowest() };
+
+    /**
+     * Grow the box to include the specified coordinate.
+     * @param latitude The latitude in degrees to include in the box.
+     * @param longitude The longitude in degrees to include in the box.
+     */
+    void extend( double latitude, double longitude )
+    {
+      minLatitude = std::min( minLatitude, latitude );
+      minLongitude = std::min( minLongitude, longitude );
+      maxLatitude = std::max( maxLatitude, latitude );
+      maxLongitude = std::max( maxLongitude, longitude );
+    }
+
+    [[nodiscard]] bool contains( double latitude, double longitude ) const
+    {
+      return latitude >= minLatitude && latitude <= maxLatitude &&
+        longitude >= minLongitude && longitude <= maxLongitude;
+    }
+
+    [[nodiscard]] bool intersects( const BoundingBox& other ) const
+    {
+      return minLatitude <= other.maxLatitude && maxLatitude >= other.minLatitude &&
+        minLongitude <= other.maxLongitude && maxLongitude >= other.minLongitude;
+    }
+
+    [[nodiscard]] bool empty() const { return minLatitude > maxLatitude || minLongitude > maxLongitude; }
+  };
+
+  /// The area represented by an Open Location Code.
+  struct CodeArea
+  {
+    /// The bounds of the area, rounded to 14 decimal places as in the reference implementation.
+    BoundingBox bounds;
+    /// The centre of the area.  The accuracy is the number of significant digits in the code.
+    Point centre;
+    /// The number of significant digits in the code, excluding the separator and padding.
+    std::size_t length{ 0 };
+  };
+
+  /**
+   * Validate and decode a full Open Location Code in a single pass over its characters, using integer arithmetic
+   * and without any heap allocation when the code is valid.  Constant codes may be decoded at compile time.
+   * Digits beyond the fifteenth are validated but do not affect the area, and lower case characters are accepted.
+   * @param code The code to decode.
+   * @return The area represented by the code, or an error string if the code is invalid or is a short code, which
+   *   cannot be decoded without a reference location.
+   */
+  constexpr std::expected<CodeArea, std::string> decodeLocationCode( std::string_view code )
+  {
+    using O = std::expected<CodeArea, std::string>;
+
+    auto area = impl::olc::Area{};
+    const auto kind = impl::olc::decode( code, area );
+    if ( kind == impl::CodeKind::Short ) return O{ std::unexpect, "Short code cannot be decoded without a reference location" };
+    if ( kind == impl::CodeKind::Invalid ) return O{ std::unexpect, "Invalid code" };
+
+    auto out = O{ std::in_place };
+    out->bounds.minLatitude = area.minLatitude;
+    out->bounds.minLongitude = area.minLongitude;
+    out->bounds.maxLatitude = area.maxLatitude;
+    out->bounds.maxLongitude = area.maxLongitude;
+    out->centre.latitude = area.centreLatitude();
+    out->centre.longitude = area.centreLongitude();
+    out->centre.accuracy = static_cast<double>( area.length );
+    out->length = area.length;
+    return out;
+  }
+
+  /**
+   * A reference location for shortening full Open Location Codes, and for recovering the nearest full code from a
+   * short code, as exchanged by parties that share a nearby location such as a depot.  The reference location and
+   * the leading digits of its own code are computed once and reused for every code, and each code is validated
+   * and decoded in a single pass without heap allocation.  Results match *Shorten* and *RecoverNearest* of the
+   * reference implementation, except that all the digits of a code are never removed.
+   */
+  class LocationCodeReference
+  {
+  public:
+    /**
+     * Create a reference for the specified geo-location.
+     * @param latitude The latitude in degrees.  Clamped to `[-90, 90]`.
+     * @param longitude The longitude in degrees.  Normalised to `[-180, 180)`.
+     */
+    LocationCodeReference( double latitude, double longitude );
+
+    /**
+     * Create a reference for the specified geo-coordinate point.
+     * @param point The reference point.
+     */
+    explicit LocationCodeReference( const Point& point ) : LocationCodeReference( point.latitude, point.longitude ) {}
+
+    /**
+     * Remove as many leading digits from a full code as the distance to the reference location allows.
+     * @param code The full code to shorten.  Characters beyond *FixedCode::capacity* are dropped from the result.
+     * @return The short code, the full code itself if it is padded or too far from the reference to shorten, or
+     *   an error string if the code is invalid or is not a full code.
+     */
+    [[nodiscard]] std::expected<FixedCode, std::string> shorten( std::string_view code ) const;
+
+    /**
+     * Recover the full code nearest to the reference location from a short code.
+     * @param code The short code to recover.  Full codes are returned as is, in upper case.
+     * @return The full code, or an error string if the code is invalid.
+     */
+    [[nodiscard]] std::expected<FixedCode, std::string> recover( std::string_view code ) const;
+
+    /// The clamped and normalised reference location.
+    [[nodiscard]] Point location() const { return Point{ .latitude = latitude, .longitude = longitude }; }
+
+  private:
+    double latitude;
+    double longitude;
+    // The code of the reference location, whose leading digits are prefixed to short codes to recover them.  Not
+    // set at the north pole, where the latitude is adjusted for the length of each code.
+    FixedCode padding;
+  };
+
+  /**
+   * Shorten a batch of full Open Location Codes relative to the same reference location.  Large batches are split
+   * across threads.
+   * @param reference The reference location.
+   * @param codes The full codes to shorten.
+   * @param out Set to the result of *LocationCodeReference::shorten* for each code.  Only the first
+   *   `min( codes.size(), out.size() )` codes are shortened.
+   * @return The number of codes processed.
+   */
+  std::size_t shortenLocationCodes( const Point& reference, std::span<const std::string_view> codes,
+    std::span<std::expected<FixedCode, std::string>> out );
+
+  std::size_t shortenLocationCodes( const Point& reference, std::span<const std::string> codes,
+    std::span<std::expected<FixedCode, std::string>> out );
+
+  /**
+   * Recover a batch of short Open Location Codes relative to the same reference location.  Large batches are split
+   * across threads.
+   * @param reference The reference location.
+   * @param codes The short codes to recover.
+   * @param out Set to the result of *LocationCodeReference::recover* for each code.  Only the first
+   *   `min( codes.size(), out.size() )` codes are recovered.
+   * @return The number of codes processed.
+   */
+  std::size_t recoverLocationCodes( const Point& reference, std::span<const std::string_view> codes,
+    std::span<std::expected<FixedCode, std::string>> out );
+
+  std::size_t recoverLocationCodes( const Point& reference, std::span<const std::string> codes,
+    std::span<std::expected<FixedCode, std::string>> out );
+
   /**
    * Check whether the geo-coordinate falls within the specified geo-fence.
    * @param point The point to check within bounds.
@@ -262,20 +532,38 @@ namespace spt::geocode
     return Distance{ .distance = dis, .azimuth = azi1 };
   }
 
+  /**
+   * Summary statistics for the members of a cluster, computed from the distances already known during the
+   * final assignment of the clustering algorithm.  The number of members is the size of the cluster's *points*.
+   */
+  struct ClusterStatistics
+  {
+    BoundingBox bounds;
+    /// Distance in metres from the centroid to the farthest member of the cluster.
+    double radius{ 0.0 };
+    /// Mean distance in metres of the members from the centroid.
+    double meanDistance{ 0.0 };
+  };
+
   template <LatLng P>
   struct Cluster
   {
     P centroid;
     std::vector<const P*> points;
+    /// Not set for clusters to which no points were assigned.
+    std::optional<ClusterStatistics> statistics{ std::nullopt };
   };
 
   /**
    * Apply k-means clustering algorithm to cluster the set of coordinates around the specified number of centroids.
    * @tparam P A type that represents a geo-coordinate that conforms to the *LatLng* concept.
    * @param points The geo-coordinates that are to be clustered.
-   * @param rounds  The number of rounds the algorithm is to be applied to perform the clustering.
+   * @param rounds  The number of rounds the algorithm is to be applied to perform the clustering.  The points are
+   *   assigned to the nearest centroid in each round, and the centroids are moved to the centre of their members
+   *   between rounds.  At least one round is run.
    * @param numClusters The number of clusters to aggregate the coordinates into.
    * @return A vector of the clustered coordinates.  The vector is sorted in descending order of density around the centroids.
+   *   Each non-empty cluster has its *statistics* populated from the distances found by the last assignment.
    */
   template <LatLng P>
   std::vector<Cluster<P>> cluster( const std::vector<P>& points, const int rounds, int numClusters )
@@ -294,6 +582,8 @@ namespace spt::geocode
       vec.front().centroid.latitude = points.front().latitude;
       vec.front().centroid.longitude = points.front().longitude;
       vec.front().points.push_back( &points.front() );
+      vec.front().statistics = ClusterStatistics{};
+      vec.front().statistics->bounds.extend( points.front().latitude, points.front().longitude );
       return vec;
     }
 
@@ -319,7 +609,8 @@ namespace spt::geocode
       centroids.back().longitude = p.longitude;
     }
 
-    for ( int i = 0; i < rounds; ++i )
+    const auto total = std::max( rounds, 1 );
+    for ( int i = 0; i < total; ++i )
     {
       // For each centroid, compute distance from centroid to each point
       // and update point's cluster if necessary
@@ -329,7 +620,10 @@ namespace spt::geocode
 
         for ( auto& p : vec )
         {
-          if ( const auto [dist, azimuth] = distance( *c, *p.point ); dist < p.minDist )
+          // Vincenty's formula is undefined for coincident points, such as a centroid seeded from the point.
+          auto dist = distance( *c, *p.point ).distance;
+          if ( std::isnan( dist ) ) dist = 0.0;
+          if ( dist < p.minDist )
           {
             p.minDist = dist;
             p.cluster = clusterId;
@@ -337,6 +631,9 @@ namespace spt::geocode
         }
       }
 
+      // Keep the distances from the last assignment for the cluster statistics.
+      if ( i + 1 == total ) break;
+
       // Create vectors to keep track of data needed to compute new centroids
       auto aggregates = std::vector<std::vector<const P*>>( numClusters, std::vector<const P*>{} );
       for ( auto& agg : aggregates ) agg.reserve( static_cast<int>( points.size() ) / numClusters );
@@ -344,9 +641,7 @@ namespace spt::geocode
       // Iterate over points to append data to centroids
       for ( auto& p : vec )
       {
-        auto idx = p.cluster;
-        if ( idx < 0 ) idx = 0; // Some edge case
-        aggregates[idx].push_back( p.point );
+        aggregates[p.cluster].push_back( p.point );
         p.minDist = std::numeric_limits<double>::max();  // reset distance
       }
 
@@ -370,9 +665,31 @@ namespace spt::geocode
       out.back().points.reserve( points.size() / numClusters );
     }
 
-    for ( const auto p : vec ) out[p.cluster].points.push_back( p.point );
+    for ( const auto& p : vec )
+    {
+      auto& c = out[p.cluster];
+      c.points.push_back( p.point );
+      if ( !c.statistics ) c.statistics = ClusterStatistics{};
+      c.statistics->bounds.extend( p.point->latitude, p.point->longitude );
+      c.statistics->radius = std::max( c.statistics->radius, p.minDist );
+      c.statistics->meanDistance += p.minDist;
+    }
+
+    for ( auto& c : out )
+    {
+      if ( c.statistics ) c.statistics->meanDistance /= static_cast<double>( c.points.size() );
+    }
     std::ranges::sort( out, []( const Cluster<P>& lhs, const Cluster<P>& rhs ) { return lhs.points.size() > rhs.points.size(); } );
 
     return out;
   }
-}
\ No newline at end of file
+}
+
+template <>
+struct std::hash<spt::geocode::FixedCode>
+{
+  std::size_t operator()( const spt::geocode::FixedCode& code ) const noexcept
+  {
+    return std::hash<std::string_view>{}( code.view() );
+  }
+};
@@ -0,0 +1,200 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "geocode.hpp"
+#include "impl/parallel.hpp"
+
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace spt::geocode
+{
+  /**
+   * A cell of a Hilbert curve over the latitude and longitude grid, packed into 64 bits.  At level `n` the world is
+   * divided into a `2^n` by `2^n` grid of equal angle cells, numbered in the order the curve visits them, so cells
+   * that are close in number are close on the ground.
+   *
+   * The curve position is held in the high bits, two bits per level, followed by a single marker bit.  Sorting by
+   * value sorts cells by curve position, and all the descendants of a cell occupy the contiguous range
+   * `[rangeMin(), rangeMax()]`, with the cell itself in the middle of that range.
+   *
+   * Level 30 cells are roughly 2 by 4 centimetres at the equator.
+   */
+  class HilbertId
+  {
+  public:
+    /// The finest level.
+    static constexpr std::size_t maxLevel{ 30 };
+
+    constexpr HilbertId() = default;
+
+    /// Wrap a packed value, as returned by *value*.
+    constexpr explicit HilbertId( std::uint64_t value ) : id{ value } {}
+
+    /**
+     * The cell at the specified position along the curve.
+     * @param position The position, below `4^level`.
+     * @param level The level of the cell, up to *maxLevel*.
+     * @return The cell.
+     */
+    static constexpr HilbertId fromPosition( std::uint64_t position, std::size_t level )
+    {
+      return HilbertId{ ( ( position << 1 ) | 1 ) << ( 2 * ( maxLevel - level ) ) };
+    }
+
+    /**
+     * The cell that contains the specified geo-location.  Latitudes are clamped to `[-90, 90]` and longitudes are
+     * normalised, so every input maps to a cell.
+     * @param latitude The latitude in degrees.
+     * @param longitude The longitude in degrees.
+     * @param level The level of the cell, up to *maxLevel*.
+     * @return The cell that contains the location.
+     */
+    static HilbertId fromPoint( double latitude, double longitude, std::size_t level = maxLevel );
+
+    /**
+     * The cell that contains the specified geo-coordinate point.
+     * @tparam P A geo-coordinate structure that conforms to the *LatLng* concept.
+     * @param point The point.
+     * @param level The level of the cell, up to *maxLevel*.
+     * @return The cell that contains the point.
+     */
+    template <LatLng P>
+    static HilbertId fromPoint( const P& point, std::size_t level = maxLevel ) { return fromPoint( point.latitude, point.longitude, level ); }
+
+    /// The packed value.
+    [[nodiscard]] constexpr std::uint64_t value() const { return id; }
+
+    /// Whether the cell was created from a position or point, rather than default constructed.
+    [[nodiscard]] constexpr bool valid() const { return id != 0; }
+
+    /// The level of the cell, or `0` for the default constructed (invalid) cell.
+    [[nodiscard]] constexpr std::size_t level() const
+    {
+      return valid() ? maxLevel - static_cast<std::size_t>( std::countr_zero( id ) ) / 2 : 0;
+    }
+
+    /// The position of the cell along the curve at its level.
+    [[nodiscard]] constexpr std::uint64_t position() const { return id >> ( 2 * ( maxLevel - level() ) + 1 ); }
+
+    /// The smallest packed value of the cell and its descendants.
+    [[nodiscard]] constexpr std::uint64_t rangeMin() const { return id - ( lsb() - 1 ); }
+
+    /// The largest packed value of the cell and its descendants.
+    [[nodiscard]] constexpr std::uint64_t rangeMax() const { return id + ( lsb() - 1 ); }
+
+    /**
+     * The ancestor of the cell at the specified level.
+     * @param level The level of the ancestor.
+     * @return The ancestor, or the cell itself if it is not at a finer level than requested.
+     */
+    [[nodiscard]] constexpr HilbertId parent( std::size_t level ) const
+    {
+      if ( level >= this->level() ) return *this;
+      const auto bit = std::uint64_t{ 1 } << ( 2 * ( maxLevel - level ) );
+      return HilbertId{ ( id & ~( 2 * bit - 1 ) ) | bit };
+    }
+
+    /**
+     * The four cells one level down, in curve order.
+     * @return The children, or invalid cells if the cell is at *maxLevel*.
+     */
+    [[nodiscard]] constexpr std::array<HilbertId, 4> children() const
+    {
+      auto result = std::array<HilbertId, 4>{};
+      if ( !valid() || level() == maxLevel ) return result;
+      const auto bit = lsb() >> 2;
+      for ( std::uint64_t k = 0; k < 4; ++k ) result[k] = HilbertId{ rangeMin() - 1 + bit * ( 2 * k + 1 ) };
+      return result;
+    }
+
+    /// Whether the other cell is this cell or one of its descendants.
+    [[nodiscard]] constexpr bool contains( HilbertId other ) const
+    {
+      return valid() && other.id >= rangeMin() && other.id <= rangeMax();
+    }
+
+    /**
+     * Assign the cell to one of a number of shards, each of which holds a contiguous range of the curve covering
+     * an equal area of the latitude and longitude grid.
+     * @param count The number of shards, up to `2^32`.
+     * @return The shard, in `[0, count)`.
+     */
+    [[nodiscard]] constexpr std::size_t shard( std::size_t count ) const
+    {
+      return static_cast<std::size_t>( ( ( rangeMin() >> 29 ) * count ) >> 32 );
+    }
+
+    /// The area covered by the cell.
+    [[nodiscard]] BoundingBox bounds() const;
+
+    /// The centre of the area covered by the cell.
+    [[nodiscard]] Point centre() const;
+
+    constexpr auto operator<=>( const HilbertId& ) const = default;
+
+  private:
+    [[nodiscard]] constexpr std::uint64_t lsb() const { return id & ( ~id + 1 ); }
+
+    std::uint64_t id{ 0 };
+  };
+
+  /**
+   * The order in which to visit points so that points close on the ground are visited close together, which is the
+   * order of their level 30 *HilbertId* cells.  Cells are computed and sorted with a radix sort using multiple
+   * threads.  Points in the same cell keep their relative order.
+   * @tparam P A geo-coordinate structure that conforms to the *LatLng* concept.
+   * @param points The points to order.
+   * @return The indices of the points in locality order.
+   */
+  template <LatLng P>
+  std::vector<std::size_t> localityOrder( std::span<const P> points )
+  {
+    auto keys = std::vector<std::pair<std::uint64_t, std::size_t>>( points.size() );
+    impl::parallelFor( points.size(), 1 << 14, [&]( std::size_t begin, std::size_t end )
+    {
+      for ( auto i = begin; i < end; ++i ) keys[i] = { HilbertId::fromPoint( points[i] ).value(), i };
+    } );
+
+    // Level 30 cells use the 61 low order bits.
+    impl::radixSort( keys, []( const std::pair<std::uint64_t, std::size_t>& key ) { return key.first; }, 2 * HilbertId::maxLevel + 1 );
+
+    auto order = std::vector<std::size_t>( keys.size() );
+    for ( std::size_t i = 0; i < keys.size(); ++i ) order[i] = keys[i].second;
+    return order;
+  }
+
+  /**
+   * Sort points in place into locality order, so that loops over the points, such as containment checks,
+   * distance computations and clustering, touch nearby points together.  See *localityOrder*.
+   * @tparam P A geo-coordinate structure that conforms to the *LatLng* concept.
+   * @param points The points to sort.
+   */
+  template <LatLng P>
+  void sortByLocality( std::span<P> points )
+  {
+    const auto order = localityOrder( std::span<const P>{ points } );
+    auto sorted = std::vector<P>{};
+    sorted.reserve( points.size() );
+    for ( const auto i : order ) sorted.push_back( std::move( points[i] ) );
+    std::ranges::move( sorted, points.begin() );
+  }
+}
+
+template <>
+struct std::hash<spt::geocode::HilbertId>
+{
+  std::size_t operator()( const spt::geocode::HilbertId& cell ) const noexcept
+  {
+    return std::hash<std::uint64_t>{}( cell.value() );
+  }
+};
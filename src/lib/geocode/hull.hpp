@@ -0,0 +1,169 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "geocode.hpp"
+#include "impl/parallel.hpp"
+
+#include <array>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace spt::geocode
+{
+  namespace impl
+  {
+    /**
+     * Compute the convex hull of the candidate points using the monotone chain in *geofence*, after sorting them
+     * in parallel.
+     * @param points The candidate points as `{ latitude, longitude }` pairs.  Consumed by the call.
+     * @return The vertices of the hull.
+     */
+    Polygon convexHull( std::vector<std::array<double, 2>>&& points );
+
+    /**
+     * The extreme points of a set in the eight compass directions, which form the Akl–Toussaint octagon.
+     * Direction `k` is at `45 * k` degrees in the latitude/longitude plane, so the points are in counter-clockwise
+     * order.
+     */
+    struct Octagon
+    {
+      std::array<std::array<double, 2>, 8> points;
+      std::array<double, 8> extents;
+
+      static constexpr std::array<std::array<double, 2>, 8> directions{ {
+        { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 }, { -1, 0 }, { -1, -1 }, { 0, -1 }, { 1, -1 } } };
+
+      Octagon()
+      {
+        points.fill( { 0.0, 0.0 } );
+        extents.fill( std::numeric_limits<double>::lowest() );
+      }
+
+      void extend( double x, double y )
+      {
+        for ( std::size_t k = 0; k < directions.size(); ++k )
+        {
+          const auto extent = directions[k][0] * x + directions[k][1] * y;
+          if ( extent > extents[k] )
+          {
+            extents[k] = extent;
+            points[k] = { x, y };
+          }
+        }
+      }
+
+      void merge( const Octagon& other )
+      {
+        for ( std::size_t k = 0; k < directions.size(); ++k )
+        {
+          if ( other.extents[k] > extents[k] )
+          {
+            extents[k] = other.extents[k];
+            points[k] = other.points[k];
+          }
+        }
+      }
+    };
+
+    /**
+     * The distinct vertices of an octagon in counter-clockwise order.
+     * @param octagon The octagon.
+     * @return The vertices with consecutive duplicates removed.
+     */
+    inline std::vector<std::array<double, 2>> vertices( const Octagon& octagon )
+    {
+      auto result = std::vector<std::array<double, 2>>{};
+      result.reserve( octagon.points.size() );
+      for ( const auto& point : octagon.points )
+      {
+        if ( result.empty() || result.back() != point ) result.push_back( point );
+      }
+      while ( result.size() > 1 && result.back() == result.front() ) result.pop_back();
+      return result;
+    }
+  }
+
+  /**
+   * Compute the convex hull of a set of geo-coordinates.  The hull is computed in the latitude/longitude plane,
+   * matching the containment test used by *within*, so the points should not straddle the antimeridian.
+   *
+   * Points strictly inside the octagon formed by the extreme points in eight directions cannot be on the hull,
+   * and are discarded in parallel before the remaining points are sorted in parallel and passed to Andrew's
+   * monotone chain algorithm.  For typical inputs this discards the vast majority of the points.
+   *
+   * @tparam P A geo-coordinate structure that conforms to the *LatLng* concept.
+   * @param points The points to compute the hull for.
+   * @return The vertices of the hull, which may be used directly with *within*.  Collinear points on the hull are
+   *   not included.
+   */
+  template <LatLng P>
+  Polygon convexHull( std::span<const P> points )
+  {
+    static constexpr std::size_t block = 1 << 16;
+    const auto blocks = ( points.size() + block - 1 ) / block;
+    const auto range = [&points]( std::size_t b )
+    {
+      return points.subspan( b * block, std::min( block, points.size() - b * block ) );
+    };
+
+    auto octagons = std::vector<impl::Octagon>( blocks );
+    impl::parallelFor( blocks, 1, [&]( std::size_t begin, std::size_t end )
+    {
+      for ( auto b = begin; b < end; ++b )
+      {
+        for ( const auto& p : range( b ) ) octagons[b].extend( p.latitude, p.longitude );
+      }
+    } );
+
+    auto octagon = impl::Octagon{};
+    for ( const auto& o : octagons ) octagon.merge( o );
+    const auto polygon = impl::vertices( octagon );
+
+    const auto interior = [&polygon]( double x, double y )
+    {
+      if ( polygon.size() < 3 ) return false;
+      for ( std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++ )
+      {
+        const auto& a = polygon[j];
+        const auto& b = polygon[i];
+        if ( ( b[0] - a[0] ) * ( y - a[1] ) - ( b[1] - a[1] ) * ( x - a[0] ) <= 0.0 ) return false;
+      }
+      return true;
+    };
+
+    auto survivors = std::vector<std::vector<std::array<double, 2>>>( blocks );
+    impl::parallelFor( blocks, 1, [&]( std::size_t begin, std::size_t end )
+    {
+      for ( auto b = begin; b < end; ++b )
+      {
+        for ( const auto& p : range( b ) )
+        {
+          const auto x = static_cast<double>( p.latitude );
+          const auto y = static_cast<double>( p.longitude );
+          if ( !interior( x, y ) ) survivors[b].push_back( { x, y } );
+        }
+      }
+    } );
+
+    auto candidates = std::vector<std::array<double, 2>>{};
+    std::size_t count{ 0 };
+    for ( const auto& s : survivors ) count += s.size();
+    candidates.reserve( count );
+    for ( const auto& s : survivors ) candidates.insert( candidates.end(), s.begin(), s.end() );
+
+    return impl::convexHull( std::move( candidates ) );
+  }
+
+  /**
+   * Compute the convex hull of a set of geo-coordinates.
+   * @tparam P A geo-coordinate structure that conforms to the *LatLng* concept.
+   * @param points The points to compute the hull for.
+   * @return The vertices of the hull.
+   */
+  template <LatLng P>
+  Polygon convexHull( const std::vector<P>& points ) { return convexHull( std::span<const P>{ points } ); }
+}
@@ -0,0 +1,148 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include "cache.hpp"
+#include "positionstack.hpp"
+#include "../cell.hpp"
+#include "../hilbert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+using spt::geocode::Address;
+using spt::geocode::impl::ForwardCache;
+using spt::geocode::impl::ReverseCache;
+
+using std::operator ""sv;
+
+namespace
+{
+  namespace pcache
+  {
+    // The overhead of a list node and an index node with its bucket, on top of the entry itself.
+    constexpr std::size_t nodeBytes{ 64 };
+
+    std::size_t bytes( const std::string& value )
+    {
+      // Short strings are held inline.
+      return value.capacity() > 15 ? value.capacity() + 1 : 0;
+    }
+
+    // Words and their abbreviations, sorted by word.
+    constexpr auto abbreviations = std::to_array<std::pair<std::string_view, std::string_view>>( {
+        { "alley", "aly" }, { "apartment", "apt" }, { "av", "ave" }, { "avenue", "ave" },
+        { "avn", "ave" }, { "boulevard", "blvd" }, { "building", "bldg" }, { "center", "ctr" },
+        { "centre", "ctr" }, { "circle", "cir" }, { "court", "ct" }, { "crescent", "cres" },
+        { "drive", "dr" }, { "east", "e" }, { "eighth", "8" }, { "expressway", "expy" },
+        { "fifth", "5" }, { "first", "1" }, { "floor", "fl" }, { "fort", "ft" }, { "fourth", "4" },
+        { "freeway", "fwy" }, { "highway", "hwy" }, { "lane", "ln" }, { "mount", "mt" },
+        { "ninth", "9" }, { "north", "n" }, { "northeast", "ne" }, { "northwest", "nw" },
+        { "parkway", "pkwy" }, { "place", "pl" }, { "plaza", "plz" }, { "road", "rd" },
+        { "route", "rte" }, { "second", "2" }, { "seventh", "7" }, { "sixth", "6" }, { "south", "s" },
+        { "southeast", "se" }, { "southwest", "sw" }, { "square", "sq" }, { "str", "st" },
+        { "street", "st" }, { "suite", "ste" }, { "tenth", "10" }, { "terrace", "ter" },
+        { "third", "3" }, { "usa", "us" }, { "west", "w" }
+    } );
+    static_assert( std::ranges::is_sorted( abbreviations, {}, &std::pair<std::string_view, std::string_view>::first ) );
+
+    std::string_view canonical( std::string_view word )
+    {
+      // Ordinal numbers, such as 5th, are written as their digits.
+      if ( word.size() > 2 && word[word.size() - 3] >= '0' && word[word.size() - 3] <= '9' )
+      {
+        const auto suffix = word.substr( word.size() - 2 );
+        if ( suffix == "st"sv || suffix == "nd"sv || suffix == "rd"sv || suffix == "th"sv ) return word.substr( 0, word.size() - 2 );
+      }
+
+      const auto it = std::ranges::lower_bound( abbreviations, word, {}, &std::pair<std::string_view, std::string_view>::first );
+      return it != abbreviations.end() && it->first == word ? it->second : word;
+    }
+
+    std::size_t bytes( const Address& address )
+    {
+      auto size = sizeof( Address ) + address.street.capacity() * sizeof( std::string );
+      for ( const auto& street : address.street ) size += bytes( street );
+      return size + bytes( address.city ) + bytes( address.state ) + bytes( address.county ) +
+        bytes( address.postalCode ) + bytes( address.country ) + bytes( address.text );
+    }
+  }
+}
+
+ReverseCache::ReverseCache( const ReverseCacheOptions& options ) :
+  opts{ options }, cache{ options.maxBytes, options.shards } {}
+
+std::uint64_t ReverseCache::key( const double latitude, const double longitude ) const
+{
+  if ( opts.cell == ReverseCacheOptions::Cell::Hilbert )
+  {
+    return HilbertId::fromPoint( latitude, longitude, std::clamp<std::size_t>( opts.level, 1, HilbertId::maxLevel ) ).value();
+  }
+  return CellId::fromPoint( latitude, longitude, opts.codeLength ).value();
+}
+
+std::optional<Address> ReverseCache::get( const double latitude, const double longitude )
+{
+  auto address = cache.get( key( latitude, longitude ) );
+  if ( address && address->location )
+  {
+    address->location->latitude = latitude;
+    address->location->longitude = longitude;
+  }
+  return address;
+}
+
+void ReverseCache::put( const double latitude, const double longitude, const Address& address )
+{
+  cache.put( key( latitude, longitude ), address, sizeof( std::uint64_t ) + pcache::bytes( address ) + pcache::nodeBytes, opts.ttl );
+}
+
+std::string spt::geocode::normaliseAddress( std::string_view address )
+{
+  auto result = std::string{};
+  result.reserve( address.size() );
+  auto word = std::string{};
+
+  const auto append = [&result, &word]
+  {
+    if ( word.empty() ) return;
+    if ( !result.empty() ) result.push_back( ' ' );
+    result.append( pcache::canonical( word ) );
+    word.clear();
+  };
+
+  for ( const auto c : address )
+  {
+    if ( c >= 'A' && c <= 'Z' ) word.push_back( static_cast<char>( c - 'A' + 'a' ) );
+    else if ( ( c >= 'a' && c <= 'z' ) || ( c >= '0' && c <= '9' ) || static_cast<unsigned char>( c ) >= 0x80 ) word.push_back( c );
+    else if ( c != '\'' ) append();
+  }
+  append();
+
+  return result;
+}
+
+ForwardCache::ForwardCache( const ForwardCacheOptions& options ) :
+  opts{ options }, cache{ options.maxBytes, options.shards, options.maxEntries } {}
+
+std::optional<ForwardCache::Result> ForwardCache::get( const std::string& key )
+{
+  if ( key.empty() ) return std::nullopt;
+  return cache.get( key );
+}
+
+void ForwardCache::put( const std::string& key, const Result& result )
+{
+  if ( key.empty() ) return;
+  if ( result )
+  {
+    // The key is held by both the entry and the index.
+    cache.put( key, result, sizeof( Result ) + 2 * ( sizeof( std::string ) + pcache::bytes( key ) ) + pcache::nodeBytes, opts.ttl );
+  }
+  else if ( result.error() == noResults )
+  {
+    cache.put( key, result, sizeof( Result ) + pcache::bytes( result.error() ) + 2 * ( sizeof( std::string ) + pcache::bytes( key ) ) +
+      pcache::nodeBytes, opts.negativeTtl );
+  }
+}
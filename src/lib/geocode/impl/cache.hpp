@@ -0,0 +1,73 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "lrucache.hpp"
+
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string>
+
+namespace spt::geocode::impl
+{
+  /**
+   * Addresses returned by reverse lookups, keyed by the packed value of the *CellId* or *HilbertId* cell that
+   * contains the location looked up.
+   */
+  class ReverseCache
+  {
+  public:
+    explicit ReverseCache( const ReverseCacheOptions& options );
+
+    /// The cache key for a location, which is the same for all the locations in a cell.
+    [[nodiscard]] std::uint64_t key( double latitude, double longitude ) const;
+
+    /**
+     * Look up the address for a location.
+     * @param latitude The latitude of the location.
+     * @param longitude The longitude of the location.
+     * @return The address cached for the cell that contains the location, with its location set to the one
+     *   specified, or `std::nullopt` if there is none.
+     */
+    [[nodiscard]] std::optional<Address> get( double latitude, double longitude );
+
+    /// Cache the address for the cell that contains the location.
+    void put( double latitude, double longitude, const Address& address );
+
+    [[nodiscard]] CacheStats stats() const { return cache.stats(); }
+
+  private:
+    ReverseCacheOptions opts;
+    LruCache<std::uint64_t, Address> cache;
+  };
+
+  /**
+   * Coordinates returned by forward lookups, keyed by the normalised address.  Addresses for which the API returned
+   * no results are cached with the shorter negative TTL.  Other errors are not cached.
+   */
+  class ForwardCache
+  {
+  public:
+    using Result = std::expected<Point, std::string>;
+
+    explicit ForwardCache( const ForwardCacheOptions& options );
+
+    /// The cache key for an address, which is empty if the address cannot be cached.
+    [[nodiscard]] static std::string key( std::string_view address ) { return normaliseAddress( address ); }
+
+    /// Look up the result cached for a key.
+    [[nodiscard]] std::optional<Result> get( const std::string& key );
+
+    /// Cache the result of a lookup, if it is coordinates or the absence of results.
+    void put( const std::string& key, const Result& result );
+
+    [[nodiscard]] CacheStats stats() const { return cache.stats(); }
+
+  private:
+    ForwardCacheOptions opts;
+    LruCache<std::string, Result> cache;
+  };
+}
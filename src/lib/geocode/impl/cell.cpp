@@ -0,0 +1,342 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include "../cell.hpp"
+
+#include <cmath>
+#include <deque>
+
+namespace
+{
+  namespace pcell
+  {
+    using spt::geocode::impl::olc::alphabet;
+    using spt::geocode::impl::olc::positions;
+
+    // Pack the digits of a code, which must be valid, ignoring the separator and stopping at any padding.
+    spt::geocode::CellId pack( std::string_view code, std::size_t length )
+    {
+      std::uint64_t id{ 0 };
+      std::size_t digits{ 0 };
+      for ( const auto c : code )
+      {
+        if ( c == '+' ) continue;
+        if ( c == '0' || digits == length ) break;
+        id |= static_cast<std::uint64_t>( positions[static_cast<unsigned char>( c )] ) << ( 59 - 5 * digits );
+        ++digits;
+      }
+      return spt::geocode::CellId{ id | digits };
+    }
+
+    // The row and column of a cell within the grid of all cells of its length.
+    struct Grid
+    {
+      std::int64_t row{ 0 };
+      std::int64_t column{ 0 };
+      std::size_t length{ 0 };
+
+      std::size_t pairs() const { return std::min<std::size_t>( length, 10 ) / 2; }
+      std::size_t refinements() const { return length > 10 ? length - 10 : 0; }
+
+      std::int64_t rows() const
+      {
+        if ( length == 0 ) return 1;
+        auto count = std::int64_t{ 9 };
+        for ( std::size_t i = 1; i < pairs(); ++i ) count *= 20;
+        for ( std::size_t i = 0; i < refinements(); ++i ) count *= 5;
+        return count;
+      }
+
+      std::int64_t columns() const
+      {
+        if ( length == 0 ) return 1;
+        auto count = std::int64_t{ 18 };
+        for ( std::size_t i = 1; i < pairs(); ++i ) count *= 20;
+        for ( std::size_t i = 0; i < refinements(); ++i ) count *= 4;
+        return count;
+      }
+
+      spt::geocode::BoundingBox bounds() const
+      {
+        const auto height = 180.0 / static_cast<double>( rows() );
+        const auto width = 360.0 / static_cast<double>( columns() );
+        auto box = spt::geocode::BoundingBox{};
+        box.minLatitude = -90.0 + static_cast<double>( row ) * height;
+        box.minLongitude = -180.0 + static_cast<double>( column ) * width;
+        box.maxLatitude = box.minLatitude + height;
+        box.maxLongitude = box.minLongitude + width;
+        return box;
+      }
+    };
+
+    std::uint64_t digit( spt::geocode::CellId cell, std::size_t i )
+    {
+      return ( cell.value() >> ( 59 - 5 * i ) ) & 0x1F;
+    }
+
+    Grid toGrid( spt::geocode::CellId cell )
+    {
+      auto grid = Grid{ .length = cell.length() };
+      for ( std::size_t i = 0; i < std::min<std::size_t>( grid.length, 10 ); ++i )
+      {
+        if ( i % 2 == 0 ) grid.row = grid.row * 20 + static_cast<std::int64_t>( digit( cell, i ) );
+        else grid.column = grid.column * 20 + static_cast<std::int64_t>( digit( cell, i ) );
+      }
+      for ( std::size_t i = 10; i < grid.length; ++i )
+      {
+        const auto d = static_cast<std::int64_t>( digit( cell, i ) );
+        grid.row = grid.row * 5 + d / 4;
+        grid.column = grid.column * 4 + d % 4;
+      }
+      return grid;
+    }
+
+    spt::geocode::CellId fromGrid( const Grid& grid )
+    {
+      auto row = grid.row;
+      auto column = grid.column;
+      auto digits = std::array<std::uint64_t, spt::geocode::CellId::maxLength>{};
+      for ( auto i = grid.length; i > 10; --i )
+      {
+        digits[i - 1] = static_cast<std::uint64_t>( ( row % 5 ) * 4 + column % 4 );
+        row /= 5;
+        column /= 4;
+      }
+      for ( auto i = grid.pairs(); i > 0; --i )
+      {
+        digits[2 * i - 2] = static_cast<std::uint64_t>( row % 20 );
+        digits[2 * i - 1] = static_cast<std::uint64_t>( column % 20 );
+        row /= 20;
+        column /= 20;
+      }
+
+      std::uint64_t id{ 0 };
+      for ( std::size_t i = 0; i < grid.length; ++i ) id |= digits[i] << ( 59 - 5 * i );
+      return spt::geocode::CellId{ id | grid.length };
+    }
+
+    using Relation = spt::geocode::PreparedPolygon::Relation;
+
+    struct Candidate
+    {
+      Grid grid;
+      bool inside{ false };
+    };
+
+    // Replace complete sets of sibling cells with their parent, as long as the parent is not shorter than the
+    // minimum length.  The cells must be sorted, so that siblings are adjacent.
+    std::vector<spt::geocode::CellId> merge( std::span<const spt::geocode::CellId> cells, std::size_t minLength )
+    {
+      auto result = std::vector<spt::geocode::CellId>{};
+      result.reserve( cells.size() );
+      for ( const auto cell : cells )
+      {
+        result.push_back( cell );
+        while ( true )
+        {
+          const auto length = result.back().length();
+          const auto parentLength = length > 10 ? length - 1 : length - 2;
+          if ( length <= 2 || parentLength < minLength ) break;
+
+          const auto count = std::size_t{ length > 10 ? 20u : 400u };
+          if ( result.size() < count ) break;
+
+          const auto parent = result.back().parent( parentLength );
+          const auto first = result.end() - static_cast<std::ptrdiff_t>( count );
+          if ( !std::all_of( first, result.end(), [&]( spt::geocode::CellId c ) { return c.length() == length && parent.contains( c ); } ) ) break;
+
+          result.erase( first, result.end() );
+          result.push_back( parent );
+        }
+      }
+      return result;
+    }
+
+    template <typename F>
+    std::vector<spt::geocode::CellId> cover( const spt::geocode::BoundingBox& extent, F&& relate,
+      std::size_t maxCells, std::size_t minLength, std::size_t maxLength )
+    {
+      using spt::geocode::CellId;
+
+      minLength = CellId::validLength( minLength );
+      maxLength = std::max( CellId::validLength( maxLength ), minLength );
+
+      auto result = std::vector<CellId>{};
+      if ( extent.empty() ) return result;
+
+      auto queue = std::deque<Candidate>{};
+      auto children = std::vector<Candidate>{};
+
+      // Classify the children of a cell, restricted to the rows and columns that overlap the extent of the region.
+      const auto expand = [&]( const Candidate& parent )
+      {
+        children.clear();
+        auto child = Grid{ .length = parent.grid.length < 10 ? parent.grid.length + 2 : parent.grid.length + 1 };
+        const auto rowFactor = child.rows() / parent.grid.rows();
+        const auto columnFactor = child.columns() / parent.grid.columns();
+
+        auto firstRow = parent.grid.row * rowFactor;
+        auto lastRow = firstRow + rowFactor - 1;
+        auto firstColumn = parent.grid.column * columnFactor;
+        auto lastColumn = firstColumn + columnFactor - 1;
+        if ( !parent.inside )
+        {
+          const auto height = 180.0 / static_cast<double>( child.rows() );
+          firstRow = std::max( firstRow, static_cast<std::int64_t>( std::floor( ( extent.minLatitude + 90.0 ) / height ) ) );
+          lastRow = std::min( lastRow, static_cast<std::int64_t>( std::floor( ( extent.maxLatitude + 90.0 ) / height ) ) );
+          if ( extent.maxLongitude <= 180.0 )
+          {
+            const auto width = 360.0 / static_cast<double>( child.columns() );
+            firstColumn = std::max( firstColumn, static_cast<std::int64_t>( std::floor( ( extent.minLongitude + 180.0 ) / width ) ) );
+            lastColumn = std::min( lastColumn, static_cast<std::int64_t>( std::floor( ( extent.maxLongitude + 180.0 ) / width ) ) );
+          }
+        }
+
+        for ( child.row = firstRow; child.row <= lastRow; ++child.row )
+        {
+          for ( child.column = firstColumn; child.column <= lastColumn; ++child.column )
+          {
+            if ( parent.inside )
+            {
+              children.push_back( Candidate{ .grid = child, .inside = true } );
+              continue;
+            }
+
+            const auto relation = relate( child.bounds() );
+            if ( relation == Relation::Disjoint ) continue;
+            children.push_back( Candidate{ .grid = child, .inside = relation == Relation::Inside } );
+          }
+        }
+      };
+
+      expand( Candidate{} );
+      queue.assign( children.begin(), children.end() );
+
+      // Candidates are refined coarsest first, as each level is queued after the one above it.
+      while ( !queue.empty() )
+      {
+        const auto candidate = queue.front();
+        queue.pop_front();
+
+        const auto length = candidate.grid.length;
+        if ( length >= minLength && ( candidate.inside || length >= maxLength ) )
+        {
+          result.push_back( fromGrid( candidate.grid ) );
+          continue;
+        }
+
+        expand( candidate );
+        if ( length >= minLength && result.size() + queue.size() + children.size() > maxCells )
+        {
+          result.push_back( fromGrid( candidate.grid ) );
+          continue;
+        }
+        queue.insert( queue.end(), children.begin(), children.end() );
+      }
+
+      std::ranges::sort( result );
+      return merge( result, minLength );
+    }
+
+    // Relation of a cell to a box, ignoring cells that only touch its edges.
+    Relation relate( const spt::geocode::BoundingBox& region, const spt::geocode::BoundingBox& cell )
+    {
+      if ( cell.minLatitude >= region.maxLatitude || cell.maxLatitude <= region.minLatitude ||
+          cell.minLongitude >= region.maxLongitude || cell.maxLongitude <= region.minLongitude ) return Relation::Disjoint;
+      if ( cell.minLatitude >= region.minLatitude && cell.maxLatitude <= region.maxLatitude &&
+          cell.minLongitude >= region.minLongitude && cell.maxLongitude <= region.maxLongitude ) return Relation::Inside;
+      return Relation::Partial;
+    }
+  }
+}
+
+using spt::geocode::CellId;
+
+std::expected<CellId, std::string> CellId::fromCode( std::string_view code )
+{
+  using O = std::expected<CellId, std::string>;
+
+  auto area = decodeLocationCode( code );
+  if ( !area ) return O{ std::unexpect, std::move( area.error() ) };
+  return pcell::pack( code, maxLength );
+}
+
+CellId CellId::fromPoint( double latitude, double longitude, std::size_t length )
+{
+  length = validLength( length );
+  const auto code = FixedCode{ latitude, longitude, length };
+  return pcell::pack( code.view(), length );
+}
+
+spt::geocode::FixedCode CellId::code() const
+{
+  auto chars = std::array<char, FixedCode::capacity>{};
+  std::size_t size{ 0 };
+  for ( std::size_t i = 0; i < length(); ++i )
+  {
+    if ( i == 8 ) chars[size++] = '+';
+    chars[size++] = pcell::alphabet[pcell::digit( *this, i )];
+  }
+  while ( size < 8 ) chars[size++] = '0';
+  if ( size == 8 ) chars[size++] = '+';
+  return FixedCode{ std::string_view{ chars.data(), size } };
+}
+
+spt::geocode::BoundingBox CellId::bounds() const
+{
+  if ( !valid() ) return {};
+
+  return pcell::toGrid( *this ).bounds();
+}
+
+std::array<CellId, 8> CellId::neighbours() const
+{
+  auto result = std::array<CellId, 8>{};
+  if ( !valid() ) return result;
+
+  const auto grid = pcell::toGrid( *this );
+  const auto rows = grid.rows();
+  const auto columns = grid.columns();
+  std::size_t n{ 0 };
+  for ( std::int64_t dr = -1; dr <= 1; ++dr )
+  {
+    for ( std::int64_t dc = -1; dc <= 1; ++dc )
+    {
+      if ( dr == 0 && dc == 0 ) continue;
+      const auto row = grid.row + dr;
+      if ( row >= 0 && row < rows )
+      {
+        const auto column = ( grid.column + dc + columns ) % columns;
+        result[n] = pcell::fromGrid( pcell::Grid{ .row = row, .column = column, .length = grid.length } );
+      }
+      ++n;
+    }
+  }
+  return result;
+}
+
+std::vector<CellId> spt::geocode::cover( const PreparedPolygon& polygon, std::size_t maxCells,
+  std::size_t minLength, std::size_t maxLength )
+{
+  return pcell::cover( polygon.bounds(), [&polygon]( const BoundingBox& cell ) { return polygon.relate( cell ); },
+    maxCells, minLength, maxLength );
+}
+
+std::vector<CellId> spt::geocode::cover( const BoundingBox& bounds, std::size_t maxCells,
+  std::size_t minLength, std::size_t maxLength )
+{
+  return pcell::cover( bounds, [&bounds]( const BoundingBox& cell )
+  {
+    const auto relation = pcell::relate( bounds, cell );
+    if ( relation == pcell::Relation::Partial || bounds.maxLongitude <= 180.0 ) return relation;
+
+    // Boxes that cross the antimeridian also cover the cells just east of it.
+    auto shifted = cell;
+    shifted.minLongitude += 360.0;
+    shifted.maxLongitude += 360.0;
+    const auto other = pcell::relate( bounds, shifted );
+    if ( other == pcell::Relation::Partial ) return other;
+    return relation == pcell::Relation::Inside || other == pcell::Relation::Inside ? pcell::Relation::Inside : pcell::Relation::Disjoint;
+  }, maxCells, minLength, maxLength );
+}
@@ -0,0 +1,675 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include "positionstack.hpp"
+#include "cache.hpp"
+#include "workqueue.hpp"
+
+#if defined __has_include
+  #if __has_include("../../../log/NanoLog.hpp")
+    #include "../../../log/NanoLog.hpp"
+  #elif __has_include("../../src/log/NanoLog.hpp")
+    #include "../../src/log/NanoLog.hpp"
+  #else
+    #include <log/NanoLog.hpp>
+  #endif
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <limits>
+#include <unordered_map>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+
+using spt::geocode::Address;
+using spt::geocode::Point;
+using spt::geocode::impl::SessionPool;
+
+using std::operator ""sv;
+
+namespace
+{
+  namespace pclient
+  {
+    cpr::Response get( SessionPool& pool, std::string_view endpoint, cpr::Parameters parameters )
+    {
+      auto session = pool.acquire();
+      session->SetUrl( cpr::Url{ pool.url( endpoint ) } );
+      session->SetParameters( std::move( parameters ) );
+      return session->Get();
+    }
+
+    cpr::Response post( SessionPool& pool, std::string_view endpoint, const std::string& key, std::string body )
+    {
+      auto session = pool.acquire( SessionPool::Method::Post );
+      session->SetUrl( cpr::Url{ pool.url( endpoint ) } );
+      session->SetParameters( cpr::Parameters{ { "access_key", key } } );
+      session->SetHeader( cpr::Header{ { "Content-Type", "application/json" } } );
+      session->SetBody( cpr::Body{ std::move( body ) } );
+      return session->Post();
+    }
+
+    // The response body for error statuses, or the transport error if no response was received.
+    std::string error( const cpr::Response& resp )
+    {
+      if ( resp.status_code == 0 && resp.error ) return resp.error.message;
+      return resp.text;
+    }
+
+    Address address( boost::json::object& ad, const double latitude, const double longitude )
+    {
+      auto address = Address{};
+      address.street.reserve( 1 );
+      if ( ad.contains( "name"sv ) && ad["name"sv].is_string() ) address.street.emplace_back( ad["name"sv].get_string() );
+      if ( ad.contains( "locality"sv ) && ad["locality"sv].is_string() ) address.city = ad["locality"sv].get_string();
+      if ( ad.contains( "region"sv ) && ad["region"sv].is_string() ) address.state = ad["region"sv].get_string();
+      else if ( ad.contains( "region_code"sv ) && ad["region_code"sv].is_string() ) address.state = ad["region_code"sv].get_string();
+      if ( ad.contains( "county"sv ) && ad["county"sv].is_string() ) address.county = ad["county"sv].get_string();
+      if ( ad.contains( "postal_code"sv ) && ad["postal_code"sv].is_string() ) address.postalCode = ad["postal_code"sv].get_string();
+      if ( ad.contains( "country"sv ) && ad["country"sv].is_string() ) address.country = ad["country"sv].get_string();
+      else if ( ad.contains( "country_code"sv ) && ad["country_code"sv].is_string() ) address.country = ad["country_code"sv].get_string();
+      if ( ad.contains( "label"sv ) && ad["label"sv].is_string() ) address.text = ad["label"sv].get_string();
+      address.location = Point{};
+      address.location->latitude = latitude;
+      address.location->longitude = longitude;
+      if ( ad.contains( "distance"sv ) && ad["distance"sv].is_double() ) address.location->accuracy = ad["distance"sv].get_double();
+      return address;
+    }
+
+    std::expected<Point, std::string> point( boost::json::object& ad )
+    {
+      using O = std::expected<Point, std::string>;
+      if ( !ad.contains( "latitude"sv ) || !ad.contains( "longitude"sv ) ) return O{ std::unexpect, "Data does not contain coordinates" };
+
+      auto p = O{ std::in_place };
+      p.value().latitude = ad["latitude"sv].is_double() ? ad["latitude"sv].get_double() : 0.0;
+      p.value().longitude = ad["longitude"sv].is_double() ? ad["longitude"sv].get_double() : 0.0;
+      if ( ad.contains( "distance"sv ) && ad["distance"sv].is_double() ) p.value().accuracy = ad["distance"sv].get_double();
+      return p;
+    }
+
+    struct Query
+    {
+      std::size_t index;
+      std::string text;
+    };
+
+    /**
+     * Send the queries as a single batch request, and store the conversion of the first result for each query, or
+     * an error, in the results at the index of the query.  The response has an entry in *data* for each query in
+     * the same order, which is the array of results for the query.
+     */
+    template <typename T, typename Convert>
+    void batch( SessionPool& pool, std::string_view endpoint, const std::vector<Query>& queries,
+      std::span<std::expected<T, std::string>> results, const std::string& key, Convert&& convert )
+    {
+      using O = std::expected<T, std::string>;
+      if ( queries.empty() ) return;
+
+      const auto fail = [&queries, &results]( const std::string& message )
+      {
+        for ( const auto& query : queries ) results[query.index] = O{ std::unexpect, message };
+      };
+
+      auto entries = boost::json::array{};
+      entries.reserve( queries.size() );
+      for ( const auto& query : queries ) entries.emplace_back( boost::json::object{ { "query", query.text }, { "limit", 1 } } );
+      auto body = boost::json::object{};
+      body["batch"] = std::move( entries );
+
+      auto resp = post( pool, endpoint, key, boost::json::serialize( body ) );
+      if ( resp.status_code != 200 )
+      {
+        LOG_WARN << "Error retrieving batch of " << static_cast<uint64_t>( queries.size() ) << " queries from " << endpoint <<
+          ".  Response status " << resp.status_line << ". " << resp.text;
+        return fail( error( resp ) );
+      }
+
+      boost::system::error_code ec;
+      auto json = boost::json::parse( resp.text, ec );
+      if ( ec )
+      {
+        LOG_WARN << "Error parsing batch response from " << endpoint << ".  Error: " << ec.message();
+        return fail( ec.message() );
+      }
+
+      if ( !json.is_object() || !json.get_object().contains( "data"sv ) )
+      {
+        LOG_WARN << "No data in batch response from " << endpoint << ". " << resp.text;
+        return fail( "No data in response" );
+      }
+
+      auto& data = json.get_object()["data"sv];
+      if ( !data.is_array() )
+      {
+        LOG_WARN << "data not array in batch response from " << endpoint << ". " << resp.text;
+        return fail( "Invalid type for data in response" );
+      }
+
+      auto& arr = data.get_array();
+      for ( std::size_t i = 0; i < queries.size(); ++i )
+      {
+        auto& result = results[queries[i].index];
+        if ( i >= arr.size() )
+        {
+          result = O{ std::unexpect, "Missing result in batch response" };
+          continue;
+        }
+
+        // Each entry is the array of results for the query, of which only the first is used.
+        auto* entry = &arr[i];
+        if ( entry->is_array() )
+        {
+          if ( entry->get_array().empty() )
+          {
+            result = O{ std::unexpect, std::string{ spt::geocode::impl::noResults } };
+            continue;
+          }
+          entry = &entry->get_array().front();
+        }
+
+        if ( !entry->is_object() ) result = O{ std::unexpect, "Non-object in data array" };
+        else result = convert( entry->get_object(), queries[i].index );
+      }
+    }
+
+    /**
+     * Run `count` chunks of work concurrently on the workers of the queue.  The calling thread takes chunks as well,
+     * so all chunks complete even when every worker is busy, or when called from a worker.
+     */
+    void parallel( spt::geocode::impl::WorkQueue& queue, std::size_t count, const std::function<void( std::size_t )>& work )
+    {
+      struct State
+      {
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::atomic<std::size_t> next{ 0 };
+        std::size_t completed{ 0 };
+      };
+
+      auto state = std::make_shared<State>();
+      const auto run = [state, &work, count]
+      {
+        for ( auto chunk = state->next++; chunk < count; chunk = state->next++ )
+        {
+          work( chunk );
+          auto lock = std::lock_guard{ state->mutex };
+          if ( ++state->completed == count ) state->finished.notify_all();
+        }
+      };
+
+      // Helpers that start after all chunks have been taken exit without touching `work`.
+      for ( std::size_t i = 1; i < std::min( count, queue.workers() + 1 ); ++i ) queue.submit( run );
+      run();
+
+      auto lock = std::unique_lock{ state->mutex };
+      state->finished.wait( lock, [&state, count] { return state->completed == count; } );
+    }
+
+    // Look up addresses for the points in batches, sent concurrently on the workers of the queue.
+    std::vector<std::expected<Address, std::string>> addresses( SessionPool& pool, spt::geocode::impl::WorkQueue& queue,
+      std::span<const Point> points )
+    {
+      auto results = std::vector<std::expected<Address, std::string>>( points.size() );
+      const auto size = std::max<std::size_t>( pool.options().batchSize, 1 );
+      parallel( queue, ( points.size() + size - 1 ) / size, [&]( std::size_t chunk )
+      {
+        const auto offset = chunk * size;
+        const auto count = std::min( size, points.size() - offset );
+        spt::geocode::impl::reverse( pool, points.subspan( offset, count ), std::span{ results }.subspan( offset, count ),
+          pool.options().key );
+      } );
+      return results;
+    }
+
+    // Look up coordinates for the addresses in batches, sent concurrently on the workers of the queue.
+    std::vector<std::expected<Point, std::string>> fromAddresses( SessionPool& pool, spt::geocode::impl::WorkQueue& queue,
+      std::span<const std::string> addresses )
+    {
+      auto results = std::vector<std::expected<Point, std::string>>( addresses.size() );
+      const auto size = std::max<std::size_t>( pool.options().batchSize, 1 );
+      parallel( queue, ( addresses.size() + size - 1 ) / size, [&]( std::size_t chunk )
+      {
+        const auto offset = chunk * size;
+        const auto count = std::min( size, addresses.size() - offset );
+        spt::geocode::impl::forward( pool, addresses.subspan( offset, count ), std::span{ results }.subspan( offset, count ),
+          pool.options().key );
+      } );
+      return results;
+    }
+
+    // Look up the coordinates for an address in the cache, if there is one, before sending a request.
+    std::expected<Point, std::string> point( SessionPool& pool, spt::geocode::impl::ForwardCache* cache, const std::string& address )
+    {
+      if ( !cache ) return spt::geocode::impl::forward( pool, address, pool.options().key );
+
+      const auto key = cache->key( address );
+      if ( auto point = cache->get( key ) ) return std::move( *point );
+
+      auto point = spt::geocode::impl::forward( pool, address, pool.options().key );
+      cache->put( key, point );
+      return point;
+    }
+
+    // Look up the address for a location in the cache, if there is one, before sending a request.
+    std::expected<Address, std::string> address( SessionPool& pool, spt::geocode::impl::ReverseCache* cache,
+      const double latitude, const double longitude )
+    {
+      if ( cache )
+      {
+        if ( auto address = cache->get( latitude, longitude ) ) return std::move( *address );
+      }
+
+      auto address = spt::geocode::impl::reverse( pool, latitude, longitude, pool.options().key );
+      if ( cache && address ) cache->put( latitude, longitude, *address );
+      return address;
+    }
+  }
+}
+
+SessionPool::SessionPool( const ClientOptions& options ) : opts{ options }
+{
+  opts.poolSize = std::max<std::size_t>( opts.poolSize, 1 );
+  idle.reserve( std::min<std::size_t>( opts.poolSize, 64 ) );
+}
+
+SessionPool& SessionPool::shared()
+{
+  static auto pool = SessionPool{ []
+  {
+    auto options = ClientOptions{};
+    options.poolSize = std::numeric_limits<std::size_t>::max();
+    options.connectTimeout = std::chrono::milliseconds{ 0 };
+    options.timeout = std::chrono::milliseconds{ 0 };
+    return options;
+  }() };
+  return pool;
+}
+
+SessionPool::Lease SessionPool::acquire( Method method )
+{
+  const auto take = [this, method]( std::vector<std::unique_ptr<cpr::Session>>& sessions )
+  {
+    auto session = std::move( sessions.back() );
+    sessions.pop_back();
+    return Lease{ *this, std::move( session ), method };
+  };
+
+  auto lock = std::unique_lock{ mutex };
+  available.wait( lock, [this] { return !idle.empty() || !posting.empty() || created < opts.poolSize; } );
+
+  // A session that has only made GET requests can be used for a POST, but not the other way around.
+  if ( method == Method::Post && !posting.empty() ) return take( posting );
+  if ( !idle.empty() ) return take( idle );
+
+  // When the pool is full and only sessions that have made a POST are free, one is closed and replaced.
+  auto stale = std::unique_ptr<cpr::Session>{};
+  if ( created < opts.poolSize ) ++created;
+  else
+  {
+    stale = std::move( posting.back() );
+    posting.pop_back();
+  }
+
+  lock.unlock();
+  stale.reset();
+  return Lease{ *this, create(), method };
+}
+
+std::string SessionPool::url( std::string_view endpoint ) const
+{
+  return std::format( "{}/{}", opts.baseUrl, endpoint );
+}
+
+std::size_t SessionPool::size() const
+{
+  auto lock = std::lock_guard{ mutex };
+  return created;
+}
+
+void SessionPool::release( std::unique_ptr<cpr::Session> session, Method method )
+{
+  {
+    auto lock = std::lock_guard{ mutex };
+    ( method == Method::Post ? posting : idle ).push_back( std::move( session ) );
+  }
+  available.notify_one();
+}
+
+std::unique_ptr<cpr::Session> SessionPool::create() const
+{
+  auto session = std::make_unique<cpr::Session>();
+  session->SetConnectTimeout( cpr::ConnectTimeout{ opts.connectTimeout } );
+  session->SetTimeout( cpr::Timeout{ opts.timeout } );
+  session->SetHttpVersion( cpr::HttpVersion{ opts.http2 ?
+    cpr::HttpVersionCode::VERSION_2_0_TLS : cpr::HttpVersionCode::VERSION_1_1 } );
+
+  // Probe idle connections so that they are not silently dropped by NAT gateways and load balancers between lookups.
+  curl_easy_setopt( session->GetCurlHolder()->handle, CURLOPT_TCP_KEEPALIVE, 1L );
+  return session;
+}
+
+std::expected<Address, std::string> spt::geocode::impl::reverse( SessionPool& pool, const double latitude,
+  const double longitude, const std::string& key )
+{
+  using O = std::expected<Address, std::string>;
+
+  auto resp = pclient::get( pool, "reverse"sv, cpr::Parameters{ { "access_key", key },
+      { "query", std::format( "{},{}", latitude, longitude ) },
+      { "output", "json" }, { "limit", "1" } } );
+  if ( resp.status_code != 200 )
+  {
+    LOG_WARN << "Error retrieving address for latitude: " << latitude <<
+      "; longitude: " << longitude <<
+      ".  Response status " << resp.status_line <<
+      ". " << resp.text;
+    return O{ std::unexpect, pclient::error( resp ) };
+  }
+
+  boost::system::error_code ec;
+  auto json = boost::json::parse( resp.text, ec );
+  if ( ec )
+  {
+    LOG_WARN << "Error parsing response for latitude: " << latitude <<
+      "; longitude: " << longitude << ".  Error: " << ec.message();
+    return O{ std::unexpect, ec.message() };
+  }
+
+  auto& doc = json.get_object();
+  if ( !doc.contains( "data"sv ) )
+  {
+    LOG_WARN << "No data in response for latitude: " << latitude <<
+      "; longitude: " << longitude << ". " << resp.text;
+    return O{ std::unexpect, "No data in response" };
+  }
+
+  auto& data = doc["data"sv];
+  if ( !data.is_array() )
+  {
+    LOG_WARN << "data not array in response for latitude: " << latitude <<
+      "; longitude: " << longitude << ". " << resp.text;
+    return O{ std::unexpect, "Invalid type for data in response" };
+  }
+
+  auto& arr = data.get_array();
+  if ( arr.empty() )
+  {
+    LOG_WARN << "data array empty in response for latitude: " << latitude <<
+      "; longitude: " << longitude << ". " << resp.text;
+    return O{ std::unexpect, std::string{ impl::noResults } };
+  }
+
+  auto& a = arr.front();
+  if ( !a.is_object() )
+  {
+    LOG_WARN << "data array entry not object in response for latitude: " << latitude <<
+      "; longitude: " << longitude << ". " << resp.text;
+    return O{ std::unexpect, "Non-object in data array" };
+  }
+
+  return O{ pclient::address( a.get_object(), latitude, longitude ) };
+}
+
+std::expected<Point, std::string> spt::geocode::impl::forward( SessionPool& pool, const std::string& address, const std::string& key )
+{
+  using O = std::expected<Point, std::string>;
+  if ( address.empty() ) return O{ std::unexpect, "Empty address" };
+
+  auto resp = pclient::get( pool, "forward"sv, cpr::Parameters{ { "access_key", key },
+      { "query", address },
+      { "output", "json" }, { "limit", "1" } } );
+
+  if ( resp.status_code != 200 )
+  {
+    LOG_WARN << "Error retrieving address for address: " << address <<
+        ".  Response status " << resp.status_line <<
+        ". " << resp.text;
+    return O{ std::unexpect, pclient::error( resp ) };
+  }
+
+  boost::system::error_code ec;
+  auto json = boost::json::parse( resp.text, ec );
+  if ( ec )
+  {
+    LOG_WARN << "Error parsing response for address: " << address << ".  Error: " << ec.message();
+    return O{ std::unexpect, ec.message() };
+  }
+
+  auto& doc = json.get_object();
+  if ( !doc.contains( "data"sv ) )
+  {
+    LOG_WARN << "No data in response for address: " << address << ". " << resp.text;
+    return O{ std::unexpect, "No data in response" };
+  }
+
+  auto& data = doc["data"sv];
+  if ( !data.is_array() )
+  {
+    LOG_WARN << "data not array in response for address: " << address << ". " << resp.text;
+    return O{ std::unexpect, "Invalid type for data in response" };
+  }
+
+  auto& arr = data.get_array();
+  if ( arr.empty() )
+  {
+    LOG_WARN << "data array empty in response for address: " << address << ". " << resp.text;
+    return O{ std::unexpect, std::string{ impl::noResults } };
+  }
+
+  auto& a = arr.front();
+  if ( !a.is_object() )
+  {
+    LOG_WARN << "data array entry not object in response for address: " << address << ". " << resp.text;
+    return O{ std::unexpect, "Non-object in data array" };
+  }
+
+  auto point = pclient::point( a.get_object() );
+  if ( !point ) LOG_WARN << "data array entry does not contain geocodes in response for address: " << address << ". " << resp.text;
+  return point;
+}
+
+void spt::geocode::impl::reverse( SessionPool& pool, std::span<const Point> points,
+  std::span<std::expected<Address, std::string>> results, const std::string& key )
+{
+  auto queries = std::vector<pclient::Query>{};
+  queries.reserve( points.size() );
+  for ( std::size_t i = 0; i < points.size(); ++i )
+  {
+    queries.push_back( { i, std::format( "{},{}", points[i].latitude, points[i].longitude ) } );
+  }
+
+  pclient::batch( pool, "reverse"sv, queries, results, key, [&points]( boost::json::object& ad, std::size_t index )
+  {
+    return std::expected<Address, std::string>{ pclient::address( ad, points[index].latitude, points[index].longitude ) };
+  } );
+}
+
+void spt::geocode::impl::forward( SessionPool& pool, std::span<const std::string> addresses,
+  std::span<std::expected<Point, std::string>> results, const std::string& key )
+{
+  auto queries = std::vector<pclient::Query>{};
+  queries.reserve( addresses.size() );
+  for ( std::size_t i = 0; i < addresses.size(); ++i )
+  {
+    if ( addresses[i].empty() ) results[i] = std::expected<Point, std::string>{ std::unexpect, "Empty address" };
+    else queries.push_back( { i, addresses[i] } );
+  }
+
+  pclient::batch( pool, "forward"sv, queries, results, key, []( boost::json::object& ad, std::size_t )
+  {
+    return pclient::point( ad );
+  } );
+}
+
+void spt::geocode::impl::submit( WorkQueue& queue, std::move_only_function<void()> task )
+{
+  queue.submit( std::move( task ) );
+}
+
+using spt::geocode::Client;
+
+Client::Client( ClientOptions options ) :
+  opts{ std::move( options ) }, pool{ std::make_unique<impl::SessionPool>( opts ) },
+  reverseCache{ opts.reverseCache ? std::make_unique<impl::ReverseCache>( *opts.reverseCache ) : nullptr },
+  forwardCache{ opts.forwardCache ? std::make_unique<impl::ForwardCache>( *opts.forwardCache ) : nullptr },
+  queue{ std::make_unique<impl::WorkQueue>( opts.maxInFlight > 0 ? opts.maxInFlight : opts.poolSize ) } {}
+
+Client::~Client() = default;
+Client::Client( Client&& ) noexcept = default;
+
+Client& Client::operator=( Client&& other ) noexcept
+{
+  // Drain the queued lookups, which use the current pool, before replacing the pool.
+  queue = std::move( other.queue );
+  pool = std::move( other.pool );
+  reverseCache = std::move( other.reverseCache );
+  forwardCache = std::move( other.forwardCache );
+  opts = std::move( other.opts );
+  return *this;
+}
+
+std::expected<Address, std::string> Client::address( const double latitude, const double longitude ) const
+{
+  return pclient::address( *pool, reverseCache.get(), latitude, longitude );
+}
+
+std::expected<Point, std::string> Client::fromAddress( const std::string& address ) const
+{
+  return pclient::point( *pool, forwardCache.get(), address );
+}
+
+std::vector<std::expected<Address, std::string>> Client::addresses( std::span<const Point> points ) const
+{
+  if ( !reverseCache ) return pclient::addresses( *pool, *queue, points );
+
+  // Answer what is cached, and look up each of the remaining cells once.
+  auto results = std::vector<std::expected<Address, std::string>>( points.size() );
+  auto slots = std::vector<std::size_t>( points.size(), std::numeric_limits<std::size_t>::max() );
+  auto cells = std::unordered_map<std::uint64_t, std::size_t>{};
+  auto misses = std::vector<Point>{};
+  for ( std::size_t i = 0; i < points.size(); ++i )
+  {
+    if ( auto address = reverseCache->get( points[i].latitude, points[i].longitude ) )
+    {
+      results[i] = std::move( *address );
+      continue;
+    }
+
+    const auto [it, inserted] = cells.try_emplace( reverseCache->key( points[i].latitude, points[i].longitude ), misses.size() );
+    if ( inserted ) misses.push_back( points[i] );
+    slots[i] = it->second;
+  }
+
+  if ( misses.empty() ) return results;
+  const auto found = pclient::addresses( *pool, *queue, misses );
+  for ( std::size_t i = 0; i < misses.size(); ++i )
+  {
+    if ( found[i] ) reverseCache->put( misses[i].latitude, misses[i].longitude, *found[i] );
+  }
+
+  for ( std::size_t i = 0; i < points.size(); ++i )
+  {
+    if ( slots[i] == std::numeric_limits<std::size_t>::max() ) continue;
+    results[i] = found[slots[i]];
+    if ( results[i] && results[i]->location )
+    {
+      results[i]->location->latitude = points[i].latitude;
+      results[i]->location->longitude = points[i].longitude;
+    }
+  }
+  return results;
+}
+
+std::vector<std::expected<Point, std::string>> Client::fromAddresses( std::span<const std::string> addresses ) const
+{
+  if ( !forwardCache ) return pclient::fromAddresses( *pool, *queue, addresses );
+
+  // Answer what is cached, and look up each of the remaining normalised addresses once.
+  auto results = std::vector<std::expected<Point, std::string>>( addresses.size() );
+  auto slots = std::vector<std::size_t>( addresses.size(), std::numeric_limits<std::size_t>::max() );
+  auto keys = std::unordered_map<std::string, std::size_t>{};
+  auto misses = std::vector<std::string>{};
+  for ( std::size_t i = 0; i < addresses.size(); ++i )
+  {
+    auto key = forwardCache->key( addresses[i] );
+    if ( auto point = forwardCache->get( key ) )
+    {
+      results[i] = std::move( *point );
+      continue;
+    }
+
+    // Addresses without a key are sent as they are, and report their own errors.
+    if ( key.empty() ) key = addresses[i];
+    const auto [it, inserted] = keys.try_emplace( std::move( key ), misses.size() );
+    if ( inserted ) misses.push_back( addresses[i] );
+    slots[i] = it->second;
+  }
+
+  if ( misses.empty() ) return results;
+  const auto found = pclient::fromAddresses( *pool, *queue, misses );
+  for ( std::size_t i = 0; i < misses.size(); ++i ) forwardCache->put( forwardCache->key( misses[i] ), found[i] );
+
+  for ( std::size_t i = 0; i < addresses.size(); ++i )
+  {
+    if ( slots[i] != std::numeric_limits<std::size_t>::max() ) results[i] = found[slots[i]];
+  }
+  return results;
+}
+
+std::future<std::expected<Address, std::string>> Client::addressAsync( const double latitude, const double longitude ) const
+{
+  auto task = std::packaged_task<std::expected<Address, std::string>()>{
+    [pool = pool.get(), cache = reverseCache.get(), latitude, longitude]
+    {
+      return pclient::address( *pool, cache, latitude, longitude );
+    } };
+  auto future = task.get_future();
+  queue->submit( std::move( task ) );
+  return future;
+}
+
+std::future<std::expected<Point, std::string>> Client::fromAddressAsync( std::string address ) const
+{
+  auto task = std::packaged_task<std::expected<Point, std::string>()>{
+    [pool = pool.get(), cache = forwardCache.get(), address = std::move( address )]
+    {
+      return pclient::point( *pool, cache, address );
+    } };
+  auto future = task.get_future();
+  queue->submit( std::move( task ) );
+  return future;
+}
+
+spt::geocode::AsyncLookup<std::expected<Address, std::string>> Client::awaitAddress( const double latitude, const double longitude ) const
+{
+  return { *queue, [pool = pool.get(), cache = reverseCache.get(), latitude, longitude]
+  {
+    return pclient::address( *pool, cache, latitude, longitude );
+  } };
+}
+
+spt::geocode::AsyncLookup<std::expected<Point, std::string>> Client::awaitFromAddress( std::string address ) const
+{
+  return { *queue, [pool = pool.get(), cache = forwardCache.get(), address = std::move( address )]
+  {
+    return pclient::point( *pool, cache, address );
+  } };
+}
+
+std::size_t Client::sessions() const
+{
+  return pool->size();
+}
+
+spt::geocode::CacheStats Client::reverseCacheStats() const
+{
+  return reverseCache ? reverseCache->stats() : CacheStats{};
+}
+
+spt::geocode::CacheStats Client::forwardCacheStats() const
+{
+  return forwardCache ? forwardCache->stats() : CacheStats{};
+}
@@ -0,0 +1,164 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include "../geocode.hpp"
+#include "parallel.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+  namespace pencode
+  {
+    using spt::geocode::impl::olc::alphabet;
+
+    // Multipliers that convert degrees to grid units at the finest (15 digit) precision, and the offsets that make
+    // the values positive, as used by impl::olc::encode.
+    constexpr auto latitudeInverse = static_cast<double>( spt::geocode::impl::olc::latitudeInverse );
+    constexpr auto longitudeInverse = static_cast<double>( spt::geocode::impl::olc::longitudeInverse );
+    constexpr double latitudeOffset = 90.0 * latitudeInverse;
+    constexpr double longitudeOffset = 180.0 * longitudeInverse;
+
+    // Grid units per pair unit for latitude (5^5) and longitude (4^5).
+    constexpr std::int64_t rowsPower = spt::geocode::impl::olc::powers<5>[5];
+    constexpr std::int64_t columnsPower = spt::geocode::impl::olc::powers<4>[5];
+
+    // The two base 20 digits of values below 400.
+    constexpr auto digitPairs = []
+    {
+      auto table = std::array<std::array<std::uint8_t, 2>, 400>{};
+      for ( std::size_t v = 0; v < table.size(); ++v )
+      {
+        table[v] = { static_cast<std::uint8_t>( v / 20 ), static_cast<std::uint8_t>( v % 20 ) };
+      }
+      return table;
+    }();
+
+    // The five base 5 digits of grid row values, most significant first.
+    constexpr auto rowDigits = []
+    {
+      auto table = std::array<std::array<std::uint8_t, 5>, rowsPower>{};
+      for ( std::size_t v = 0; v < table.size(); ++v )
+      {
+        auto value = v;
+        for ( std::size_t d = 5; d > 0; --d )
+        {
+          table[v][d - 1] = static_cast<std::uint8_t>( value % 5 );
+          value /= 5;
+        }
+      }
+      return table;
+    }();
+
+    // Number of points converted to grid values together, so that the conversion loop can be vectorised.
+    constexpr std::size_t blockSize = 256;
+
+    // Points per thread when splitting large batches.
+    constexpr std::size_t grain = 1 << 16;
+
+    // Position of the separator in a code.
+    constexpr std::size_t separator = spt::geocode::impl::olc::separatorPosition;
+
+    // Write the code for the grid values of a point, with the separator but without any padding.
+    void digits( std::int64_t latitude, std::int64_t longitude, std::size_t codeLength, char* out )
+    {
+      if ( codeLength > 10 )
+      {
+        const auto& rows = rowDigits[static_cast<std::size_t>( latitude % rowsPower )];
+        const auto columns = static_cast<std::uint32_t>( longitude & ( columnsPower - 1 ) );
+        for ( std::size_t d = 0; d < 5; ++d )
+        {
+          out[11 + d] = alphabet[rows[d] * 4 + ( ( columns >> ( 8 - 2 * d ) ) & 3 )];
+        }
+      }
+
+      // Pair values are below 20^5, split into a leading digit and two pairs of digits.
+      const auto lat = static_cast<std::uint32_t>( latitude / rowsPower );
+      const auto lng = static_cast<std::uint32_t>( longitude >> 10 );
+      const auto& lat0 = digitPairs[lat % 400];
+      const auto& lat1 = digitPairs[( lat / 400 ) % 400];
+      const auto& lng0 = digitPairs[lng % 400];
+      const auto& lng1 = digitPairs[( lng / 400 ) % 400];
+      out[0] = alphabet[lat / 160000];
+      out[1] = alphabet[lng / 160000];
+      out[2] = alphabet[lat1[0]];
+      out[3] = alphabet[lng1[0]];
+      out[4] = alphabet[lat1[1]];
+      out[5] = alphabet[lng1[1]];
+      out[6] = alphabet[lat0[0]];
+      out[7] = alphabet[lng0[0]];
+      out[separator] = '+';
+      out[9] = alphabet[lat0[1]];
+      out[10] = alphabet[lng0[1]];
+    }
+
+    // Encode the points into consecutive fixed width slots starting at out.
+    void encode( std::span<const double> latitudes, std::span<const double> longitudes,
+      char* out, std::size_t codeLength, std::size_t width )
+    {
+      auto lat = std::array<std::int64_t, blockSize>{};
+      auto lng = std::array<std::int64_t, blockSize>{};
+      auto special = std::array<std::uint8_t, blockSize>{};
+      const auto* const limit = out + latitudes.size() * width;
+
+      for ( std::size_t begin = 0; begin < latitudes.size(); begin += blockSize )
+      {
+        const auto count = std::min( blockSize, latitudes.size() - begin );
+
+        // Branch free conversion to grid values.  Latitudes of 90 or more, longitudes that need normalising and
+        // NaN are flagged and encoded by impl::olc::encode instead.
+        for ( std::size_t i = 0; i < count; ++i )
+        {
+          const auto la = std::max( latitudes[begin + i], -90.0 );
+          const auto lo = longitudes[begin + i];
+          const auto valid = ( la < 90.0 ) & ( lo >= -180.0 ) & ( lo < 180.0 );
+          special[i] = static_cast<std::uint8_t>( !valid );
+          lat[i] = static_cast<std::int64_t>( latitudeOffset + ( valid ? la : 0.0 ) * latitudeInverse );
+          lng[i] = static_cast<std::int64_t>( longitudeOffset + ( valid ? lo : 0.0 ) * longitudeInverse );
+        }
+
+        for ( std::size_t i = 0; i < count; ++i )
+        {
+          auto* target = out + ( begin + i ) * width;
+          if ( special[i] )
+          {
+            spt::geocode::impl::olc::encode( latitudes[begin + i], longitudes[begin + i], codeLength, target );
+            continue;
+          }
+
+          // Writing all 16 characters spills into the next slot, which is overwritten next.  Only the last slot in
+          // the range needs to go through a scratch buffer.
+          if ( limit - target >= static_cast<std::ptrdiff_t>( spt::geocode::FixedCode::capacity ) )
+          {
+            digits( lat[i], lng[i], codeLength, target );
+            for ( auto d = codeLength; d < separator; ++d ) target[d] = '0';
+            continue;
+          }
+
+          auto code = std::array<char, spt::geocode::FixedCode::capacity>{};
+          digits( lat[i], lng[i], codeLength, code.data() );
+          for ( auto d = codeLength; d < separator; ++d ) code[d] = '0';
+          std::memcpy( target, code.data(), width );
+        }
+      }
+    }
+  }
+}
+
+std::size_t spt::geocode::encodeBatch( std::span<const double> latitudes, std::span<const double> longitudes,
+  std::span<char> out, std::size_t codeLength )
+{
+  codeLength = impl::olc::validLength( codeLength );
+  const auto width = locationCodeSize( codeLength );
+  const auto size = std::min( { latitudes.size(), longitudes.size(), out.size() / width } );
+
+  impl::parallelFor( size, pencode::grain, [&]( std::size_t begin, std::size_t end )
+  {
+    pencode::encode( latitudes.subspan( begin, end - begin ), longitudes.subspan( begin, end - begin ),
+      out.data() + begin * width, codeLength, width );
+  } );
+  return size;
+}
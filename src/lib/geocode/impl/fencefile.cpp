@@ -0,0 +1,386 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include "../fencefile.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if !defined( _WIN32 )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace spt::geocode::impl
+{
+  struct FenceFile
+  {
+    static constexpr std::array<char, 8> magic{ 'S', 'P', 'T', 'F', 'E', 'N', 'C', 'E' };
+    static constexpr std::uint32_t byteOrder{ 0x01020304 };
+
+    struct Header
+    {
+      std::array<char, 8> magic;
+      std::uint32_t version;
+      std::uint32_t byteOrder;
+      std::uint64_t size;
+      std::uint64_t fences;
+      std::uint64_t nodes;
+      std::uint64_t entries;
+      std::uint64_t nodesOffset;
+      std::uint64_t entriesOffset;
+      std::uint64_t recordsOffset;
+      std::uint32_t leaves;
+      std::uint32_t reserved;
+    };
+
+    struct Record
+    {
+      BoundingBox box;
+      std::uint64_t vertices;
+      std::uint64_t grid;
+      double cellLatitude;
+      double cellLongitude;
+      std::uint64_t verticesOffset;
+      std::uint64_t cellsOffset;
+      std::uint64_t cellOffsetsOffset;
+      std::uint64_t cellEdgesOffset;
+      std::uint64_t cellEdges;
+    };
+
+    using Node = FenceIndex::Node;
+
+    static_assert( std::is_trivially_copyable_v<Header> && sizeof( Header ) == 80 );
+    static_assert( std::is_trivially_copyable_v<Record> && sizeof( Record ) == 104 );
+    static_assert( std::is_trivially_copyable_v<Node> && sizeof( Node ) == 40 );
+
+    static constexpr std::size_t vertexArrays{ 6 };
+
+    class Writer
+    {
+    public:
+      explicit Writer( std::ofstream& out ) : out{ out } {}
+
+      template <typename T>
+      std::uint64_t write( std::span<const T> values )
+      {
+        const auto offset = position;
+        out.write( reinterpret_cast<const char*>( values.data() ), static_cast<std::streamsize>( values.size_bytes() ) );
+        position += values.size_bytes();
+        align();
+        return offset;
+      }
+
+      void align()
+      {
+        constexpr auto zeros = std::array<char, 8>{};
+        const auto padding = ( 8 - position % 8 ) % 8;
+        out.write( zeros.data(), static_cast<std::streamsize>( padding ) );
+        position += padding;
+      }
+
+      [[nodiscard]] std::uint64_t tell() const { return position; }
+
+    private:
+      std::ofstream& out;
+      std::uint64_t position{ 0 };
+    };
+
+    static std::expected<void, std::string> write( const FenceIndex& index, const std::filesystem::path& path )
+    {
+      auto temporary = path;
+      temporary += ".tmp";
+
+      {
+        auto out = std::ofstream{ temporary, std::ios::binary | std::ios::trunc };
+        if ( !out ) return std::unexpected( std::format( "Unable to open {} for writing", temporary.string() ) );
+
+        auto writer = Writer{ out };
+        auto header = Header{ .magic = magic, .version = MappedFenceIndex::version, .byteOrder = byteOrder, .size = 0,
+          .fences = index.fences.size(), .nodes = index.nodes.size(), .entries = index.entries.size(),
+          .nodesOffset = 0, .entriesOffset = 0, .recordsOffset = 0, .leaves = index.leaves, .reserved = 0 };
+        writer.write( std::span<const Header>{ &header, 1 } );
+
+        header.nodesOffset = writer.write( index.nodes );
+        header.entriesOffset = writer.write( index.entries );
+
+        auto records = std::vector<Record>{};
+        records.reserve( index.fences.size() );
+        for ( const auto& fence : index.fences )
+        {
+          auto& record = records.emplace_back( Record{ .box = fence.box, .vertices = fence.latitudes.size(),
+            .grid = fence.grid, .cellLatitude = fence.cellLatitude, .cellLongitude = fence.cellLongitude,
+            .verticesOffset = writer.tell(), .cellsOffset = 0, .cellOffsetsOffset = 0, .cellEdgesOffset = 0,
+            .cellEdges = fence.cellEdges.size() } );
+          for ( const auto& values : { fence.latitudes, fence.longitudes, fence.latitudeTo, fence.longitudeTo, fence.slopes, fence.intercepts } )
+          {
+            writer.write( values );
+          }
+          record.cellsOffset = writer.write( fence.cells );
+          record.cellOffsetsOffset = writer.write( fence.cellOffsets );
+          record.cellEdgesOffset = writer.write( fence.cellEdges );
+        }
+
+        header.recordsOffset = writer.write( std::span<const Record>{ records } );
+        header.size = writer.tell();
+
+        out.seekp( 0 );
+        out.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+        out.close();
+        if ( !out )
+        {
+          auto ignored = std::error_code{};
+          std::filesystem::remove( temporary, ignored );
+          return std::unexpected( std::format( "Error writing {}", temporary.string() ) );
+        }
+      }
+
+      auto ec = std::error_code{};
+      std::filesystem::rename( temporary, path, ec );
+      if ( ec )
+      {
+        auto ignored = std::error_code{};
+        std::filesystem::remove( temporary, ignored );
+        return std::unexpected( std::format( "Unable to rename {} to {}. {}", temporary.string(), path.string(), ec.message() ) );
+      }
+      return {};
+    }
+
+    template <typename T>
+    static std::expected<std::span<const T>, std::string> view( const char* base, std::uint64_t size,
+      std::uint64_t offset, std::uint64_t count )
+    {
+      if ( offset % alignof( T ) != 0 || offset > size || count > ( size - offset ) / sizeof( T ) )
+      {
+        return std::unexpected( std::format( "Invalid array at offset {} with {} elements", offset, count ) );
+      }
+      return std::span<const T>{ reinterpret_cast<const T*>( base + offset ), static_cast<std::size_t>( count ) };
+    }
+
+    static std::expected<void, std::string> load( MappedFenceIndex& mapped )
+    {
+      const auto* base = static_cast<const char*>( mapped.data );
+      const auto size = static_cast<std::uint64_t>( mapped.length );
+      if ( size < sizeof( Header ) ) return std::unexpected( "File too small for header" );
+
+      auto header = Header{};
+      std::memcpy( &header, base, sizeof( header ) );
+      if ( header.magic != magic ) return std::unexpected( "Not a fence file" );
+      if ( header.byteOrder != byteOrder ) return std::unexpected( "Fence file written with a different byte order" );
+      if ( header.version != MappedFenceIndex::version )
+      {
+        return std::unexpected( std::format( "Unsupported fence file version {}", header.version ) );
+      }
+      if ( header.size != size ) return std::unexpected( "Fence file is truncated" );
+
+      auto& index = mapped.fenceIndex;
+      index.owned = false;
+      index.leaves = header.leaves;
+
+      auto nodes = view<Node>( base, size, header.nodesOffset, header.nodes );
+      if ( !nodes ) return std::unexpected( nodes.error() );
+      index.nodes = *nodes;
+
+      auto entries = view<std::uint32_t>( base, size, header.entriesOffset, header.entries );
+      if ( !entries ) return std::unexpected( entries.error() );
+      index.entries = *entries;
+
+      auto records = view<Record>( base, size, header.recordsOffset, header.fences );
+      if ( !records ) return std::unexpected( records.error() );
+
+      if ( index.leaves > index.nodes.size() ) return std::unexpected( "Invalid leaf count" );
+
+      // Children precede their parents, so heights are known by the time a parent is reached.
+      auto heights = std::vector<std::uint32_t>( index.nodes.size(), 0 );
+      for ( std::size_t i = 0; i < index.nodes.size(); ++i )
+      {
+        const auto& node = index.nodes[i];
+        const auto limit = i < index.leaves ? index.entries.size() : i;
+        if ( node.first > limit || node.count > limit - node.first || node.count > FenceIndex::fanout )
+        {
+          return std::unexpected( "Invalid tree node" );
+        }
+        if ( i < index.leaves ) continue;
+
+        for ( auto j = node.first; j < node.first + node.count; ++j ) heights[i] = std::max( heights[i], heights[j] + 1 );
+        if ( heights[i] > FenceIndex::maxHeight ) return std::unexpected( "Tree too deep" );
+      }
+      for ( const auto entry : index.entries )
+      {
+        if ( entry >= header.fences ) return std::unexpected( "Invalid tree entry" );
+      }
+
+      index.fences.resize( records->size() );
+      for ( std::size_t i = 0; i < records->size(); ++i )
+      {
+        const auto& record = ( *records )[i];
+        auto& fence = index.fences[i];
+        fence.owned = false;
+        fence.box = record.box;
+        fence.padded = BoundingBox{
+          .minLatitude = record.box.minLatitude - PreparedPolygon::tolerance,
+          .minLongitude = record.box.minLongitude - PreparedPolygon::tolerance,
+          .maxLatitude = record.box.maxLatitude + PreparedPolygon::tolerance,
+          .maxLongitude = record.box.maxLongitude + PreparedPolygon::tolerance
+        };
+        fence.grid = record.grid;
+        fence.cellLatitude = record.cellLatitude;
+        fence.cellLongitude = record.cellLongitude;
+
+        // Checked before multiplying, so that a huge count cannot wrap around to a small one.
+        if ( record.verticesOffset > size || record.vertices > ( size - record.verticesOffset ) / ( vertexArrays * sizeof( double ) ) )
+        {
+          return std::unexpected( "Invalid vertex count" );
+        }
+        auto vertices = view<double>( base, size, record.verticesOffset, record.vertices * vertexArrays );
+        if ( !vertices ) return std::unexpected( vertices.error() );
+        fence.latitudes = vertices->subspan( 0, record.vertices );
+        fence.longitudes = vertices->subspan( record.vertices, record.vertices );
+        fence.latitudeTo = vertices->subspan( 2 * record.vertices, record.vertices );
+        fence.longitudeTo = vertices->subspan( 3 * record.vertices, record.vertices );
+        fence.slopes = vertices->subspan( 4 * record.vertices, record.vertices );
+        fence.intercepts = vertices->subspan( 5 * record.vertices, record.vertices );
+
+        if ( record.grid == 0 ) continue;
+        if ( record.grid > ( 1u << 16 ) ) return std::unexpected( "Invalid grid size" );
+
+        const auto cellCount = record.grid * record.grid;
+        auto cells = view<std::uint8_t>( base, size, record.cellsOffset, cellCount );
+        if ( !cells ) return std::unexpected( cells.error() );
+        auto offsets = view<std::uint32_t>( base, size, record.cellOffsetsOffset, cellCount + 1 );
+        if ( !offsets ) return std::unexpected( offsets.error() );
+        auto edges = view<std::uint32_t>( base, size, record.cellEdgesOffset, record.cellEdges );
+        if ( !edges ) return std::unexpected( edges.error() );
+        if ( offsets->front() != 0 || offsets->back() != record.cellEdges ) return std::unexpected( "Invalid grid offsets" );
+
+        fence.cells = *cells;
+        fence.cellOffsets = *offsets;
+        fence.cellEdges = *edges;
+      }
+
+      return {};
+    }
+
+    static std::expected<void, std::string> validate( const MappedFenceIndex& mapped )
+    {
+      const auto& fences = mapped.fenceIndex.fences;
+      for ( std::size_t i = 0; i < fences.size(); ++i )
+      {
+        const auto& fence = fences[i];
+        if ( fence.grid == 0 ) continue;
+
+        if ( std::ranges::adjacent_find( fence.cellOffsets, std::ranges::greater{} ) != fence.cellOffsets.end() )
+        {
+          return std::unexpected( std::format( "Invalid grid offsets for fence {}", i ) );
+        }
+        if ( std::ranges::any_of( fence.cells, []( std::uint8_t cell ) { return cell > 3; } ) )
+        {
+          return std::unexpected( std::format( "Invalid grid cell for fence {}", i ) );
+        }
+        const auto vertices = fence.latitudes.size();
+        if ( std::ranges::any_of( fence.cellEdges, [vertices]( std::uint32_t edge ) { return edge >= vertices; } ) )
+        {
+          return std::unexpected( std::format( "Invalid grid edge for fence {}", i ) );
+        }
+      }
+      return {};
+    }
+  };
+}
+
+std::expected<void, std::string> spt::geocode::writeFenceFile( const FenceIndex& index, const std::filesystem::path& path )
+{
+  return impl::FenceFile::write( index, path );
+}
+
+using spt::geocode::MappedFenceIndex;
+
+std::expected<MappedFenceIndex, std::string> MappedFenceIndex::open( const std::filesystem::path& path )
+{
+  auto mapped = MappedFenceIndex{};
+
+#if defined( _WIN32 )
+  auto in = std::ifstream{ path, std::ios::binary | std::ios::ate };
+  if ( !in ) return std::unexpected( std::format( "Unable to open {}", path.string() ) );
+  mapped.length = static_cast<std::size_t>( in.tellg() );
+  mapped.buffer.resize( ( mapped.length + sizeof( std::uint64_t ) - 1 ) / sizeof( std::uint64_t ) );
+  in.seekg( 0 );
+  in.read( reinterpret_cast<char*>( mapped.buffer.data() ), static_cast<std::streamsize>( mapped.length ) );
+  if ( !in ) return std::unexpected( std::format( "Unable to read {}", path.string() ) );
+  mapped.data = mapped.buffer.data();
+#else
+  const auto fd = ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+  if ( fd < 0 ) return std::unexpected( std::format( "Unable to open {}. {}", path.string(), std::strerror( errno ) ) );
+
+  struct stat st{};
+  if ( ::fstat( fd, &st ) != 0 || st.st_size <= 0 )
+  {
+    ::close( fd );
+    return std::unexpected( std::format( "Unable to determine size of {}", path.string() ) );
+  }
+
+  mapped.length = static_cast<std::size_t>( st.st_size );
+  auto* data = ::mmap( nullptr, mapped.length, PROT_READ, MAP_SHARED, fd, 0 );
+  ::close( fd );
+  if ( data == MAP_FAILED )
+  {
+    mapped.length = 0;
+    return std::unexpected( std::format( "Unable to map {}. {}", path.string(), std::strerror( errno ) ) );
+  }
+  mapped.data = data;
+#endif
+
+  if ( auto result = impl::FenceFile::load( mapped ); !result )
+  {
+    return std::unexpected( std::format( "Invalid fence file {}. {}", path.string(), result.error() ) );
+  }
+  return mapped;
+}
+
+std::expected<void, std::string> MappedFenceIndex::validate() const
+{
+  return impl::FenceFile::validate( *this );
+}
+
+MappedFenceIndex::~MappedFenceIndex()
+{
+  release();
+}
+
+MappedFenceIndex::MappedFenceIndex( MappedFenceIndex&& other ) noexcept
+{
+  *this = std::move( other );
+}
+
+MappedFenceIndex& MappedFenceIndex::operator=( MappedFenceIndex&& other ) noexcept
+{
+  if ( this == &other ) return *this;
+  release();
+  fenceIndex = std::move( other.fenceIndex );
+  data = std::exchange( other.data, nullptr );
+  length = std::exchange( other.length, 0 );
+#if defined( _WIN32 )
+  buffer = std::move( other.buffer );
+#endif
+  return *this;
+}
+
+void MappedFenceIndex::release()
+{
+  fenceIndex = FenceIndex{};
+#if !defined( _WIN32 )
+  if ( data != nullptr ) ::munmap( data, length );
+#endif
+  data = nullptr;
+  length = 0;
+}
@@ -0,0 +1,163 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include "../fenceindex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+using spt::geocode::FenceIndex;
+
+namespace
+{
+  namespace pfenceindex
+  {
+    double centreLatitude( const spt::geocode::BoundingBox& box ) { return ( box.minLatitude + box.maxLatitude ) / 2; }
+    double centreLongitude( const spt::geocode::BoundingBox& box ) { return ( box.minLongitude + box.maxLongitude ) / 2; }
+
+    /**
+     * Sort-Tile-Recursive ordering.  Items are sorted into vertical slices by the latitude of their centres, and
+     * each slice is sorted by longitude, so that consecutive runs of *fanout* items form compact tiles.
+     */
+    template <typename T, typename Box>
+    void str( std::vector<T>& items, Box&& box, std::uint32_t fanout )
+    {
+      const auto pages = ( items.size() + fanout - 1 ) / fanout;
+      const auto slices = static_cast<std::size_t>( std::ceil( std::sqrt( static_cast<double>( pages ) ) ) );
+      const auto sliceSize = slices * fanout;
+
+      std::ranges::sort( items, {}, [&box]( const T& item ) { return centreLatitude( box( item ) ); } );
+      for ( std::size_t i = 0; i < items.size(); i += sliceSize )
+      {
+        const auto end = items.begin() + static_cast<std::ptrdiff_t>( std::min( items.size(), i + sliceSize ) );
+        std::ranges::sort( items.begin() + static_cast<std::ptrdiff_t>( i ), end, {},
+          [&box]( const T& item ) { return centreLongitude( box( item ) ); } );
+      }
+    }
+
+    spt::geocode::BoundingBox pad( spt::geocode::BoundingBox box )
+    {
+      box.minLatitude -= spt::geocode::PreparedPolygon::tolerance;
+      box.minLongitude -= spt::geocode::PreparedPolygon::tolerance;
+      box.maxLatitude += spt::geocode::PreparedPolygon::tolerance;
+      box.maxLongitude += spt::geocode::PreparedPolygon::tolerance;
+      return box;
+    }
+  }
+}
+
+FenceIndex::FenceIndex( const FenceIndex& other ) :
+  fences{ other.fences }, entries{ other.entries }, nodes{ other.nodes }, entryStorage{ other.entryStorage },
+  nodeStorage{ other.nodeStorage }, owned{ other.owned }, leaves{ other.leaves }
+{
+  if ( owned ) bind();
+}
+
+FenceIndex& FenceIndex::operator=( const FenceIndex& other )
+{
+  if ( this == &other ) return *this;
+  *this = FenceIndex{ other };
+  return *this;
+}
+
+FenceIndex::FenceIndex( FenceIndex&& other ) noexcept
+{
+  *this = std::move( other );
+}
+
+FenceIndex& FenceIndex::operator=( FenceIndex&& other ) noexcept
+{
+  if ( this == &other ) return *this;
+
+  fences = std::move( other.fences );
+  entries = std::exchange( other.entries, {} );
+  nodes = std::exchange( other.nodes, {} );
+  entryStorage = std::move( other.entryStorage );
+  nodeStorage = std::move( other.nodeStorage );
+  owned = other.owned;
+  leaves = std::exchange( other.leaves, 0 );
+  other.fences.clear();
+  other.entryStorage.clear();
+  other.nodeStorage.clear();
+  return *this;
+}
+
+FenceIndex::FenceIndex( std::vector<PreparedPolygon> f ) : fences{ std::move( f ) }
+{
+  build();
+}
+
+FenceIndex::FenceIndex( std::span<const Polygon> polygons )
+{
+  fences.reserve( polygons.size() );
+  for ( const auto& polygon : polygons ) fences.emplace_back( polygon );
+  build();
+}
+
+void FenceIndex::bind()
+{
+  entries = entryStorage;
+  nodes = nodeStorage;
+}
+
+void FenceIndex::build()
+{
+  auto& entries = entryStorage;
+  auto& nodes = nodeStorage;
+
+  // Fences with fewer than 3 vertices never contain any point, and are left out of the tree.
+  entries.reserve( fences.size() );
+  for ( std::size_t i = 0; i < fences.size(); ++i )
+  {
+    if ( fences[i].size() > 0 ) entries.push_back( static_cast<std::uint32_t>( i ) );
+  }
+  if ( entries.empty() ) return;
+
+  pfenceindex::str( entries, [this]( std::uint32_t id ) -> const BoundingBox& { return fences[id].bounds(); }, fanout );
+
+  auto level = std::vector<Node>{};
+  level.reserve( ( entries.size() + fanout - 1 ) / fanout );
+  for ( std::uint32_t i = 0; i < entries.size(); i += fanout )
+  {
+    auto& node = level.emplace_back();
+    node.first = i;
+    node.count = std::min( fanout, static_cast<std::uint32_t>( entries.size() ) - i );
+    for ( auto j = i; j < i + node.count; ++j )
+    {
+      const auto box = pfenceindex::pad( fences[entries[j]].bounds() );
+      node.box.extend( box.minLatitude, box.minLongitude );
+      node.box.extend( box.maxLatitude, box.maxLongitude );
+    }
+  }
+
+  leaves = static_cast<std::uint32_t>( level.size() );
+  while ( level.size() > 1 )
+  {
+    pfenceindex::str( level, []( const Node& node ) -> const BoundingBox& { return node.box; }, fanout );
+
+    const auto base = static_cast<std::uint32_t>( nodes.size() );
+    nodes.insert( nodes.end(), level.begin(), level.end() );
+
+    auto parents = std::vector<Node>{};
+    parents.reserve( ( level.size() + fanout - 1 ) / fanout );
+    for ( std::uint32_t i = 0; i < level.size(); i += fanout )
+    {
+      auto& node = parents.emplace_back();
+      node.first = base + i;
+      node.count = std::min( fanout, static_cast<std::uint32_t>( level.size() ) - i );
+      for ( auto j = i; j < i + node.count; ++j )
+      {
+        node.box.extend( level[j].box.minLatitude, level[j].box.minLongitude );
+        node.box.extend( level[j].box.maxLatitude, level[j].box.maxLongitude );
+      }
+    }
+
+    level = std::move( parents );
+  }
+
+  nodes.insert( nodes.end(), level.begin(), level.end() );
+  bind();
+}
@@ -53,32 +53,35 @@ inline bool isEqual(T a, T b) {
 #pragma GCC diagnostic pop
 }
 
+/**
+ * @param a
+ * @param b
+ * @return true if a sorts before b in the order required by getConvexHullOfSorted
+ */
+template <typename T>
+inline bool isLeft(const std::array<T,2> &a, const std::array<T,2> &b) {
+  constexpr const uint8_t X{0};
+  constexpr const uint8_t Y{1};
+  return (a[X] < b[X] || ( (!(a[X] < b[X]) && !(a[X] > b[X]) /*a[X] == b[X]*/) && a[Y] < b[Y]) );
+}
+
 /**
  * Compute convex hull using Andrew's monotone chain algorithm.
- * @param polygon
+ * @param sortedPolygon points sorted by isLeft
  * @return convex hull
  */
 template <typename T>
-inline std::vector<std::array<T,2>> getConvexHull(const std::vector<std::array<T,2>> &polygon) {
+inline std::vector<std::array<T,2>> getConvexHullOfSorted(const std::vector<std::array<T,2>> &sortedPolygon) {
   static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
 
   // Inspired by: https://en.wikibooks.org/wiki/Algorithm_Implementation/Geometry/Convex_hull/Monotone_chain#C++ 
 
-  auto isLeft = [](const std::array<T,2> &a, const std::array<T,2> &b) {
-    constexpr const uint8_t X{0};
-    constexpr const uint8_t Y{1};
-	  return (a[X] < b[X] || ( (!(a[X] < b[X]) && !(a[X] > b[X]) /*a[X] == b[X]*/) && a[Y] < b[Y]) );
-  };
-
   auto ccw = [](const std::array<T,2> &a, const std::array<T,2> &b, const std::array<T,2> &c) {
     constexpr const uint8_t X{0};
     constexpr const uint8_t Y{1};
 	  return (b[X] - a[X]) * (c[Y] - a[Y]) - (b[Y] - a[Y]) * (c[X] - a[X]);
   };
 
-  auto sortedPolygon{polygon};
-  std::sort(sortedPolygon.begin(), sortedPolygon.end(), isLeft);
-
   // Construct lower half of convex hull.
   std::vector<std::array<T,2>> lowerHalf;
   for(auto it{sortedPolygon.begin()}; it != sortedPolygon.end(); ++it) {
@@ -103,6 +106,19 @@ inline std::vector<std::array<T,2>> getConvexHull(const std::vector<std::array<T
   return convexHull;
 }
 
+/**
+ * Compute convex hull using Andrew's monotone chain algorithm.
+ * @param polygon
+ * @return convex hull
+ */
+template <typename T>
+inline std::vector<std::array<T,2>> getConvexHull(const std::vector<std::array<T,2>> &polygon) {
+  static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
+  auto sortedPolygon{polygon};
+  std::sort(sortedPolygon.begin(), sortedPolygon.end(), isLeft<T>);
+  return getConvexHullOfSorted(sortedPolygon);
+}
+
 /**
  * @param polygon describing a geofenced area
  * @param p point to test whether inside or not
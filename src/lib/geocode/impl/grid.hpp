@@ -0,0 +1,92 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "../geocode.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace spt::geocode::impl
+{
+  /**
+   * Uniform grid over the bounding box of a set of items, used to limit a search to the items near a location.
+   * Items are bucketed by bounding box in compressed sparse row form.
+   */
+  struct BoxGrid
+  {
+    BoundingBox box;
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> items;
+    std::size_t size{ 1 };
+    double height{ 1.0 };
+    double width{ 1.0 };
+
+    [[nodiscard]] std::size_t row( double latitude ) const
+    {
+      const auto r = std::floor( ( latitude - box.minLatitude ) / height );
+      return static_cast<std::size_t>( std::clamp( r, 0.0, static_cast<double>( size - 1 ) ) );
+    }
+
+    [[nodiscard]] std::size_t column( double longitude ) const
+    {
+      const auto c = std::floor( ( longitude - box.minLongitude ) / width );
+      return static_cast<std::size_t>( std::clamp( c, 0.0, static_cast<double>( size - 1 ) ) );
+    }
+
+    // Build from items whose bounding boxes are reported by bounds( i ).
+    template <typename Bounds>
+    void build( const BoundingBox& extent, std::size_t count, Bounds&& bounds )
+    {
+      box = extent;
+      size = std::max<std::size_t>( 1, static_cast<std::size_t>( std::sqrt( static_cast<double>( count ) ) ) );
+      height = std::max( ( box.maxLatitude - box.minLatitude ) / static_cast<double>( size ), 1e-12 );
+      width = std::max( ( box.maxLongitude - box.minLongitude ) / static_cast<double>( size ), 1e-12 );
+
+      const auto each = [&]( std::size_t i, auto&& fn )
+      {
+        const auto b = bounds( i );
+        for ( auto r = row( b.minLatitude ); r <= row( b.maxLatitude ); ++r )
+        {
+          for ( auto c = column( b.minLongitude ); c <= column( b.maxLongitude ); ++c ) fn( r * size + c );
+        }
+      };
+
+      offsets.assign( size * size + 1, 0 );
+      for ( std::size_t i = 0; i < count; ++i ) each( i, [this]( std::size_t cell ) { ++offsets[cell + 1]; } );
+      for ( std::size_t i = 0; i < size * size; ++i ) offsets[i + 1] += offsets[i];
+      items.resize( offsets.back() );
+      auto cursor = std::vector<std::uint32_t>{ offsets.begin(), offsets.end() - 1 };
+      for ( std::size_t i = 0; i < count; ++i )
+      {
+        each( i, [&]( std::size_t cell ) { items[cursor[cell]++] = static_cast<std::uint32_t>( i ); } );
+      }
+    }
+
+    // Invoke fn( item ) for items bucketed in the cells the box overlaps.  Items may be reported more than once.
+    template <typename F>
+    void visit( const BoundingBox& b, F&& fn ) const
+    {
+      for ( auto r = row( b.minLatitude ); r <= row( b.maxLatitude ); ++r )
+      {
+        for ( auto c = column( b.minLongitude ); c <= column( b.maxLongitude ); ++c )
+        {
+          const auto cell = r * size + c;
+          for ( auto i = offsets[cell]; i < offsets[cell + 1]; ++i ) fn( items[i] );
+        }
+      }
+    }
+
+    // Invoke fn( item ) for items bucketed in the cell containing the location.  Each item is reported once.
+    template <typename F>
+    void visit( double latitude, double longitude, F&& fn ) const
+    {
+      const auto cell = row( latitude ) * size + column( longitude );
+      for ( auto i = offsets[cell]; i < offsets[cell + 1]; ++i ) fn( items[i] );
+    }
+  };
+}
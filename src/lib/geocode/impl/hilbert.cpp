@@ -0,0 +1,148 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include "../hilbert.hpp"
+
+#include <cmath>
+
+namespace
+{
+  namespace philbert
+  {
+    // The orientation of the curve within a cell is one of four states: bit 0 swaps the axes, and bit 1
+    // complements both.  Moving to a quadrant with the transformed y bit clear swaps the axes, and also
+    // complements them if the transformed x bit is set.
+    constexpr std::uint32_t next( std::uint32_t state, std::uint32_t x, std::uint32_t y )
+    {
+      if ( y == 0 )
+      {
+        state ^= 1;
+        if ( x == 1 ) state ^= 2;
+      }
+      return state;
+    }
+
+    // Curve digit and next state for four levels at a time.  Entry `[state][x << 4 | y]` for the next four bits
+    // of x and y holds the eight bits of the position in the low byte, and the next state above it.
+    constexpr auto encodeTable = []
+    {
+      auto table = std::array<std::array<std::uint16_t, 256>, 4>{};
+      for ( std::uint32_t start = 0; start < 4; ++start )
+      {
+        for ( std::uint32_t xy = 0; xy < 256; ++xy )
+        {
+          auto state = start;
+          std::uint32_t position{ 0 };
+          for ( int bit = 3; bit >= 0; --bit )
+          {
+            auto x = ( xy >> ( 4 + bit ) ) & 1;
+            auto y = ( xy >> bit ) & 1;
+            if ( state & 2 ) { x ^= 1; y ^= 1; }
+            if ( state & 1 ) std::swap( x, y );
+            position = ( position << 2 ) | ( ( 3 * x ) ^ y );
+            state = next( state, x, y );
+          }
+          table[start][xy] = static_cast<std::uint16_t>( position | ( state << 8 ) );
+        }
+      }
+      return table;
+    }();
+
+    // The inverse of *encodeTable*.  Entry `[state][position]` holds the four bits of x and y as `x << 4 | y` in
+    // the low byte, and the next state above it.
+    constexpr auto decodeTable = []
+    {
+      auto table = std::array<std::array<std::uint16_t, 256>, 4>{};
+      for ( std::uint32_t start = 0; start < 4; ++start )
+      {
+        for ( std::uint32_t xy = 0; xy < 256; ++xy )
+        {
+          const auto entry = encodeTable[start][xy];
+          table[start][entry & 0xFF] = static_cast<std::uint16_t>( xy | ( entry & 0xFF00 ) );
+        }
+      }
+      return table;
+    }();
+
+    // Grid cells per side at the finest level.
+    constexpr std::uint64_t side = std::uint64_t{ 1 } << spt::geocode::HilbertId::maxLevel;
+
+    // Curve position of a level 30 cell.  The curve is evaluated over a 2^32 grid a byte at a time, and the two
+    // extra levels dropped, which gives the same positions as a 2^30 grid.
+    std::uint64_t encode( std::uint64_t x, std::uint64_t y )
+    {
+      x <<= 2;
+      y <<= 2;
+      std::uint32_t state{ 0 };
+      std::uint64_t position{ 0 };
+      for ( int shift = 28; shift >= 0; shift -= 4 )
+      {
+        const auto entry = encodeTable[state][( ( x >> shift ) & 0xF ) << 4 | ( ( y >> shift ) & 0xF )];
+        position = ( position << 8 ) | ( entry & 0xFF );
+        state = entry >> 8;
+      }
+      return position >> 4;
+    }
+
+    // Grid cell of a level 30 curve position.
+    std::pair<std::uint64_t, std::uint64_t> decode( std::uint64_t position )
+    {
+      position <<= 4;
+      std::uint32_t state{ 0 };
+      std::uint64_t x{ 0 };
+      std::uint64_t y{ 0 };
+      for ( int shift = 56; shift >= 0; shift -= 8 )
+      {
+        const auto entry = decodeTable[state][( position >> shift ) & 0xFF];
+        x = ( x << 4 ) | ( ( entry >> 4 ) & 0xF );
+        y = ( y << 4 ) | ( entry & 0xF );
+        state = entry >> 8;
+      }
+      return { x >> 2, y >> 2 };
+    }
+
+    // Grid index of a value scaled to [0, side], with NaN and out of range values clamped.
+    std::uint64_t index( double scaled )
+    {
+      if ( !( scaled > 0.0 ) ) return 0;
+      return std::min( static_cast<std::uint64_t>( std::min( scaled, static_cast<double>( side ) ) ), side - 1 );
+    }
+  }
+}
+
+using spt::geocode::HilbertId;
+
+HilbertId HilbertId::fromPoint( double latitude, double longitude, std::size_t level )
+{
+  level = std::min( level, maxLevel );
+  auto lng = std::remainder( longitude, 360.0 );
+  if ( lng >= 180.0 ) lng -= 360.0;
+
+  const auto x = philbert::index( ( lng + 180.0 ) * ( static_cast<double>( philbert::side ) / 360.0 ) );
+  const auto y = philbert::index( ( latitude + 90.0 ) * ( static_cast<double>( philbert::side ) / 180.0 ) );
+  return fromPosition( philbert::encode( x, y ) >> ( 2 * ( maxLevel - level ) ), level );
+}
+
+spt::geocode::BoundingBox HilbertId::bounds() const
+{
+  if ( !valid() ) return {};
+
+  const auto shift = maxLevel - level();
+  const auto [x, y] = philbert::decode( position() << ( 2 * shift ) );
+  const auto width = 360.0 / static_cast<double>( std::uint64_t{ 1 } << level() );
+  const auto height = 180.0 / static_cast<double>( std::uint64_t{ 1 } << level() );
+
+  auto box = BoundingBox{};
+  box.minLatitude = -90.0 + static_cast<double>( y >> shift ) * height;
+  box.minLongitude = -180.0 + static_cast<double>( x >> shift ) * width;
+  box.maxLatitude = box.minLatitude + height;
+  box.maxLongitude = box.minLongitude + width;
+  return box;
+}
+
+spt::geocode::Point HilbertId::centre() const
+{
+  const auto box = bounds();
+  return Point{ .latitude = ( box.minLatitude + box.maxLatitude ) / 2, .longitude = ( box.minLongitude + box.maxLongitude ) / 2 };
+}
@@ -0,0 +1,25 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include "../hull.hpp"
+#include "geofence.hpp"
+
+spt::geocode::Polygon spt::geocode::impl::convexHull( std::vector<std::array<double, 2>>&& points )
+{
+  parallelSort( points, geofence::isLeft<double> );
+  points.erase( std::unique( points.begin(), points.end() ), points.end() );
+
+  auto result = Polygon{};
+  if ( points.size() < 3 )
+  {
+    result.reserve( points.size() );
+    for ( const auto& [latitude, longitude] : points ) result.push_back( Point{ .latitude = latitude, .longitude = longitude } );
+    return result;
+  }
+
+  const auto hull = geofence::getConvexHullOfSorted( points );
+  result.reserve( hull.size() );
+  for ( const auto& [latitude, longitude] : hull ) result.push_back( Point{ .latitude = latitude, .longitude = longitude } );
+  return result;
+}
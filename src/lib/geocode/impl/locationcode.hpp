@@ -0,0 +1,311 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace spt::geocode::impl
+{
+  /// The kind of an Open Location Code, as determined by *olc::decode*.
+  enum class CodeKind : std::uint8_t { Invalid, Short, Full };
+
+  /**
+   * Tables and integer arithmetic for Open Location Codes, shared by the single, batch, shortening and cell codecs.
+   * Everything is `constexpr`, so codes can be encoded and decoded at compile time, and nothing calls `pow`, `log`
+   * or `round` at runtime.
+   */
+  namespace olc
+  {
+    constexpr std::string_view alphabet{ "23456789CFGHJMPQRVWX" };
+    constexpr char separator = '+';
+    constexpr char padding = '0';
+    constexpr std::size_t separatorPosition = 8;
+    constexpr std::size_t pairLength = 10;
+    constexpr std::size_t gridLength = 5;
+    constexpr std::size_t maximumLength = pairLength + gridLength;
+    constexpr std::int64_t encodingBase = 20;
+    constexpr std::int64_t gridColumns = 4;
+    constexpr std::int64_t gridRows = encodingBase / gridColumns;
+    constexpr double latitudeMax = 90.0;
+    constexpr double longitudeMax = 180.0;
+
+    // Alphabet position of each character, or -1 for characters that are not digits of a code.
+    constexpr auto positions = []
+    {
+      auto table = std::array<std::int8_t, 256>{};
+      table.fill( -1 );
+      for ( std::size_t i = 0; i < alphabet.size(); ++i )
+      {
+        const auto c = static_cast<unsigned char>( alphabet[i] );
+        table[c] = static_cast<std::int8_t>( i );
+        if ( c >= 'A' && c <= 'Z' ) table[c - 'A' + 'a'] = static_cast<std::int8_t>( i );
+      }
+      return table;
+    }();
+
+    // Place values of the pair (base 20) and grid (base 5 rows, base 4 columns) digits.
+    template <std::int64_t Base>
+    constexpr auto powers = []
+    {
+      auto table = std::array<std::int64_t, gridLength + 1>{};
+      table[0] = 1;
+      for ( std::size_t i = 1; i < table.size(); ++i ) table[i] = table[i - 1] * Base;
+      return table;
+    }();
+
+    // The exponent of the base needed to represent 360 degrees, floor( log( 360 ) / log( 20 ) ).
+    constexpr std::size_t initialExponent = []
+    {
+      std::size_t exponent{ 0 };
+      for ( auto value = encodingBase; value <= 360; value *= encodingBase ) ++exponent;
+      return exponent;
+    }();
+
+    // Units per degree of the final pair digits (20^3), and of the final grid digits.
+    constexpr std::int64_t pairPrecisionInverse = powers<encodingBase>[pairLength / 2 - ( initialExponent + 1 )];
+    constexpr std::int64_t latitudeInverse = pairPrecisionInverse * powers<gridRows>[gridLength];
+    constexpr std::int64_t longitudeInverse = pairPrecisionInverse * powers<gridColumns>[gridLength];
+
+    // Degrees covered by the first grid digit.
+    constexpr double gridSizeDegrees = 1.0 / static_cast<double>( pairPrecisionInverse );
+
+    /**
+     * The latitude resolution in degrees of a code with the specified number of digits.  Lengths up to 10 have the
+     * same resolution for latitude and longitude, and longer codes have more rows than columns.  Computed from
+     * exact powers, so the results match the reference implementation.
+     */
+    constexpr double precision( std::size_t length )
+    {
+      if ( length > pairLength )
+      {
+        auto divisor = 1.0;
+        for ( auto i = pairLength; i < length; ++i ) divisor *= static_cast<double>( gridRows );
+        return gridSizeDegrees / divisor;
+      }
+      const auto exponent = static_cast<int>( length ) / -2 + 2;
+      return exponent >= 0 ? static_cast<double>( powers<encodingBase>[exponent] ) :
+        1.0 / static_cast<double>( powers<encodingBase>[-exponent] );
+    }
+
+    /// Clamp a code length to a valid length.  Lengths below 2 become 2, and odd lengths below 10 are rounded up.
+    constexpr std::size_t validLength( std::size_t length )
+    {
+      length = std::clamp( length, std::size_t{ 2 }, maximumLength );
+      return length < pairLength && length % 2 == 1 ? length + 1 : length;
+    }
+
+    /// Clamp a latitude to `[-90, 90]`, and move a latitude of 90 into the area of a code of the specified length.
+    constexpr double adjustLatitude( double latitude, std::size_t length )
+    {
+      latitude = std::min( latitudeMax, std::max( -latitudeMax, latitude ) );
+      return latitude < latitudeMax ? latitude : latitude - precision( length ) / 2;
+    }
+
+    /// Normalise a longitude into `[-180, 180)`.  Infinite, NaN and absurdly large longitudes are treated as `0`.
+    constexpr double normaliseLongitude( double longitude )
+    {
+      if ( longitude >= -longitudeMax && longitude < longitudeMax ) return longitude;
+      if ( !( longitude > -1e15 && longitude < 1e15 ) ) return 0.0;
+
+      // Removing whole turns is exact at these magnitudes, so the result matches repeatedly adding 360.
+      longitude -= 360.0 * static_cast<double>( static_cast<std::int64_t>( longitude / 360.0 ) );
+      while ( longitude < -longitudeMax ) longitude += 360.0;
+      while ( longitude >= longitudeMax ) longitude -= 360.0;
+      return longitude;
+    }
+
+    /// Round to 14 decimal places, rounding halves away from zero as `std::round` does.
+    constexpr double round( double value )
+    {
+      value *= 1e14;
+      const auto whole = static_cast<double>( static_cast<std::int64_t>( value ) );
+      const auto fraction = value - whole;
+      if ( fraction >= 0.5 ) return ( whole + 1.0 ) / 1e14;
+      if ( fraction <= -0.5 ) return ( whole - 1.0 ) / 1e14;
+      return whole / 1e14;
+    }
+
+    /**
+     * Encode a geo-location, with the same result as *openlocationcode::Encode*.
+     * @param latitude The latitude in degrees.
+     * @param longitude The longitude in degrees.
+     * @param length The number of significant digits, up to *maximumLength*.  Invalid lengths are adjusted by
+     *   *validLength*.
+     * @param out The buffer to write to, with room for `maximumLength + 1` characters.  No terminating null
+     *   character is written.
+     * @return The number of characters written.
+     */
+    constexpr std::size_t encode( double latitude, double longitude, std::size_t length, char* out )
+    {
+      length = validLength( length );
+      latitude = adjustLatitude( latitude, length );
+      longitude = normaliseLongitude( longitude );
+
+      // Whole grid units at the finest precision, offset so that the south west corner of the world is at zero.
+      // The values are not negative, and unsigned division by the constant bases is cheaper.
+      auto lat = static_cast<std::uint64_t>( latitudeMax * static_cast<double>( latitudeInverse ) + latitude * static_cast<double>( latitudeInverse ) );
+      auto lng = static_cast<std::uint64_t>( longitudeMax * static_cast<double>( longitudeInverse ) + longitude * static_cast<double>( longitudeInverse ) );
+
+      constexpr auto base = static_cast<std::uint64_t>( encodingBase );
+      constexpr auto rows = static_cast<std::uint64_t>( gridRows );
+      constexpr auto columns = static_cast<std::uint64_t>( gridColumns );
+
+      // The digits of the code, most significant first, without the separator.
+      auto digits = std::array<char, maximumLength>{};
+      if ( length > pairLength )
+      {
+        for ( auto i = maximumLength; i > pairLength; --i )
+        {
+          digits[i - 1] = alphabet[( lat % rows ) * columns + lng % columns];
+          lat /= rows;
+          lng /= columns;
+        }
+      }
+      else
+      {
+        lat /= static_cast<std::uint64_t>( powers<gridRows>[gridLength] );
+        lng /= static_cast<std::uint64_t>( powers<gridColumns>[gridLength] );
+      }
+
+      for ( auto i = pairLength; i > 0; i -= 2 )
+      {
+        digits[i - 1] = alphabet[lng % base];
+        digits[i - 2] = alphabet[lat % base];
+        lat /= base;
+        lng /= base;
+      }
+
+      // Pad up to the separator if required, and add the separator followed by any digits after it.
+      const auto significant = std::min( length, separatorPosition );
+      std::copy_n( digits.data(), significant, out );
+      std::fill( out + significant, out + separatorPosition, padding );
+      out[separatorPosition] = separator;
+      if ( length <= separatorPosition ) return separatorPosition + 1;
+      std::copy( digits.data() + separatorPosition, digits.data() + length, out + separatorPosition + 1 );
+      return length + 1;
+    }
+
+    /// The area represented by a full code, as computed by *decode*.
+    struct Area
+    {
+      double minLatitude{ 0.0 };
+      double minLongitude{ 0.0 };
+      double maxLatitude{ 0.0 };
+      double maxLongitude{ 0.0 };
+      std::size_t length{ 0 };
+
+      [[nodiscard]] constexpr double centreLatitude() const
+      {
+        return std::min( minLatitude + ( maxLatitude - minLatitude ) / 2, latitudeMax );
+      }
+
+      [[nodiscard]] constexpr double centreLongitude() const
+      {
+        return std::min( minLongitude + ( maxLongitude - minLongitude ) / 2, longitudeMax );
+      }
+    };
+
+    /**
+     * Validate an Open Location Code in a single pass over its characters, and decode it if it is a full code.
+     * @param code The code to validate.
+     * @param area Set to the area represented by the code if it is a full code, left unchanged otherwise.
+     * @return The kind of code.
+     */
+    constexpr CodeKind decode( std::string_view code, Area& area )
+    {
+      auto separatorAt = std::string_view::npos;
+      auto paddingAt = std::string_view::npos;
+      std::size_t digits{ 0 };
+      std::int64_t latitudePairs{ 0 };
+      std::int64_t longitudePairs{ 0 };
+      std::int64_t rows{ 0 };
+      std::int64_t columns{ 0 };
+
+      for ( std::size_t i = 0; i < code.size(); ++i )
+      {
+        const auto c = code[i];
+        if ( c == separator )
+        {
+          // Only one separator, at an even position no later than the eighth character.
+          if ( separatorAt != std::string_view::npos || i > separatorPosition || i % 2 == 1 ) return CodeKind::Invalid;
+          separatorAt = i;
+          continue;
+        }
+
+        if ( c == padding )
+        {
+          // Padding may only appear before the separator, starting at a non-zero even position.
+          if ( separatorAt != std::string_view::npos ) return CodeKind::Invalid;
+          if ( paddingAt == std::string_view::npos )
+          {
+            if ( i == 0 || i % 2 == 1 ) return CodeKind::Invalid;
+            paddingAt = i;
+          }
+          continue;
+        }
+
+        const auto value = positions[static_cast<unsigned char>( c )];
+        if ( value < 0 || paddingAt != std::string_view::npos ) return CodeKind::Invalid;
+
+        if ( digits < pairLength )
+        {
+          if ( digits % 2 == 0 ) latitudePairs = latitudePairs * encodingBase + value;
+          else longitudePairs = longitudePairs * encodingBase + value;
+        }
+        else if ( digits < maximumLength )
+        {
+          rows = rows * gridRows + value / gridColumns;
+          columns = columns * gridColumns + value % gridColumns;
+        }
+        ++digits;
+      }
+
+      if ( separatorAt == std::string_view::npos || code.size() == 1 ) return CodeKind::Invalid;
+
+      // A single digit after the separator is not legal, and padded codes must be full codes that end at the separator.
+      const auto trailing = code.size() - separatorAt - 1;
+      if ( trailing == 1 ) return CodeKind::Invalid;
+      if ( paddingAt != std::string_view::npos && ( separatorAt < separatorPosition || trailing > 0 ) ) return CodeKind::Invalid;
+
+      if ( separatorAt < separatorPosition ) return CodeKind::Short;
+
+      // The first pair must decode to a latitude below 90 and a longitude below 180.
+      constexpr auto pairs = pairLength / 2;
+      const auto scale = powers<encodingBase>[pairs - std::min( digits, pairLength ) / 2];
+      if ( latitudePairs * scale >= 9 * powers<encodingBase>[pairs - 1] ) return CodeKind::Invalid;
+      if ( longitudePairs * scale >= 18 * powers<encodingBase>[pairs - 1] ) return CodeKind::Invalid;
+
+      // The pair and grid parts are converted to degrees separately and then added, and the maximum is the
+      // unrounded minimum plus the precision, as in the reference implementation, so that the rounded bounds are
+      // identical to those of *openlocationcode::Decode*.
+      const auto grid = digits > pairLength ? std::min( digits, maximumLength ) - pairLength : 0;
+      const auto pairLatitude = latitudePairs * scale - 90 * pairPrecisionInverse;
+      const auto pairLongitude = longitudePairs * scale - 180 * pairPrecisionInverse;
+      const auto gridLatitude = rows * powers<gridRows>[gridLength - grid];
+      const auto gridLongitude = columns * powers<gridColumns>[gridLength - grid];
+      const auto latitude = static_cast<double>( pairLatitude ) / static_cast<double>( pairPrecisionInverse ) +
+        static_cast<double>( gridLatitude ) / static_cast<double>( latitudeInverse );
+      const auto longitude = static_cast<double>( pairLongitude ) / static_cast<double>( pairPrecisionInverse ) +
+        static_cast<double>( gridLongitude ) / static_cast<double>( longitudeInverse );
+      const auto height = grid > 0 ?
+        static_cast<double>( powers<gridRows>[gridLength - grid] ) / static_cast<double>( latitudeInverse ) :
+        static_cast<double>( scale ) / static_cast<double>( pairPrecisionInverse );
+      const auto width = grid > 0 ?
+        static_cast<double>( powers<gridColumns>[gridLength - grid] ) / static_cast<double>( longitudeInverse ) :
+        static_cast<double>( scale ) / static_cast<double>( pairPrecisionInverse );
+
+      area.length = std::min( digits, maximumLength );
+      area.minLatitude = round( latitude );
+      area.minLongitude = round( longitude );
+      area.maxLatitude = round( latitude + height );
+      area.maxLongitude = round( longitude + width );
+      return CodeKind::Full;
+    }
+  }
+}
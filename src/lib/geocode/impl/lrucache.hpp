@@ -0,0 +1,193 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "../client.hpp"
+
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace spt::geocode::impl
+{
+  /**
+   * A least recently used cache with expiring entries, bounded by the number of entries and by an estimate of the
+   * memory used.  The cache is split into shards, each with its own lock, list and index, so that concurrent lookups
+   * of different keys rarely contend.  Keys are assigned to shards by a mix of their hash, and each shard holds an
+   * equal share of the bounds.
+   * @tparam Key The type of the keys.
+   * @tparam Value The type of the cached values, which are copied out on lookup.
+   * @tparam Hash The hash function for keys.
+   */
+  template <typename Key, typename Value, typename Hash = std::hash<Key>>
+  class LruCache
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Create an empty cache.
+     * @param maxBytes The bound on the estimated memory used by the entries, or `0` for no bound.
+     * @param shards The number of shards, rounded up to a power of two.
+     * @param maxEntries The bound on the number of entries.
+     */
+    LruCache( std::size_t maxBytes, std::size_t shards, std::size_t maxEntries = std::numeric_limits<std::size_t>::max() ) :
+      count{ std::bit_ceil( std::max<std::size_t>( shards, 1 ) ) },
+      capacity{ maxBytes > 0 ? maxBytes / count : std::numeric_limits<std::size_t>::max() },
+      limit{ std::max<std::size_t>( maxEntries / count, 1 ) },
+      parts{ std::make_unique<Shard[]>( count ) } {}
+
+    LruCache( const LruCache& ) = delete;
+    LruCache& operator=( const LruCache& ) = delete;
+
+    /**
+     * Look up an entry, and mark it as the most recently used.  Expired entries are removed and reported as misses.
+     * @param key The key to look up.
+     * @return A copy of the value, or `std::nullopt` if there is no unexpired entry for the key.
+     */
+    [[nodiscard]] std::optional<Value> get( const Key& key )
+    {
+      auto& part = shard( key );
+      auto lock = std::lock_guard{ part.mutex };
+
+      const auto it = part.index.find( key );
+      if ( it == part.index.end() )
+      {
+        ++part.stats.misses;
+        return std::nullopt;
+      }
+
+      if ( it->second->expires <= Clock::now() )
+      {
+        ++part.stats.misses;
+        ++part.stats.expirations;
+        part.erase( it );
+        return std::nullopt;
+      }
+
+      ++part.stats.hits;
+      part.entries.splice( part.entries.begin(), part.entries, it->second );
+      return it->second->value;
+    }
+
+    /**
+     * Add or replace an entry, as the most recently used.  Least recently used entries are evicted until the shard
+     * is within its share of the bounds.  Entries larger than the share of the memory bound are not added.
+     * @param key The key of the entry.
+     * @param value The value to cache.
+     * @param bytes The estimated memory used by the entry, including its key.
+     * @param ttl The time after which the entry expires.
+     */
+    void put( const Key& key, Value value, std::size_t bytes, Clock::duration ttl )
+    {
+      if ( bytes > capacity ) return;
+
+      auto& part = shard( key );
+      auto lock = std::lock_guard{ part.mutex };
+      const auto expires = Clock::now() + ttl;
+
+      if ( const auto it = part.index.find( key ); it != part.index.end() )
+      {
+        part.bytes = part.bytes - it->second->bytes + bytes;
+        it->second->value = std::move( value );
+        it->second->bytes = bytes;
+        it->second->expires = expires;
+        part.entries.splice( part.entries.begin(), part.entries, it->second );
+      }
+      else
+      {
+        part.entries.push_front( Entry{ key, std::move( value ), expires, bytes } );
+        part.index.emplace( key, part.entries.begin() );
+        part.bytes += bytes;
+      }
+
+      while ( part.bytes > capacity || part.entries.size() > limit )
+      {
+        ++part.stats.evictions;
+        part.erase( part.index.find( part.entries.back().key ) );
+      }
+    }
+
+    /// Remove all entries.  The counters are not reset.
+    void clear()
+    {
+      for ( std::size_t i = 0; i < count; ++i )
+      {
+        auto lock = std::lock_guard{ parts[i].mutex };
+        parts[i].index.clear();
+        parts[i].entries.clear();
+        parts[i].bytes = 0;
+      }
+    }
+
+    /// The counters and size of the cache, summed over the shards.
+    [[nodiscard]] CacheStats stats() const
+    {
+      auto result = CacheStats{};
+      for ( std::size_t i = 0; i < count; ++i )
+      {
+        auto lock = std::lock_guard{ parts[i].mutex };
+        result.hits += parts[i].stats.hits;
+        result.misses += parts[i].stats.misses;
+        result.evictions += parts[i].stats.evictions;
+        result.expirations += parts[i].stats.expirations;
+        result.entries += parts[i].entries.size();
+        result.bytes += parts[i].bytes;
+      }
+      return result;
+    }
+
+    /// The number of shards.
+    [[nodiscard]] std::size_t shards() const { return count; }
+
+  private:
+    struct Entry
+    {
+      Key key;
+      Value value;
+      Clock::time_point expires;
+      std::size_t bytes;
+    };
+
+    using Iterator = typename std::list<Entry>::iterator;
+
+    // Aligned so that the locks of neighbouring shards do not share a cache line.
+    struct alignas( 64 ) Shard
+    {
+      void erase( typename std::unordered_map<Key, Iterator, Hash>::iterator it )
+      {
+        bytes -= it->second->bytes;
+        entries.erase( it->second );
+        index.erase( it );
+      }
+
+      mutable std::mutex mutex;
+      std::list<Entry> entries;
+      std::unordered_map<Key, Iterator, Hash> index;
+      std::size_t bytes{ 0 };
+      CacheStats stats;
+    };
+
+    Shard& shard( const Key& key )
+    {
+      // Mix the hash, as hashes of integers are the integers themselves, whose low bits may all be the same.
+      const auto hash = static_cast<std::uint64_t>( Hash{}( key ) ) * 0x9E3779B97F4A7C15ull;
+      return parts[static_cast<std::size_t>( hash >> 32 ) & ( count - 1 )];
+    }
+
+    std::size_t count;
+    std::size_t capacity;
+    std::size_t limit;
+    std::unique_ptr<Shard[]> parts;
+  };
+}
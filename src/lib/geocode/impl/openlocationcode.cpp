@@ -6,101 +6,67 @@
 #include <cstdint>
 
 #include "codearea.hpp"
+#include "locationcode.hpp"
 
 namespace openlocationcode {
 namespace internal {
-const char kSeparator = '+';
-const char kPaddingCharacter = '0';
-const char kAlphabet[] = "23456789CFGHJMPQRVWX";
+namespace olc = spt::geocode::impl::olc;
+constexpr char kSeparator = olc::separator;
+constexpr char kPaddingCharacter = olc::padding;
+constexpr char kAlphabet[] = "23456789CFGHJMPQRVWX";
+static_assert(olc::alphabet == kAlphabet);
 // Number of digits in the alphabet.
-const size_t kEncodingBase = 20;
+constexpr size_t kEncodingBase = olc::encodingBase;
 // The max number of digits returned in a plus code. Roughly 1 x 0.5 cm.
-const size_t kMaximumDigitCount = 15;
-const size_t kPairCodeLength = 10;
-const size_t kGridCodeLength = kMaximumDigitCount - kPairCodeLength;
-const size_t kGridColumns = 4;
-const size_t kGridRows = kEncodingBase / kGridColumns;
-const size_t kSeparatorPosition = 8;
-// Work out the encoding base exponent necessary to represent 360 degrees.
-const size_t kInitialExponent = floor(log(360) / log(kEncodingBase));
-// Work out the enclosing resolution (in degrees) for the grid algorithm.
-const double kGridSizeDegrees =
-    1 / pow(kEncodingBase, kPairCodeLength / 2 - (kInitialExponent + 1));
+constexpr size_t kMaximumDigitCount = olc::maximumLength;
+constexpr size_t kPairCodeLength = olc::pairLength;
+constexpr size_t kGridCodeLength = olc::gridLength;
+constexpr size_t kGridColumns = olc::gridColumns;
+constexpr size_t kGridRows = olc::gridRows;
+constexpr size_t kSeparatorPosition = olc::separatorPosition;
+// The encoding base exponent necessary to represent 360 degrees.
+constexpr size_t kInitialExponent = olc::initialExponent;
+// The enclosing resolution (in degrees) for the grid algorithm.
+constexpr double kGridSizeDegrees = olc::gridSizeDegrees;
 // Inverse (1/) of the precision of the final pair digits in degrees. (20^3)
-const size_t kPairPrecisionInverse = 8000;
+constexpr size_t kPairPrecisionInverse = olc::pairPrecisionInverse;
 // Inverse (1/) of the precision of the final grid digits in degrees.
 // (Latitude and longitude are different.)
-const size_t kGridLatPrecisionInverse =
-    kPairPrecisionInverse * pow(kGridRows, kGridCodeLength);
-const size_t kGridLngPrecisionInverse =
-    kPairPrecisionInverse * pow(kGridColumns, kGridCodeLength);
+constexpr size_t kGridLatPrecisionInverse = olc::latitudeInverse;
+constexpr size_t kGridLngPrecisionInverse = olc::longitudeInverse;
+// Maximum number of characters in a code, including the separator.
+constexpr size_t kMaximumCodeSize = kMaximumDigitCount + 1;
 // Latitude bounds are -kLatitudeMaxDegrees degrees and +kLatitudeMaxDegrees
 // degrees which we transpose to 0 and 180 degrees.
-const double kLatitudeMaxDegrees = 90;
+constexpr double kLatitudeMaxDegrees = olc::latitudeMax;
 // Longitude bounds are -kLongitudeMaxDegrees degrees and +kLongitudeMaxDegrees
 // degrees which we transpose to 0 and 360.
-const double kLongitudeMaxDegrees = 180;
-// Lookup table of the alphabet positions of characters 'C' through 'X',
-// inclusive. A value of -1 means the character isn't part of the alphabet.
-const int kPositionLUT['X' - 'C' + 1] = {8,  -1, -1, 9,  10, 11, -1, 12,
-                                         -1, -1, 13, -1, -1, 14, 15, 16,
-                                         -1, -1, -1, 17, 18, 19};
+constexpr double kLongitudeMaxDegrees = olc::longitudeMax;
 }  // namespace internal
 
 namespace {
 
-// Raises a number to an exponent, handling negative exponents.
-double pow_neg(double base, double exponent) {
-  if (exponent == 0) {
-    return 1;
-  } else if (exponent > 0) {
-    return pow(base, exponent);
-  }
-  return 1 / pow(base, -exponent);
-}
-
 // Compute the latitude precision value for a given code length. Lengths <= 10
 // have the same precision for latitude and longitude, but lengths > 10 have
 // different precisions due to the grid method having fewer columns than rows.
-double compute_precision_for_length(int code_length) {
-  if (code_length <= 10) {
-    return pow_neg(internal::kEncodingBase, floor((code_length / -2) + 2));
-  }
-  return pow_neg(internal::kEncodingBase, -3) / pow(5, code_length - 10);
+constexpr double compute_precision_for_length(size_t code_length) {
+  return internal::olc::precision(code_length);
 }
 
 // Returns the position of a char in the encoding alphabet, or -1 if invalid.
-int get_alphabet_position(char c) {
-  // We use a lookup table for performance reasons (e.g. over std::find).
-  if (c >= 'C' && c <= 'X') return internal::kPositionLUT[c - 'C'];
-  if (c >= 'c' && c <= 'x') return internal::kPositionLUT[c - 'c'];
-  if (c >= '2' && c <= '9') return c - '2';
-  return -1;
+constexpr int get_alphabet_position(char c) {
+  return internal::olc::positions[static_cast<unsigned char>(c)];
 }
 
 // Normalize a longitude into the range -180 to 180, not including 180.
-double normalize_longitude(double longitude_degrees) {
-  while (longitude_degrees < -internal::kLongitudeMaxDegrees) {
-    longitude_degrees = longitude_degrees + 360;
-  }
-  while (longitude_degrees >= internal::kLongitudeMaxDegrees) {
-    longitude_degrees = longitude_degrees - 360;
-  }
-  return longitude_degrees;
+constexpr double normalize_longitude(double longitude_degrees) {
+  return internal::olc::normaliseLongitude(longitude_degrees);
 }
 
 // Adjusts 90 degree latitude to be lower so that a legal OLC code can be
 // generated.
-double adjust_latitude(double latitude_degrees, size_t code_length) {
-  latitude_degrees = std::min(90.0, std::max(-90.0, latitude_degrees));
-
-  if (latitude_degrees < internal::kLatitudeMaxDegrees) {
-    return latitude_degrees;
-  }
-  // Subtract half the code precision to get the latitude into the code
-  // area.
-  double precision = compute_precision_for_length(code_length);
-  return latitude_degrees - precision / 2;
+constexpr double adjust_latitude(double latitude_degrees, size_t code_length) {
+  return internal::olc::adjustLatitude(latitude_degrees, code_length);
 }
 
 // Remove the separator and padding characters from the code.
@@ -118,71 +84,14 @@ std::string clean_code_chars(const std::string &code) {
 
 }  // anonymous namespace
 
-std::string Encode(const LatLng &location, size_t code_length) {
-  // Limit the maximum number of digits in the code.
-  code_length = std::min(code_length, internal::kMaximumDigitCount);
-  // Adjust latitude and longitude so that they are normalized/clipped.
-  double latitude = adjust_latitude(location.latitude, code_length);
-  double longitude = normalize_longitude(location.longitude);
-  // Reserve 15 characters for the code digits. The separator will be inserted
-  // at the end.
-  std::string code = "123456789abcdef";
-
-  // Compute the code.
-  // This approach converts each value to an integer after multiplying it by
-  // the final precision. This allows us to use only integer operations, so
-  // avoiding any accumulation of floating point representation errors.
-
-  // Multiply values by their precision and convert to positive without any
-  // floating point operations.
-  int64_t lat_val =
-      internal::kLatitudeMaxDegrees * internal::kGridLatPrecisionInverse;
-  int64_t lng_val =
-      internal::kLongitudeMaxDegrees * internal::kGridLngPrecisionInverse;
-  lat_val += latitude * internal::kGridLatPrecisionInverse;
-  lng_val += longitude * internal::kGridLngPrecisionInverse;
-
-  size_t pos = internal::kMaximumDigitCount - 1;
-  // Compute the grid part of the code if necessary.
-  if (code_length > internal::kPairCodeLength) {
-    for (size_t i = 0; i < internal::kGridCodeLength; i++) {
-      int lat_digit = lat_val % internal::kGridRows;
-      int lng_digit = lng_val % internal::kGridColumns;
-      int ndx = lat_digit * internal::kGridColumns + lng_digit;
-      code.replace(pos--, 1, 1, internal::kAlphabet[ndx]);
-      // Note! Integer division.
-      lat_val /= internal::kGridRows;
-      lng_val /= internal::kGridColumns;
-    }
-  } else {
-    lat_val /= pow(internal::kGridRows, internal::kGridCodeLength);
-    lng_val /= pow(internal::kGridColumns, internal::kGridCodeLength);
-  }
-  pos = internal::kPairCodeLength - 1;
-  // Compute the pair section of the code.
-  for (size_t i = 0; i < internal::kPairCodeLength / 2; i++) {
-    int lat_ndx = lat_val % internal::kEncodingBase;
-    int lng_ndx = lng_val % internal::kEncodingBase;
-    code.replace(pos--, 1, 1, internal::kAlphabet[lng_ndx]);
-    code.replace(pos--, 1, 1, internal::kAlphabet[lat_ndx]);
-    // Note! Integer division.
-    lat_val /= internal::kEncodingBase;
-    lng_val /= internal::kEncodingBase;
-  }
-
-  // Add the separator character.
-  code.insert(internal::kSeparatorPosition, &(internal::kSeparator), 1);
+size_t EncodeTo(const LatLng &location, size_t code_length, char *out) {
+  return internal::olc::encode(location.latitude, location.longitude,
+                               code_length, out);
+}
 
-  // If we don't need to pad the code, return the requested section.
-  if (code_length >= internal::kSeparatorPosition) {
-    return code.substr(0, code_length + 1);
-  }
-  // Add the required padding characters.
-  for (size_t i = code_length; i < internal::kSeparatorPosition; i++) {
-    code[i] = internal::kPaddingCharacter;
-  }
-  // Return the code up to and including the separator.
-  return code.substr(0, internal::kSeparatorPosition + 1);
+std::string Encode(const LatLng &location, size_t code_length) {
+  char code[internal::kMaximumCodeSize];
+  return std::string(code, EncodeTo(location, code_length, code));
 }
 
 std::string Encode(const LatLng &location) {
@@ -206,7 +115,8 @@ CodeArea Decode(const std::string &code) {
   // How many digits do we have to process?
   size_t digits = std::min(internal::kPairCodeLength, clean_code.size());
   // Define the place value for the most significant pair.
-  int pv = pow(internal::kEncodingBase, internal::kPairCodeLength / 2 - 1);
+  int pv = internal::olc::powers<internal::olc::encodingBase>
+      [internal::kPairCodeLength / 2 - 1];
   for (size_t i = 0; i < digits - 1; i += 2) {
     normal_lat += get_alphabet_position(clean_code[i]) * pv;
     normal_lng += get_alphabet_position(clean_code[i + 1]) * pv;
@@ -220,8 +130,10 @@ CodeArea Decode(const std::string &code) {
   // Process any extra precision digits.
   if (clean_code.size() > internal::kPairCodeLength) {
     // Initialise the place values for the grid.
-    int row_pv = pow(internal::kGridRows, internal::kGridCodeLength - 1);
-    int col_pv = pow(internal::kGridColumns, internal::kGridCodeLength - 1);
+    int row_pv = internal::olc::powers<internal::olc::gridRows>
+        [internal::kGridCodeLength - 1];
+    int col_pv = internal::olc::powers<internal::olc::gridColumns>
+        [internal::kGridCodeLength - 1];
     // How many digits do we have to process?
     digits = std::min(internal::kMaximumDigitCount, clean_code.size());
     for (size_t i = internal::kPairCodeLength; i < digits; i++) {
@@ -246,9 +158,9 @@ CodeArea Decode(const std::string &code) {
   double lng = (double)normal_lng / internal::kPairPrecisionInverse +
                (double)extra_lng / internal::kGridLngPrecisionInverse;
   // Round everything off to 14 places.
-  return CodeArea(round(lat * 1e14) / 1e14, round(lng * 1e14) / 1e14,
-                  round((lat + lat_precision) * 1e14) / 1e14,
-                  round((lng + lng_precision) * 1e14) / 1e14,
+  return CodeArea(internal::olc::round(lat), internal::olc::round(lng),
+                  internal::olc::round(lat + lat_precision),
+                  internal::olc::round(lng + lng_precision),
                   clean_code.size());
 }
 
@@ -300,8 +212,7 @@ std::string RecoverNearest(const std::string &short_code,
   size_t padding_length =
       internal::kSeparatorPosition - short_code.find(internal::kSeparator);
   // The resolution (height and width) of the padded area in degrees.
-  double resolution =
-      pow_neg(internal::kEncodingBase, 2.0 - (padding_length / 2.0));
+  double resolution = compute_precision_for_length(padding_length);
   // Distance from the center to an edge (in degrees).
   double half_res = resolution / 2.0;
   // Use the reference location to pad the supplied short code and decode it.
@@ -24,6 +24,14 @@ namespace openlocationcode {
 // for formatting.
 std::string Encode(const LatLng &location, size_t code_length);
 
+// Encodes a pair of coordinates into a caller supplied buffer, without any
+// heap allocation. The code is identical to the one returned by Encode.
+//
+// The buffer must have room for the code, which is at most
+// internal::kMaximumCodeSize characters. No terminating null character is
+// written. Returns the number of characters written.
+size_t EncodeTo(const LatLng &location, size_t code_length, char *out);
+
 // Encodes a pair of coordinates and return an Open Location Code representing a
 // rectangle that encloses the coordinates. The accuracy of the code is
 // sufficient to represent a building such as a house, and is approximately
@@ -86,13 +94,12 @@ extern const size_t kSeparatorPosition;
 // Defines the maximum number of digits in a code (excluding separator). Codes
 // with this length have a precision of less than 1e-10 cm at the equator.
 extern const size_t kMaximumDigitCount;
+// The maximum number of characters in a code, including the separator.
+extern const size_t kMaximumCodeSize;
 // Padding is used when less precise codes are desired.
 extern const char kPaddingCharacter;
 // The alphabet of the codes.
 extern const char kAlphabet[];
-// Lookup table of the alphabet positions of characters 'C' through 'X',
-// inclusive. A value of -1 means the character isn't part of the alphabet.
-extern const int kPositionLUT['X' - 'C' + 1];
 // The number base used for the encoding.
 extern const size_t kEncodingBase;
 // How many characters use the pair algorithm.
@@ -0,0 +1,182 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace spt::geocode::impl
+{
+  /**
+   * Number of worker threads to use for data parallel loops.
+   * @return The hardware concurrency, or `1` if it cannot be determined.
+   */
+  inline std::size_t concurrency()
+  {
+    const auto n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+  }
+
+  /**
+   * Number of chunks a data parallel loop splits a range into.
+   * @param size The number of elements in the range.
+   * @param grain The minimum number of elements to hand to a thread.
+   * @return The number of chunks, at most *concurrency*, which is `1` if the range is processed on the calling thread.
+   */
+  inline std::size_t chunks( std::size_t size, std::size_t grain )
+  {
+    return std::min( concurrency(), std::max<std::size_t>( 1, size / std::max<std::size_t>( grain, 1 ) ) );
+  }
+
+  /**
+   * Split the index range `[0, size)` into contiguous chunks and invoke `fn( begin, end )` for each chunk on its
+   * own thread.  The calling thread processes the first chunk.  Ranges smaller than `grain` are processed on
+   * the calling thread without spawning any threads.
+   * @tparam F A callable with signature `void( std::size_t, std::size_t )`.
+   * @param size The number of elements in the range.
+   * @param grain The minimum number of elements to hand to a thread.
+   * @param fn The function to invoke for each chunk.
+   */
+  template <typename F>
+  void parallelFor( std::size_t size, std::size_t grain, F&& fn )
+  {
+    if ( size == 0 ) return;
+    const auto count = chunks( size, grain );
+    if ( count <= 1 )
+    {
+      fn( std::size_t{ 0 }, size );
+      return;
+    }
+
+    const auto step = ( size + count - 1 ) / count;
+    auto threads = std::vector<std::jthread>{};
+    threads.reserve( count - 1 );
+    for ( std::size_t begin = step; begin < size; begin += step )
+    {
+      const auto end = std::min( size, begin + step );
+      threads.emplace_back( [&fn, begin, end] { fn( begin, end ); } );
+    }
+    fn( std::size_t{ 0 }, std::min( size, step ) );
+  }
+
+  /**
+   * Sort a vector using multiple threads.  Contiguous chunks are sorted concurrently, and then merged pairwise
+   * with each round of merges also running concurrently.  Vectors smaller than `grain` are sorted on the calling
+   * thread.  The sort is not stable.
+   * @tparam T The type of value to sort.
+   * @tparam Compare A strict weak ordering over `T`.
+   * @param values The values to sort.
+   * @param compare The ordering to sort by.
+   * @param grain The minimum number of elements to hand to a thread.
+   */
+  template <typename T, typename Compare>
+  void parallelSort( std::vector<T>& values, Compare compare, std::size_t grain = 1 << 14 )
+  {
+    const auto size = values.size();
+    const auto chunks = std::min( concurrency(), std::max<std::size_t>( 1, size / std::max<std::size_t>( grain, 1 ) ) );
+    if ( chunks <= 1 )
+    {
+      std::sort( values.begin(), values.end(), compare );
+      return;
+    }
+
+    const auto at = [&values, size]( std::size_t index )
+    {
+      return values.begin() + static_cast<std::ptrdiff_t>( std::min( index, size ) );
+    };
+
+    const auto step = ( size + chunks - 1 ) / chunks;
+    parallelFor( chunks, 1, [&]( std::size_t begin, std::size_t end )
+    {
+      for ( auto c = begin; c < end; ++c ) std::sort( at( c * step ), at( ( c + 1 ) * step ), compare );
+    } );
+
+    for ( auto width = step; width < size; width *= 2 )
+    {
+      const auto pairs = ( size + 2 * width - 1 ) / ( 2 * width );
+      parallelFor( pairs, 1, [&]( std::size_t begin, std::size_t end )
+      {
+        for ( auto p = begin; p < end; ++p )
+        {
+          const auto low = p * 2 * width;
+          std::inplace_merge( at( low ), at( low + width ), at( low + 2 * width ), compare );
+        }
+      } );
+    }
+  }
+
+  /**
+   * Sort a vector by an unsigned integer key using a least significant digit radix sort, one byte per pass.  Each
+   * pass counts the digits of contiguous chunks concurrently, and then scatters the chunks concurrently into their
+   * slots in a second buffer.  Passes in which every key has the same digit are skipped.  The sort is stable.
+   * @tparam T The type of value to sort.  Must be default constructible and movable.
+   * @tparam Key A callable with signature `std::uint64_t( const T& )`, which is invoked twice per pass and should
+   *   therefore be cheap, typically reading a precomputed member.
+   * @param values The values to sort.
+   * @param key The key to sort by.
+   * @param bits The number of low order bits of the key that are significant.
+   * @param grain The minimum number of elements to hand to a thread.
+   */
+  template <typename T, typename Key>
+  void radixSort( std::vector<T>& values, Key key, std::size_t bits = 64, std::size_t grain = 1 << 16 )
+  {
+    constexpr std::size_t radix = 8;
+    constexpr std::size_t buckets = std::size_t{ 1 } << radix;
+
+    const auto size = values.size();
+    if ( size < 2 ) return;
+    const auto chunks = std::min( concurrency(), std::max<std::size_t>( 1, size / std::max<std::size_t>( grain, 1 ) ) );
+    const auto step = ( size + chunks - 1 ) / chunks;
+
+    auto buffer = std::vector<T>( size );
+    auto counts = std::vector<std::array<std::size_t, buckets>>( chunks );
+
+    for ( std::size_t shift = 0; shift < bits; shift += radix )
+    {
+      parallelFor( chunks, 1, [&]( std::size_t begin, std::size_t end )
+      {
+        for ( auto c = begin; c < end; ++c )
+        {
+          auto& count = counts[c];
+          count.fill( 0 );
+          for ( auto i = c * step; i < std::min( size, ( c + 1 ) * step ); ++i ) ++count[( key( values[i] ) >> shift ) & ( buckets - 1 )];
+        }
+      } );
+
+      // Each chunk scatters to its own slots, after those of earlier digits and of earlier chunks with this digit.
+      std::size_t total{ 0 };
+      bool uniform{ false };
+      for ( std::size_t d = 0; d < buckets; ++d )
+      {
+        const auto start = total;
+        for ( auto& count : counts )
+        {
+          const auto n = count[d];
+          count[d] = total;
+          total += n;
+        }
+        if ( total - start == size ) uniform = true;
+      }
+      if ( uniform ) continue;
+
+      parallelFor( chunks, 1, [&]( std::size_t begin, std::size_t end )
+      {
+        for ( auto c = begin; c < end; ++c )
+        {
+          auto& offset = counts[c];
+          for ( auto i = c * step; i < std::min( size, ( c + 1 ) * step ); ++i )
+          {
+            buffer[offset[( key( values[i] ) >> shift ) & ( buckets - 1 )]++] = std::move( values[i] );
+          }
+        }
+      } );
+      values.swap( buffer );
+    }
+  }
+}
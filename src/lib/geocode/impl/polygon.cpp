@@ -0,0 +1,460 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include "../polygon.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <optional>
+#include <utility>
+
+using spt::geocode::PreparedPolygon;
+
+namespace
+{
+  namespace ppolygon
+  {
+#if defined( __x86_64__ ) && defined( __GNUC__ ) && !defined( __APPLE__ ) && !defined( __clang__ )
+#define GEOCODE_TARGET_CLONES __attribute__(( target_clones( "arch=x86-64-v4", "arch=x86-64-v3", "default" ) ))
+#else
+#define GEOCODE_TARGET_CLONES
+#endif
+
+    struct Edges
+    {
+      const double* latitudes;
+      const double* longitudes;
+      const double* from;
+      const double* to;
+      const double* slopes;
+      const double* intercepts;
+      std::size_t size;
+    };
+
+    // Edge major crossing test over a block of points.  Accumulators are doubles so that the inner loop
+    // vectorises without lane conversions.  Each straddling edge to the left of a point adds +1 or -1 to its
+    // winding sum, and an odd sum has the same parity as the crossing count.  On x86-64, AVX2 and AVX-512 clones are
+    // selected at runtime when available.
+    GEOCODE_TARGET_CLONES
+    void accumulate( const Edges& edges, const double* __restrict lat, const double* __restrict lng, std::size_t n,
+      double* __restrict winding, double* __restrict near )
+    {
+      for ( std::size_t e = 0; e < edges.size; ++e )
+      {
+        const auto from = edges.from[e];
+        const auto to = edges.to[e];
+        const auto slope = edges.slopes[e];
+        const auto intercept = edges.intercepts[e];
+        const auto vlat = edges.latitudes[e];
+        const auto vlng = edges.longitudes[e];
+
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+          const auto straddles = ( from > lng[i] ? 1.0 : 0.0 ) - ( to > lng[i] ? 1.0 : 0.0 );
+          winding[i] += lat[i] < slope * lng[i] + intercept ? straddles : 0.0;
+          // Coarse vertex proximity; the exact comparison is only made for the rare points flagged here.
+          near[i] += std::max( std::abs( lat[i] - vlat ), std::abs( lng[i] - vlng ) ) <= 2e-7 ? 1.0 : 0.0;
+        }
+      }
+    }
+  }
+}
+
+PreparedPolygon::PreparedPolygon( const PreparedPolygon& other ) :
+  box{ other.box }, padded{ other.padded }, latitudes{ other.latitudes }, longitudes{ other.longitudes },
+  latitudeTo{ other.latitudeTo }, longitudeTo{ other.longitudeTo }, slopes{ other.slopes },
+  intercepts{ other.intercepts }, cells{ other.cells }, cellOffsets{ other.cellOffsets },
+  cellEdges{ other.cellEdges }, grid{ other.grid }, cellLatitude{ other.cellLatitude }, cellLongitude{ other.cellLongitude },
+  storage{ other.storage }, owned{ other.owned }
+{
+  if ( owned ) bind();
+}
+
+PreparedPolygon::PreparedPolygon( PreparedPolygon&& other ) noexcept
+{
+  *this = std::move( other );
+}
+
+PreparedPolygon& PreparedPolygon::operator=( const PreparedPolygon& other )
+{
+  if ( this == &other ) return *this;
+  *this = PreparedPolygon{ other };
+  return *this;
+}
+
+PreparedPolygon& PreparedPolygon::operator=( PreparedPolygon&& other ) noexcept
+{
+  if ( this == &other ) return *this;
+
+  box = other.box;
+  padded = other.padded;
+  latitudes = std::exchange( other.latitudes, {} );
+  longitudes = std::exchange( other.longitudes, {} );
+  latitudeTo = std::exchange( other.latitudeTo, {} );
+  longitudeTo = std::exchange( other.longitudeTo, {} );
+  slopes = std::exchange( other.slopes, {} );
+  intercepts = std::exchange( other.intercepts, {} );
+  cells = std::exchange( other.cells, {} );
+  cellOffsets = std::exchange( other.cellOffsets, {} );
+  cellEdges = std::exchange( other.cellEdges, {} );
+  grid = std::exchange( other.grid, 0 );
+  cellLatitude = other.cellLatitude;
+  cellLongitude = other.cellLongitude;
+  storage = std::move( other.storage );
+  owned = other.owned;
+  other.storage = Storage{};
+  return *this;
+}
+
+void PreparedPolygon::bind()
+{
+  latitudes = storage.latitudes;
+  longitudes = storage.longitudes;
+  latitudeTo = storage.latitudeTo;
+  longitudeTo = storage.longitudeTo;
+  slopes = storage.slopes;
+  intercepts = storage.intercepts;
+  cells = storage.cells;
+  cellOffsets = storage.cellOffsets;
+  cellEdges = storage.cellEdges;
+}
+
+PreparedPolygon::PreparedPolygon( const Polygon& polygon, std::size_t gridSize )
+{
+  addRing( polygon, std::nullopt );
+  prepare( gridSize );
+}
+
+PreparedPolygon::PreparedPolygon( const PolygonWithHoles& polygon, std::size_t gridSize )
+{
+  addPart( polygon );
+  prepare( gridSize );
+}
+
+PreparedPolygon::PreparedPolygon( const MultiPolygon& polygon, std::size_t gridSize )
+{
+  for ( const auto& part : polygon ) addPart( part );
+  prepare( gridSize );
+}
+
+void PreparedPolygon::addPart( const PolygonWithHoles& polygon )
+{
+  const auto frame = addRing( polygon.outer, std::nullopt );
+  if ( frame.empty() ) return;
+  for ( const auto& hole : polygon.holes ) addRing( hole, frame );
+}
+
+spt::geocode::BoundingBox PreparedPolygon::addRing( const Polygon& ring, std::optional<BoundingBox> frame )
+{
+  auto bounds = BoundingBox{};
+
+  // geofence::isIn treats anything with fewer than 3 vertices as empty
+  if ( ring.size() < 3 ) return bounds;
+
+  // Unwrap the longitudes so that no edge spans more than 180 degrees.  A ring that crosses the antimeridian then
+  // extends beyond 180, and the query checks the point shifted by 360 as well.
+  auto lngs = std::vector<double>{};
+  lngs.reserve( ring.size() );
+  lngs.push_back( ring.front().longitude );
+  for ( std::size_t i = 1; i < ring.size(); ++i )
+  {
+    auto lng = ring[i].longitude;
+    while ( lng - lngs.back() > 180.0 ) lng -= 360.0;
+    while ( lng - lngs.back() < -180.0 ) lng += 360.0;
+    lngs.push_back( lng );
+  }
+
+  const auto [minLng, maxLng] = std::ranges::minmax( lngs );
+  auto shift = 0.0;
+  if ( frame )
+  {
+    // Holes are placed in the same frame as their outer ring.
+    const auto centre = ( minLng + maxLng ) / 2;
+    if ( centre < frame->minLongitude ) shift = 360.0;
+    else if ( centre > frame->maxLongitude ) shift = -360.0;
+  }
+  else if ( minLng < -180.0 ) shift = 360.0;
+
+  for ( std::size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++ )
+  {
+    const auto flat = ring[i].latitude;
+    const auto flng = lngs[i] + shift;
+    const auto tlat = ring[j].latitude;
+    const auto tlng = lngs[j] + shift;
+    bounds.extend( flat, flng );
+
+    storage.latitudes.push_back( flat );
+    storage.longitudes.push_back( flng );
+    storage.latitudeTo.push_back( tlat );
+    storage.longitudeTo.push_back( tlng );
+
+    // Edges parallel to the ray never satisfy the straddle test, so their slope is never used.
+    const auto dlon = tlng - flng;
+    const auto slope = dlon == 0.0 ? 0.0 : ( tlat - flat ) / dlon;
+    storage.slopes.push_back( slope );
+    storage.intercepts.push_back( flat - slope * flng );
+  }
+
+  box.extend( bounds.minLatitude, bounds.minLongitude );
+  box.extend( bounds.maxLatitude, bounds.maxLongitude );
+  return bounds;
+}
+
+void PreparedPolygon::prepare( std::size_t gridSize )
+{
+  bind();
+  if ( latitudes.empty() ) return;
+
+  padded = BoundingBox{
+    .minLatitude = box.minLatitude - tolerance,
+    .minLongitude = box.minLongitude - tolerance,
+    .maxLatitude = box.maxLatitude + tolerance,
+    .maxLongitude = box.maxLongitude + tolerance
+  };
+
+  buildGrid( gridSize );
+}
+
+void PreparedPolygon::buildGrid( std::size_t size )
+{
+  const auto height = box.maxLatitude - box.minLatitude;
+  const auto width = box.maxLongitude - box.minLongitude;
+  if ( size == 0 || latitudes.empty() || height <= 0.0 || width <= 0.0 ) return;
+
+  grid = size;
+  cellLatitude = height / static_cast<double>( size );
+  cellLongitude = width / static_cast<double>( size );
+
+  const auto cellBox = [this]( std::size_t row, std::size_t column )
+  {
+    // Padded so that points matching a vertex near a cell border always land in a boundary cell.
+    return BoundingBox{
+      .minLatitude = box.minLatitude + static_cast<double>( row ) * cellLatitude - tolerance,
+      .minLongitude = box.minLongitude + static_cast<double>( column ) * cellLongitude - tolerance,
+      .maxLatitude = box.minLatitude + static_cast<double>( row + 1 ) * cellLatitude + tolerance,
+      .maxLongitude = box.minLongitude + static_cast<double>( column + 1 ) * cellLongitude + tolerance
+    };
+  };
+
+  const auto cell = [size]( double value, double origin, double extent )
+  {
+    const auto index = std::floor( ( value - origin ) / extent );
+    return static_cast<std::size_t>( std::clamp( index, 0.0, static_cast<double>( size - 1 ) ) );
+  };
+
+  const auto forEachCell = [&]( std::size_t edge, auto&& fn )
+  {
+    const auto r0 = cell( std::min( latitudes[edge], latitudeTo[edge] ) - tolerance, box.minLatitude, cellLatitude );
+    const auto r1 = cell( std::max( latitudes[edge], latitudeTo[edge] ) + tolerance, box.minLatitude, cellLatitude );
+    const auto c0 = cell( std::min( longitudes[edge], longitudeTo[edge] ) - tolerance, box.minLongitude, cellLongitude );
+    const auto c1 = cell( std::max( longitudes[edge], longitudeTo[edge] ) + tolerance, box.minLongitude, cellLongitude );
+    for ( auto r = r0; r <= r1; ++r )
+    {
+      for ( auto c = c0; c <= c1; ++c )
+      {
+        if ( intersects( edge, cellBox( r, c ) ) ) fn( r * size + c );
+      }
+    }
+  };
+
+  auto& flags = storage.cells;
+  auto& offsets = storage.cellOffsets;
+  auto& edges = storage.cellEdges;
+
+  flags.assign( size * size, 0 );
+  offsets.assign( size * size + 1, 0 );
+  for ( std::size_t e = 0; e < latitudes.size(); ++e ) forEachCell( e, [&offsets]( std::size_t i ) { ++offsets[i + 1]; } );
+  for ( std::size_t i = 0; i < flags.size(); ++i ) offsets[i + 1] += offsets[i];
+
+  edges.resize( offsets.back() );
+  auto cursor = std::vector<std::uint32_t>{ offsets.begin(), offsets.end() - 1 };
+  for ( std::size_t e = 0; e < latitudes.size(); ++e )
+  {
+    forEachCell( e, [&edges, &cursor, e]( std::size_t i ) { edges[cursor[i]++] = static_cast<std::uint32_t>( e ); } );
+  }
+
+  for ( std::size_t r = 0; r < size; ++r )
+  {
+    for ( std::size_t c = 0; c < size; ++c )
+    {
+      const auto i = r * size + c;
+      const auto latitude = box.minLatitude + ( static_cast<double>( r ) + 0.5 ) * cellLatitude;
+      const auto longitude = box.minLongitude + ( static_cast<double>( c ) + 0.5 ) * cellLongitude;
+      flags[i] = static_cast<std::uint8_t>( scan( latitude, longitude ) ? 1 : 0 ) |
+        static_cast<std::uint8_t>( offsets[i + 1] > offsets[i] ? 2 : 0 );
+    }
+  }
+
+  bind();
+}
+
+bool PreparedPolygon::intersects( std::size_t edge, const BoundingBox& bounds ) const
+{
+  const auto alat = latitudes[edge];
+  const auto alng = longitudes[edge];
+  const auto blat = latitudeTo[edge];
+  const auto blng = longitudeTo[edge];
+
+  if ( std::max( alat, blat ) < bounds.minLatitude || std::min( alat, blat ) > bounds.maxLatitude ||
+      std::max( alng, blng ) < bounds.minLongitude || std::min( alng, blng ) > bounds.maxLongitude ) return false;
+
+  // The segment misses the box only if all four corners are strictly on the same side of its line.
+  const auto side = [&]( double lat, double lng ) { return ( blat - alat ) * ( lng - alng ) - ( blng - alng ) * ( lat - alat ); };
+  const auto s0 = side( bounds.minLatitude, bounds.minLongitude );
+  const auto s1 = side( bounds.minLatitude, bounds.maxLongitude );
+  const auto s2 = side( bounds.maxLatitude, bounds.minLongitude );
+  const auto s3 = side( bounds.maxLatitude, bounds.maxLongitude );
+  return !( ( s0 > 0 && s1 > 0 && s2 > 0 && s3 > 0 ) || ( s0 < 0 && s1 < 0 && s2 < 0 && s3 < 0 ) );
+}
+
+PreparedPolygon::Relation PreparedPolygon::relate( const BoundingBox& bounds ) const
+{
+  const auto relation = relateAt( bounds );
+  if ( relation == Relation::Partial || box.maxLongitude <= 180.0 ) return relation;
+
+  auto shifted = bounds;
+  shifted.minLongitude += 360.0;
+  shifted.maxLongitude += 360.0;
+  const auto other = relateAt( shifted );
+  if ( other == Relation::Partial ) return other;
+  return relation == Relation::Inside || other == Relation::Inside ? Relation::Inside : Relation::Disjoint;
+}
+
+PreparedPolygon::Relation PreparedPolygon::relateAt( const BoundingBox& bounds ) const
+{
+  if ( latitudes.empty() || !padded.intersects( bounds ) ) return Relation::Disjoint;
+
+  if ( cells.empty() )
+  {
+    for ( std::size_t e = 0; e < latitudes.size(); ++e )
+    {
+      if ( intersects( e, bounds ) ) return Relation::Partial;
+    }
+  }
+  else
+  {
+    // An edge that crosses the area does so within the box, in a grid cell that overlaps the area, and is listed
+    // against that cell.  Only the edges of the boundary cells that overlap the area need to be checked.
+    const auto index = [this]( double value, double origin, double extent )
+    {
+      const auto i = std::floor( ( value - origin ) / extent );
+      return static_cast<std::size_t>( std::clamp( i, 0.0, static_cast<double>( grid - 1 ) ) );
+    };
+
+    const auto r0 = index( bounds.minLatitude, box.minLatitude, cellLatitude );
+    const auto r1 = index( bounds.maxLatitude, box.minLatitude, cellLatitude );
+    const auto c0 = index( bounds.minLongitude, box.minLongitude, cellLongitude );
+    const auto c1 = index( bounds.maxLongitude, box.minLongitude, cellLongitude );
+    for ( auto r = r0; r <= r1; ++r )
+    {
+      for ( auto c = c0; c <= c1; ++c )
+      {
+        const auto i = r * grid + c;
+        if ( ( cells[i] & 2 ) == 0 ) continue;
+        for ( auto k = cellOffsets[i]; k < cellOffsets[i + 1]; ++k )
+        {
+          if ( intersects( cellEdges[k], bounds ) ) return Relation::Partial;
+        }
+      }
+    }
+  }
+
+  // No edge crosses the area, so every point in it has the same status as the centre.
+  return containsAt( ( bounds.minLatitude + bounds.maxLatitude ) / 2, ( bounds.minLongitude + bounds.maxLongitude ) / 2 ) ?
+    Relation::Inside : Relation::Disjoint;
+}
+
+bool PreparedPolygon::containsInCell( double latitude, double longitude ) const
+{
+  const auto index = [this]( double value, double origin, double extent )
+  {
+    const auto i = std::floor( ( value - origin ) / extent );
+    return static_cast<std::size_t>( std::clamp( i, 0.0, static_cast<double>( grid - 1 ) ) );
+  };
+
+  const auto row = index( latitude, box.minLatitude, cellLatitude );
+  const auto column = index( longitude, box.minLongitude, cellLongitude );
+  const auto i = row * grid + column;
+  const auto cell = cells[i];
+  if ( ( cell & 2 ) == 0 ) return ( cell & 1 ) != 0;
+
+  // Walk from the cell centre, whose status is known, to the point.  Each edge crossed flips the status, and
+  // only the edges that cross the cell can cross the segment.
+  const auto clat = box.minLatitude + ( static_cast<double>( row ) + 0.5 ) * cellLatitude;
+  const auto clng = box.minLongitude + ( static_cast<double>( column ) + 0.5 ) * cellLongitude;
+  const auto orient = []( double alat, double alng, double blat, double blng, double lat, double lng )
+  {
+    return ( blat - alat ) * ( lng - alng ) - ( blng - alng ) * ( lat - alat );
+  };
+
+  bool inside = ( cell & 1 ) != 0;
+  for ( auto k = cellOffsets[i]; k < cellOffsets[i + 1]; ++k )
+  {
+    const auto e = cellEdges[k];
+    if ( isVertex( e, latitude, longitude ) ) return true;
+
+    const auto d1 = orient( latitude, longitude, clat, clng, latitudes[e], longitudes[e] );
+    const auto d2 = orient( latitude, longitude, clat, clng, latitudeTo[e], longitudeTo[e] );
+    if ( ( d1 > 0 ) == ( d2 > 0 ) ) continue;
+
+    const auto d3 = orient( latitudes[e], longitudes[e], latitudeTo[e], longitudeTo[e], latitude, longitude );
+    const auto d4 = orient( latitudes[e], longitudes[e], latitudeTo[e], longitudeTo[e], clat, clng );
+    if ( ( d3 > 0 ) != ( d4 > 0 ) ) inside = !inside;
+  }
+  return inside;
+}
+
+void PreparedPolygon::contains( std::span<const double> lats, std::span<const double> lngs, std::span<std::uint8_t> out ) const
+{
+  const auto size = std::min( { lats.size(), lngs.size(), out.size() } );
+
+  // Most points resolve in constant time against the grid, which beats walking every edge for each block.
+  // Fences that cross the antimeridian need each point checked in two frames, which the scalar check handles.
+  if ( !cells.empty() || box.maxLongitude > 180.0 )
+  {
+    for ( std::size_t i = 0; i < size; ++i ) out[i] = static_cast<std::uint8_t>( contains( lats[i], lngs[i] ) );
+    return;
+  }
+
+  const auto edges = ppolygon::Edges{ .latitudes = latitudes.data(), .longitudes = longitudes.data(),
+    .from = longitudes.data(), .to = longitudeTo.data(), .slopes = slopes.data(), .intercepts = intercepts.data(),
+    .size = latitudes.size() };
+
+  auto index = std::array<std::size_t, blockSize>{};
+  auto lat = std::array<double, blockSize>{};
+  auto lng = std::array<double, blockSize>{};
+  auto winding = std::array<double, blockSize>{};
+  auto near = std::array<double, blockSize>{};
+
+  for ( std::size_t offset = 0; offset < size; offset += blockSize )
+  {
+    const auto count = std::min( blockSize, size - offset );
+
+    // Compact the points that pass the bounding box check, so the edge loops only run over candidates.
+    std::size_t candidates{ 0 };
+    for ( std::size_t i = 0; i < count; ++i )
+    {
+      out[offset + i] = 0;
+      if ( !padded.contains( lats[offset + i], lngs[offset + i] ) ) continue;
+      index[candidates] = offset + i;
+      lat[candidates] = lats[offset + i];
+      lng[candidates] = lngs[offset + i];
+      ++candidates;
+    }
+    if ( candidates == 0 ) continue;
+
+    std::fill_n( winding.begin(), candidates, 0.0 );
+    std::fill_n( near.begin(), candidates, 0.0 );
+
+    ppolygon::accumulate( edges, lat.data(), lng.data(), candidates, winding.data(), near.data() );
+
+    for ( std::size_t i = 0; i < candidates; ++i )
+    {
+      out[index[i]] = near[i] > 0.0 ?
+        static_cast<std::uint8_t>( contains( lat[i], lng[i] ) ) :
+        static_cast<std::uint8_t>( static_cast<std::int64_t>( winding[i] ) & 1 );
+    }
+  }
+}
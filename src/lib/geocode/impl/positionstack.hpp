@@ -0,0 +1,136 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "../client.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cpr/cpr.h>
+
+namespace spt::geocode::impl
+{
+  /**
+   * A bounded pool of *cpr::Session* handles.  Each session owns a curl handle, which keeps its connection open
+   * between requests.  Sessions are created on demand, and *acquire* blocks while all of them are in use.
+   *
+   * A session keeps the headers and body of its last request, and sends a GET with a body once a body has been
+   * set.  Sessions that have made a POST are therefore kept apart, and are never handed out for a GET.
+   */
+  class SessionPool
+  {
+  public:
+    /// The kind of request a session is acquired for.
+    enum class Method : std::uint8_t { Get, Post };
+
+    /// Exclusive use of a session, which is returned to the pool when the lease is destroyed.
+    class Lease
+    {
+    public:
+      Lease( SessionPool& pool, std::unique_ptr<cpr::Session> session, Method method ) :
+        pool{ &pool }, session{ std::move( session ) }, method{ method } {}
+      ~Lease() { if ( session ) pool->release( std::move( session ), method ); }
+
+      Lease( const Lease& ) = delete;
+      Lease& operator=( const Lease& ) = delete;
+      Lease( Lease&& ) noexcept = default;
+      Lease& operator=( Lease&& ) = delete;
+
+      cpr::Session& operator*() const { return *session; }
+      cpr::Session* operator->() const { return session.get(); }
+
+    private:
+      SessionPool* pool;
+      std::unique_ptr<cpr::Session> session;
+      Method method;
+    };
+
+    explicit SessionPool( const ClientOptions& options );
+
+    /**
+     * The pool used by the free *address* and *fromAddress* functions.  The pool is unbounded and sessions have no
+     * timeouts, so that the free functions keep the concurrency and behaviour of a plain request while reusing
+     * connections.
+     */
+    static SessionPool& shared();
+
+    /**
+     * Wait for a free session, creating one if the pool has not reached its size.  A GET is only given a session
+     * that has not made a POST.  If only such sessions are free, one of them is replaced by a new session.
+     * @param method The kind of request the session is for.
+     */
+    [[nodiscard]] Lease acquire( Method method = Method::Get );
+
+    /// The URL for the specified API endpoint.
+    [[nodiscard]] std::string url( std::string_view endpoint ) const;
+
+    /// The number of sessions created so far.
+    [[nodiscard]] std::size_t size() const;
+
+    /// The options the pool was created with.
+    [[nodiscard]] const ClientOptions& options() const { return opts; }
+
+  private:
+    void release( std::unique_ptr<cpr::Session> session, Method method );
+    [[nodiscard]] std::unique_ptr<cpr::Session> create() const;
+
+    mutable std::mutex mutex;
+    std::condition_variable available;
+    std::vector<std::unique_ptr<cpr::Session>> idle;
+    // Idle sessions that have made a POST.
+    std::vector<std::unique_ptr<cpr::Session>> posting;
+    ClientOptions opts;
+    std::size_t created{ 0 };
+  };
+
+  /// The error for a query that the API answered without any results.
+  inline constexpr std::string_view noResults{ "Empty response data" };
+
+  /**
+   * Look up the closest approximate address for the specified geo-location, using a session from the pool.
+   * @param pool The pool to take a session from.
+   * @param latitude The latitude for the geo-location.
+   * @param longitude The longitude for the geo-location.
+   * @param key The *positionstack* API key.
+   * @return The returned address or an error string if the lookup fails.
+   */
+  std::expected<Address, std::string> reverse( SessionPool& pool, double latitude, double longitude, const std::string& key );
+
+  /**
+   * Look up the geo-coordinates for the specified address, using a session from the pool.
+   * @param pool The pool to take a session from.
+   * @param address The text address to look up.
+   * @param key The *positionstack* API key.
+   * @return The geo-coordinates for the address or an error string if the lookup fails.
+   */
+  std::expected<Point, std::string> forward( SessionPool& pool, const std::string& address, const std::string& key );
+
+  /**
+   * Look up the closest approximate addresses for a set of geo-locations in a single batch request.
+   * @param pool The pool to take a session from.
+   * @param points The geo-locations, no more than the batch size the API allows.
+   * @param results The address or error for each point, in the same order as the points.
+   * @param key The *positionstack* API key.
+   */
+  void reverse( SessionPool& pool, std::span<const Point> points, std::span<std::expected<Address, std::string>> results,
+    const std::string& key );
+
+  /**
+   * Look up the geo-coordinates for a set of addresses in a single batch request.  Empty addresses are not sent.
+   * @param pool The pool to take a session from.
+   * @param addresses The text addresses, no more than the batch size the API allows.
+   * @param results The geo-coordinates or error for each address, in the same order as the addresses.
+   * @param key The *positionstack* API key.
+   */
+  void forward( SessionPool& pool, std::span<const std::string> addresses, std::span<std::expected<Point, std::string>> results,
+    const std::string& key );
+}
@@ -0,0 +1,204 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include "../shapes.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  namespace pshapes
+  {
+    using spt::geocode::impl::sphere::Vector;
+
+    // Relative width of the band around the radius in which the spherical distance is not decisive.  The geodesic
+    // distance on the ellipsoid differs from the spherical distance by less than 0.6%.
+    constexpr double band = 0.01;
+
+    // Padding in degrees so that points on the boundary are never rejected by a bounding box.
+    constexpr double padding = 1e-9;
+
+    // The longitude offset in degrees from a point at the specified latitude to points within the angular distance,
+    // or 180 if the cap around the point reaches a pole.
+    double longitudeSpan( double latitude, double angle )
+    {
+      const auto lat = std::abs( latitude );
+      if ( lat + spt::geocode::radiansToDegrees( angle ) >= 90.0 ) return 180.0;
+      const auto ratio = std::sin( angle ) / std::cos( spt::geocode::degreesToRadians( lat ) );
+      if ( ratio >= 1.0 ) return 180.0;
+      return std::min( 180.0, spt::geocode::radiansToDegrees( std::asin( ratio ) ) + padding );
+    }
+
+    // Extend the latitude range of a box with the points of greatest and least latitude on the arc from a to b,
+    // which lie between the end points when the arc bulges towards a pole.
+    void extendArc( spt::geocode::BoundingBox& box, const Vector& a, const Vector& b )
+    {
+      using spt::geocode::impl::sphere::cross;
+      using spt::geocode::impl::sphere::dot;
+      using spt::geocode::impl::sphere::norm;
+
+      const auto n = cross( a, b );
+      const auto length = norm( n );
+      if ( length < 1e-15 ) return;
+
+      for ( const auto pole : { 1.0, -1.0 } )
+      {
+        // The projection of the pole onto the plane of the great circle.
+        const auto along = pole * n.z / ( length * length );
+        auto v = Vector{ .x = -along * n.x, .y = -along * n.y, .z = pole - along * n.z };
+        const auto size = norm( v );
+        if ( size < 1e-15 ) continue;
+        v = Vector{ .x = v.x / size, .y = v.y / size, .z = v.z / size };
+        if ( dot( cross( a, v ), n ) >= 0.0 && dot( cross( v, b ), n ) >= 0.0 )
+        {
+          const auto latitude = spt::geocode::radiansToDegrees( std::asin( std::clamp( v.z, -1.0, 1.0 ) ) );
+          box.minLatitude = std::min( box.minLatitude, latitude );
+          box.maxLatitude = std::max( box.maxLatitude, latitude );
+        }
+      }
+    }
+  }
+}
+
+using spt::geocode::CircleFence;
+using spt::geocode::CorridorFence;
+
+CircleFence::CircleFence( const Point& centre, double radius ) :
+  origin{ centre }, vector{ impl::sphere::toVector( centre ) }, metres{ std::max( radius, 0.0 ) }
+{
+  const auto angle = metres / impl::sphere::radius;
+  const auto inner = metres > geodesicLimit ? angle : angle * ( 1.0 - pshapes::band );
+  const auto outer = std::min( metres > geodesicLimit ? angle : angle * ( 1.0 + pshapes::band ),
+    boost::math::constants::pi<double>() );
+  cosInner = std::cos( inner );
+  cosOuter = std::cos( outer );
+
+  latitudeSpan = radiansToDegrees( outer ) + pshapes::padding;
+  longitudeSpan = pshapes::longitudeSpan( centre.latitude, outer );
+
+  box.minLatitude = std::max( centre.latitude - latitudeSpan, -90.0 );
+  box.maxLatitude = std::min( centre.latitude + latitudeSpan, 90.0 );
+  if ( longitudeSpan >= 180.0 )
+  {
+    box.minLongitude = -180.0;
+    box.maxLongitude = 180.0;
+    return;
+  }
+
+  const auto longitude = std::remainder( centre.longitude, 360.0 );
+  const auto shift = longitude - longitudeSpan < -180.0 ? 360.0 : 0.0;
+  box.minLongitude = longitude - longitudeSpan + shift;
+  box.maxLongitude = longitude + longitudeSpan + shift;
+}
+
+bool CircleFence::contains( double latitude, double longitude ) const
+{
+  if ( std::abs( latitude - origin.latitude ) > latitudeSpan ) return false;
+  if ( longitudeSpan < 180.0 && std::abs( std::remainder( longitude - origin.longitude, 360.0 ) ) > longitudeSpan ) return false;
+
+  const auto cosine = impl::sphere::dot( vector, impl::sphere::toVector( latitude, longitude ) );
+  if ( cosine >= cosInner ) return true;
+  if ( cosine < cosOuter ) return false;
+  return spt::geocode::distance( origin, Point{ .latitude = latitude, .longitude = longitude } ).distance <= metres;
+}
+
+CorridorFence::CorridorFence( std::vector<Point> route, double width ) :
+  points{ std::move( route ) }, metres{ std::max( width, 0.0 ) }, angle{ metres / impl::sphere::radius }
+{
+  if ( points.empty() ) return;
+
+  vectors.reserve( points.size() );
+  for ( const auto& p : points ) vectors.push_back( impl::sphere::toVector( p ) );
+
+  // Unwrap so that consecutive vertices are never more than 180 degrees apart.
+  auto longitudes = std::vector<double>{};
+  longitudes.reserve( points.size() );
+  longitudes.push_back( std::remainder( points.front().longitude, 360.0 ) );
+  for ( std::size_t i = 1; i < points.size(); ++i )
+  {
+    longitudes.push_back( longitudes.back() + std::remainder( points[i].longitude - points[i - 1].longitude, 360.0 ) );
+  }
+
+  const auto latitudeSpan = radiansToDegrees( angle ) + pshapes::padding;
+  const auto count = std::max<std::size_t>( points.size() - 1, 1 );
+  auto extent = BoundingBox{};
+  boxes.reserve( count );
+  for ( std::size_t i = 0; i < count; ++i )
+  {
+    const auto j = std::min( i + 1, points.size() - 1 );
+    auto b = BoundingBox{};
+    b.extend( points[i].latitude, longitudes[i] );
+    b.extend( points[j].latitude, longitudes[j] );
+    pshapes::extendArc( b, vectors[i], vectors[j] );
+
+    const auto longitudeSpan = pshapes::longitudeSpan( std::max( std::abs( b.minLatitude ), std::abs( b.maxLatitude ) ), angle );
+    b.minLatitude = std::max( b.minLatitude - latitudeSpan, -90.0 );
+    b.maxLatitude = std::min( b.maxLatitude + latitudeSpan, 90.0 );
+    b.minLongitude -= longitudeSpan;
+    b.maxLongitude += longitudeSpan;
+
+    extent.extend( b.minLatitude, b.minLongitude );
+    extent.extend( b.maxLatitude, b.maxLongitude );
+    boxes.push_back( b );
+  }
+
+  if ( extent.minLongitude < -180.0 )
+  {
+    extent.minLongitude += 360.0;
+    extent.maxLongitude += 360.0;
+    for ( auto& b : boxes )
+    {
+      b.minLongitude += 360.0;
+      b.maxLongitude += 360.0;
+    }
+  }
+
+  grid.build( extent, boxes.size(), [this]( std::size_t i ) { return boxes[i]; } );
+}
+
+bool CorridorFence::contains( double latitude, double longitude ) const
+{
+  if ( boxes.empty() || latitude < grid.box.minLatitude || latitude > grid.box.maxLatitude ) return false;
+
+  // The unwrapped route may extend beyond [-180, 180], so try each equivalent longitude within the bounds.
+  const auto normalised = std::remainder( longitude, 360.0 );
+  const auto first = std::ceil( ( grid.box.minLongitude - normalised ) / 360.0 );
+  const auto last = std::floor( ( grid.box.maxLongitude - normalised ) / 360.0 );
+  if ( first > last ) return false;
+
+  const auto vector = impl::sphere::toVector( latitude, longitude );
+  for ( auto k = first; k <= last; ++k )
+  {
+    if ( containsAt( latitude, normalised + 360.0 * k, vector ) ) return true;
+  }
+  return false;
+}
+
+bool CorridorFence::containsAt( double latitude, double longitude, const impl::sphere::Vector& vector ) const
+{
+  auto found = false;
+  grid.visit( latitude, longitude, [&]( std::uint32_t i )
+  {
+    if ( found || !boxes[i].contains( latitude, longitude ) ) return;
+    const auto j = std::min<std::size_t>( i + 1, vectors.size() - 1 );
+    found = impl::sphere::segmentDistance( vector, vectors[i], vectors[j] ) <= angle;
+  } );
+  return found;
+}
+
+double CorridorFence::distance( double latitude, double longitude ) const
+{
+  if ( vectors.empty() ) return std::numeric_limits<double>::infinity();
+
+  const auto vector = impl::sphere::toVector( latitude, longitude );
+  auto result = std::numeric_limits<double>::infinity();
+  for ( std::size_t i = 0; i < boxes.size(); ++i )
+  {
+    const auto j = std::min( i + 1, vectors.size() - 1 );
+    result = std::min( result, impl::sphere::segmentDistance( vector, vectors[i], vectors[j] ) );
+  }
+  return result * impl::sphere::radius;
+}
@@ -0,0 +1,155 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include "../geocode.hpp"
+#include "parallel.hpp"
+
+#include <array>
+#include <cmath>
+
+namespace
+{
+  namespace pshorten
+  {
+    using spt::geocode::impl::olc::separator;
+    using spt::geocode::impl::olc::padding;
+    using spt::geocode::impl::olc::separatorPosition;
+
+    // Shorten only if the reference is within 0.3 of the resolution of the removed digits, rather than 0.5.
+    constexpr double safetyFactor = 0.3;
+
+    // Codes per thread when splitting large batches.
+    constexpr std::size_t grain = 1 << 12;
+
+    // The number of digits in a code, excluding the separator and stopping at any padding.
+    std::size_t digits( std::string_view code )
+    {
+      std::size_t count{ 0 };
+      for ( const auto c : code )
+      {
+        if ( c == padding ) break;
+        if ( c != separator ) ++count;
+      }
+      return count;
+    }
+
+    spt::geocode::FixedCode upper( std::string_view code )
+    {
+      auto chars = std::array<char, spt::geocode::FixedCode::capacity>{};
+      const auto size = std::min( code.size(), chars.size() );
+      for ( std::size_t i = 0; i < size; ++i )
+      {
+        const auto c = code[i];
+        chars[i] = c >= 'a' && c <= 'z' ? static_cast<char>( c - 'a' + 'A' ) : c;
+      }
+      return spt::geocode::FixedCode{ std::string_view{ chars.data(), size } };
+    }
+
+    template <typename S, typename F>
+    std::size_t apply( std::span<const S> codes, std::span<std::expected<spt::geocode::FixedCode, std::string>> out, F&& fn )
+    {
+      const auto size = std::min( codes.size(), out.size() );
+      spt::geocode::impl::parallelFor( size, grain, [&]( std::size_t begin, std::size_t end )
+      {
+        for ( auto i = begin; i < end; ++i ) out[i] = fn( std::string_view{ codes[i] } );
+      } );
+      return size;
+    }
+  }
+}
+
+using spt::geocode::LocationCodeReference;
+
+LocationCodeReference::LocationCodeReference( double latitude, double longitude ) :
+  latitude{ std::min( 90.0, std::max( -90.0, latitude ) ) }, longitude{ std::remainder( longitude, 360.0 ) }
+{
+  if ( this->longitude >= 180.0 ) this->longitude -= 360.0;
+  if ( this->latitude < 90.0 ) padding = FixedCode{ this->latitude, this->longitude };
+}
+
+std::expected<spt::geocode::FixedCode, std::string> LocationCodeReference::shorten( std::string_view code ) const
+{
+  using O = std::expected<FixedCode, std::string>;
+
+  auto area = impl::olc::Area{};
+  const auto kind = impl::olc::decode( code, area );
+  if ( kind == impl::CodeKind::Invalid ) return O{ std::unexpect, "Invalid code" };
+  if ( kind == impl::CodeKind::Short ) return O{ std::unexpect, "Only full codes can be shortened" };
+  if ( code.find( pshorten::padding ) != std::string_view::npos ) return FixedCode{ code };
+
+  const auto length = pshorten::digits( code );
+  const auto lat = impl::olc::adjustLatitude( latitude, length );
+  const auto range = std::max( std::abs( area.centreLatitude() - lat ), std::abs( area.centreLongitude() - longitude ) );
+  for ( const std::size_t removal : { 8, 6, 4 } )
+  {
+    // The reference implementation reduces 8 digit codes to a bare separator, which is not a valid code.
+    if ( removal >= length ) continue;
+    if ( range < impl::olc::precision( removal ) * pshorten::safetyFactor ) return FixedCode{ code.substr( removal ) };
+  }
+  return FixedCode{ code };
+}
+
+std::expected<spt::geocode::FixedCode, std::string> LocationCodeReference::recover( std::string_view code ) const
+{
+  using O = std::expected<FixedCode, std::string>;
+
+  auto area = impl::olc::Area{};
+  const auto kind = impl::olc::decode( code, area );
+  if ( kind == impl::CodeKind::Invalid ) return O{ std::unexpect, "Invalid code" };
+  if ( kind == impl::CodeKind::Full ) return pshorten::upper( code );
+
+  const auto length = pshorten::digits( code );
+  const auto lat = impl::olc::adjustLatitude( latitude, length );
+  const auto prefix = latitude < 90.0 ? padding : FixedCode{ lat, longitude };
+
+  // Prefix the short code with the leading digits of the reference, and decode the resulting full code.  Digits
+  // beyond the capacity do not affect the area.
+  const auto missing = pshorten::separatorPosition - code.find( pshorten::separator );
+  auto chars = std::array<char, FixedCode::capacity>{};
+  const auto size = std::min( chars.size(), missing + code.size() );
+  std::copy_n( prefix.data(), missing, chars.data() );
+  std::copy_n( code.data(), size - missing, chars.data() + missing );
+  impl::olc::decode( std::string_view{ chars.data(), size }, area );
+
+  // Move the area by one resolution towards the reference if it is more than half a resolution away, without
+  // going beyond a pole.
+  const auto resolution = impl::olc::precision( missing );
+  const auto half = resolution / 2.0;
+  auto centreLatitude = area.centreLatitude();
+  auto centreLongitude = area.centreLongitude();
+  if ( lat + half < centreLatitude && centreLatitude - resolution > -90.0 ) centreLatitude -= resolution;
+  else if ( lat - half > centreLatitude && centreLatitude + resolution < 90.0 ) centreLatitude += resolution;
+  if ( longitude + half < centreLongitude ) centreLongitude -= resolution;
+  else if ( longitude - half > centreLongitude ) centreLongitude += resolution;
+
+  return FixedCode{ centreLatitude, centreLongitude, length + missing };
+}
+
+std::size_t spt::geocode::shortenLocationCodes( const Point& reference, std::span<const std::string_view> codes,
+  std::span<std::expected<FixedCode, std::string>> out )
+{
+  const auto ref = LocationCodeReference{ reference };
+  return pshorten::apply( codes, out, [&ref]( std::string_view code ) { return ref.shorten( code ); } );
+}
+
+std::size_t spt::geocode::shortenLocationCodes( const Point& reference, std::span<const std::string> codes,
+  std::span<std::expected<FixedCode, std::string>> out )
+{
+  const auto ref = LocationCodeReference{ reference };
+  return pshorten::apply( codes, out, [&ref]( std::string_view code ) { return ref.shorten( code ); } );
+}
+
+std::size_t spt::geocode::recoverLocationCodes( const Point& reference, std::span<const std::string_view> codes,
+  std::span<std::expected<FixedCode, std::string>> out )
+{
+  const auto ref = LocationCodeReference{ reference };
+  return pshorten::apply( codes, out, [&ref]( std::string_view code ) { return ref.recover( code ); } );
+}
+
+std::size_t spt::geocode::recoverLocationCodes( const Point& reference, std::span<const std::string> codes,
+  std::span<std::expected<FixedCode, std::string>> out )
+{
+  const auto ref = LocationCodeReference{ reference };
+  return pshorten::apply( codes, out, [&ref]( std::string_view code ) { return ref.recover( code ); } );
+}
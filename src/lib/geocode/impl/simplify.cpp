@@ -0,0 +1,314 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include "../simplify.hpp"
+#include "grid.hpp"
+#include "parallel.hpp"
+#include "sphere.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+
+namespace
+{
+  namespace psimplify
+  {
+    using spt::geocode::impl::sphere::Vector;
+    using spt::geocode::impl::sphere::angle;
+    using spt::geocode::impl::sphere::cross;
+    using spt::geocode::impl::sphere::dot;
+    using spt::geocode::impl::sphere::segmentDistance;
+    using spt::geocode::impl::sphere::toVector;
+    using Grid = spt::geocode::impl::BoxGrid;
+
+    // Spherical excess of the triangle (area on the unit sphere), using the formula of Van Oosterom and Strackee.
+    double triangleArea( const Vector& a, const Vector& b, const Vector& c )
+    {
+      const auto numerator = std::abs( dot( a, cross( b, c ) ) );
+      const auto denominator = 1.0 + dot( a, b ) + dot( b, c ) + dot( c, a );
+      return 2.0 * std::atan2( numerator, denominator );
+    }
+
+    // Planar orientation in the latitude/longitude plane, which is the plane containment is tested in.
+    double orient( const spt::geocode::Point& a, const spt::geocode::Point& b, const spt::geocode::Point& c )
+    {
+      return ( b.latitude - a.latitude ) * ( c.longitude - a.longitude ) -
+        ( b.longitude - a.longitude ) * ( c.latitude - a.latitude );
+    }
+
+    bool onSegment( const spt::geocode::Point& a, const spt::geocode::Point& b, const spt::geocode::Point& p )
+    {
+      return std::min( a.latitude, b.latitude ) <= p.latitude && p.latitude <= std::max( a.latitude, b.latitude ) &&
+        std::min( a.longitude, b.longitude ) <= p.longitude && p.longitude <= std::max( a.longitude, b.longitude );
+    }
+
+    bool intersects( const spt::geocode::Point& a, const spt::geocode::Point& b,
+      const spt::geocode::Point& c, const spt::geocode::Point& d )
+    {
+      const auto o1 = orient( a, b, c );
+      const auto o2 = orient( a, b, d );
+      const auto o3 = orient( c, d, a );
+      const auto o4 = orient( c, d, b );
+      if ( ( ( o1 > 0 && o2 < 0 ) || ( o1 < 0 && o2 > 0 ) ) && ( ( o3 > 0 && o4 < 0 ) || ( o3 < 0 && o4 > 0 ) ) ) return true;
+      return ( o1 == 0 && onSegment( a, b, c ) ) || ( o2 == 0 && onSegment( a, b, d ) ) ||
+        ( o3 == 0 && onSegment( c, d, a ) ) || ( o4 == 0 && onSegment( c, d, b ) );
+    }
+
+    spt::geocode::BoundingBox bounds( const spt::geocode::Point& a, const spt::geocode::Point& b )
+    {
+      auto box = spt::geocode::BoundingBox{};
+      box.extend( a.latitude, a.longitude );
+      box.extend( b.latitude, b.longitude );
+      return box;
+    }
+
+    struct Ring
+    {
+      std::span<const spt::geocode::Point> points;
+      std::vector<Vector> vectors;
+      spt::geocode::BoundingBox box;
+
+      explicit Ring( std::span<const spt::geocode::Point> p ) : points{ p }
+      {
+        vectors.reserve( points.size() );
+        for ( const auto& point : points )
+        {
+          vectors.push_back( toVector( point ) );
+          box.extend( point.latitude, point.longitude );
+        }
+      }
+
+      [[nodiscard]] std::size_t size() const { return points.size(); }
+    };
+
+    /**
+     * Flag the segments of the simplified ring that cross another non-adjacent segment.  Segment s runs from
+     * kept[s] to kept[s + 1], wrapping around at the end.
+     */
+    std::vector<std::uint8_t> crossings( const Ring& ring, const std::vector<std::size_t>& kept )
+    {
+      const auto m = kept.size();
+      auto flags = std::vector<std::uint8_t>( m, 0 );
+      if ( m < 4 ) return flags;
+
+      const auto start = [&]( std::size_t s ) -> const spt::geocode::Point& { return ring.points[kept[s]]; };
+      const auto end = [&]( std::size_t s ) -> const spt::geocode::Point& { return ring.points[kept[( s + 1 ) % m]]; };
+
+      auto grid = Grid{};
+      grid.build( ring.box, m, [&]( std::size_t s ) { return bounds( start( s ), end( s ) ); } );
+
+      for ( std::size_t s = 0; s < m; ++s )
+      {
+        grid.visit( bounds( start( s ), end( s ) ), [&]( std::uint32_t t )
+        {
+          if ( t <= s || t == s + 1 || ( s == 0 && t == m - 1 ) ) return;
+          if ( flags[s] && flags[t] ) return;
+          if ( intersects( start( s ), end( s ), start( t ), end( t ) ) ) flags[s] = flags[t] = 1;
+        } );
+      }
+      return flags;
+    }
+
+    // The vertex strictly between i and j (indices modulo the ring size) furthest from the arc between them.
+    std::pair<std::size_t, double> farthest( const Ring& ring, std::size_t i, std::size_t j )
+    {
+      const auto n = ring.size();
+      const auto& a = ring.vectors[i % n];
+      const auto& b = ring.vectors[j % n];
+      auto result = std::pair<std::size_t, double>{ i, -1.0 };
+      for ( auto k = i + 1; k < j; ++k )
+      {
+        const auto d = segmentDistance( ring.vectors[k % n], a, b );
+        if ( d > result.second ) result = { k, d };
+      }
+      return result;
+    }
+
+    std::vector<std::size_t> keptIndices( const std::vector<std::uint8_t>& keep )
+    {
+      auto kept = std::vector<std::size_t>{};
+      for ( std::size_t i = 0; i < keep.size(); ++i ) if ( keep[i] ) kept.push_back( i );
+      return kept;
+    }
+
+    std::vector<std::size_t> douglasPeucker( const Ring& ring, double tolerance, bool preserveTopology )
+    {
+      const auto n = ring.size();
+      auto keep = std::vector<std::uint8_t>( n, 0 );
+
+      // Split the ring into two chains at the vertex furthest from the first.
+      std::size_t split{ 1 };
+      for ( std::size_t k = 2; k < n; ++k )
+      {
+        if ( angle( ring.vectors[k], ring.vectors[0] ) > angle( ring.vectors[split], ring.vectors[0] ) ) split = k;
+      }
+      keep[0] = keep[split] = 1;
+
+      auto stack = std::vector<std::pair<std::size_t, std::size_t>>{ { 0, split }, { split, n } };
+      while ( !stack.empty() )
+      {
+        const auto [i, j] = stack.back();
+        stack.pop_back();
+        if ( j - i < 2 ) continue;
+
+        const auto [k, d] = farthest( ring, i, j );
+        if ( d <= tolerance ) continue;
+        keep[k % n] = 1;
+        stack.emplace_back( i, k );
+        stack.emplace_back( k, j );
+      }
+
+      // A ring needs at least 3 vertices.  Add the vertex furthest from either chord.
+      if ( std::ranges::count( keep, 1 ) < 3 )
+      {
+        const auto a = farthest( ring, 0, split );
+        const auto b = farthest( ring, split, n );
+        keep[( a.second >= b.second ? a.first : b.first ) % n] = 1;
+      }
+
+      if ( !preserveTopology ) return keptIndices( keep );
+
+      // Split segments that cross another segment at their furthest vertex, until none cross.  Segments that are
+      // edges of the input ring cannot be split, and crossings between them are left as is.
+      while ( true )
+      {
+        const auto kept = keptIndices( keep );
+        const auto flags = crossings( ring, kept );
+
+        bool added{ false };
+        for ( std::size_t s = 0; s < kept.size(); ++s )
+        {
+          if ( !flags[s] ) continue;
+          const auto i = kept[s];
+          const auto j = s + 1 < kept.size() ? kept[s + 1] : kept.front() + n;
+          if ( j - i < 2 ) continue;
+          keep[farthest( ring, i, j ).first % n] = 1;
+          added = true;
+        }
+        if ( !added ) return kept;
+      }
+    }
+
+    std::vector<std::size_t> visvalingamWhyatt( const Ring& ring, double threshold, bool preserveTopology )
+    {
+      const auto n = ring.size();
+      auto prev = std::vector<std::size_t>( n );
+      auto next = std::vector<std::size_t>( n );
+      auto version = std::vector<std::uint32_t>( n, 0 );
+      auto alive = std::vector<std::uint8_t>( n, 1 );
+      for ( std::size_t i = 0; i < n; ++i )
+      {
+        prev[i] = ( i + n - 1 ) % n;
+        next[i] = ( i + 1 ) % n;
+      }
+
+      struct Entry
+      {
+        double area;
+        std::size_t index;
+        std::uint32_t version;
+        bool operator>( const Entry& other ) const { return area > other.area; }
+      };
+
+      const auto area = [&]( std::size_t i )
+      {
+        return triangleArea( ring.vectors[prev[i]], ring.vectors[i], ring.vectors[next[i]] );
+      };
+
+      auto heap = std::priority_queue<Entry, std::vector<Entry>, std::greater<>>{};
+      for ( std::size_t i = 0; i < n; ++i ) heap.push( Entry{ .area = area( i ), .index = i, .version = 0 } );
+
+      auto grid = Grid{};
+      if ( preserveTopology )
+      {
+        grid.build( ring.box, n, [&ring]( std::size_t i ) { return bounds( ring.points[i], ring.points[i] ); } );
+      }
+
+      // Removing i replaces edges prev-i and i-next with prev-next.  For a simple ring, the new edge can only cross
+      // an existing edge if some other remaining vertex lies within the triangle.
+      const auto blocked = [&]( std::size_t i )
+      {
+        const auto& a = ring.points[prev[i]];
+        const auto& b = ring.points[i];
+        const auto& c = ring.points[next[i]];
+        auto box = bounds( a, c );
+        box.extend( b.latitude, b.longitude );
+        const auto sign = orient( a, b, c );
+
+        bool inside{ false };
+        grid.visit( box, [&]( std::uint32_t k )
+        {
+          if ( inside || !alive[k] || k == i || k == prev[i] || k == next[i] ) return;
+          const auto& p = ring.points[k];
+          const auto o1 = orient( a, b, p ) * sign;
+          const auto o2 = orient( b, c, p ) * sign;
+          const auto o3 = orient( c, a, p ) * sign;
+          if ( o1 >= 0 && o2 >= 0 && o3 >= 0 ) inside = true;
+        } );
+        return inside;
+      };
+
+      auto remaining = n;
+      while ( remaining > 3 && !heap.empty() )
+      {
+        const auto top = heap.top();
+        heap.pop();
+        if ( !alive[top.index] || top.version != version[top.index] ) continue;
+        if ( top.area >= threshold ) break;
+        if ( preserveTopology && blocked( top.index ) ) continue;
+
+        const auto i = top.index;
+        alive[i] = 0;
+        --remaining;
+        next[prev[i]] = next[i];
+        prev[next[i]] = prev[i];
+
+        // Neighbours never drop below the area of the vertex just removed, so vertices are removed in order of
+        // their effective area.
+        for ( const auto k : { prev[i], next[i] } )
+        {
+          heap.push( Entry{ .area = std::max( area( k ), top.area ), .index = k, .version = ++version[k] } );
+        }
+      }
+
+      auto kept = std::vector<std::size_t>{};
+      kept.reserve( remaining );
+      for ( std::size_t i = 0; i < n; ++i ) if ( alive[i] ) kept.push_back( i );
+      return kept;
+    }
+  }
+}
+
+spt::geocode::Polygon spt::geocode::simplify( const Polygon& polygon, const SimplifyOptions& options )
+{
+  auto points = std::span<const Point>{ polygon };
+  const auto closed = points.size() > 1 && points.front().latitude == points.back().latitude &&
+    points.front().longitude == points.back().longitude;
+  if ( closed ) points = points.first( points.size() - 1 );
+  if ( points.size() < 4 || options.tolerance <= 0.0 ) return polygon;
+
+  const auto ring = psimplify::Ring{ points };
+  const auto tolerance = options.tolerance / spt::geocode::impl::sphere::radius;
+  const auto kept = options.method == SimplifyMethod::DouglasPeucker ?
+    psimplify::douglasPeucker( ring, tolerance, options.preserveTopology ) :
+    psimplify::visvalingamWhyatt( ring, tolerance * tolerance, options.preserveTopology );
+
+  auto result = Polygon{};
+  result.reserve( kept.size() + 1 );
+  for ( const auto i : kept ) result.push_back( points[i] );
+  if ( closed ) result.push_back( result.front() );
+  return result;
+}
+
+std::vector<spt::geocode::Polygon> spt::geocode::simplify( std::span<const Polygon> polygons, const SimplifyOptions& options )
+{
+  auto result = std::vector<Polygon>( polygons.size() );
+  impl::parallelFor( polygons.size(), 16, [&]( std::size_t begin, std::size_t end )
+  {
+    for ( auto i = begin; i < end; ++i ) result[i] = simplify( polygons[i], options );
+  } );
+  return result;
+}
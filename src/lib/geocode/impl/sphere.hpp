@@ -0,0 +1,61 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "../geocode.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace spt::geocode::impl::sphere
+{
+  /// Mean radius of the earth in metres.
+  constexpr double radius = 6371008.8;
+
+  /// A point on the unit sphere.
+  struct Vector
+  {
+    double x{ 0.0 };
+    double y{ 0.0 };
+    double z{ 0.0 };
+  };
+
+  inline Vector toVector( double latitude, double longitude )
+  {
+    const auto lat = degreesToRadians( latitude );
+    const auto lng = degreesToRadians( longitude );
+    return Vector{ .x = std::cos( lat ) * std::cos( lng ), .y = std::cos( lat ) * std::sin( lng ), .z = std::sin( lat ) };
+  }
+
+  inline Vector toVector( const Point& point ) { return toVector( point.latitude, point.longitude ); }
+
+  inline double dot( const Vector& a, const Vector& b ) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+  inline Vector cross( const Vector& a, const Vector& b )
+  {
+    return Vector{ .x = a.y * b.z - a.z * b.y, .y = a.z * b.x - a.x * b.z, .z = a.x * b.y - a.y * b.x };
+  }
+
+  inline double norm( const Vector& a ) { return std::sqrt( dot( a, a ) ); }
+
+  // Angle between two unit vectors, accurate for small angles.
+  inline double angle( const Vector& a, const Vector& b ) { return std::atan2( norm( cross( a, b ) ), dot( a, b ) ); }
+
+  // Angular distance from p to the great circle arc from a to b.
+  inline double segmentDistance( const Vector& p, const Vector& a, const Vector& b )
+  {
+    auto n = cross( a, b );
+    const auto length = norm( n );
+    if ( length < 1e-15 ) return angle( p, a );
+    n = Vector{ .x = n.x / length, .y = n.y / length, .z = n.z / length };
+
+    // The cross-track distance applies only if p projects onto the arc, otherwise the nearest end point is closest.
+    if ( dot( cross( a, p ), n ) >= 0.0 && dot( cross( p, b ), n ) >= 0.0 )
+    {
+      return std::abs( std::asin( std::clamp( dot( p, n ), -1.0, 1.0 ) ) );
+    }
+    return std::min( angle( p, a ), angle( p, b ) );
+  }
+}
@@ -0,0 +1,89 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spt::geocode::impl
+{
+  /**
+   * A fixed number of worker threads that run queued tasks in order.  The workers are started by the first
+   * *submit*, so a queue that is never used costs nothing.  Tasks still queued when the queue is destroyed are run
+   * before the workers exit, so that every future is satisfied and every awaiting coroutine is resumed.
+   */
+  class WorkQueue
+  {
+  public:
+    /// Create a queue that runs up to `workers` tasks at the same time.
+    explicit WorkQueue( std::size_t workers ) : size{ workers > 0 ? workers : 1 } {}
+
+    ~WorkQueue()
+    {
+      {
+        auto lock = std::lock_guard{ mutex };
+        stopping = true;
+      }
+      available.notify_all();
+      for ( auto& thread : threads ) thread.join();
+    }
+
+    WorkQueue( const WorkQueue& ) = delete;
+    WorkQueue& operator=( const WorkQueue& ) = delete;
+
+    /// Queue a task to run on one of the workers.
+    void submit( std::move_only_function<void()> task )
+    {
+      {
+        auto lock = std::lock_guard{ mutex };
+        tasks.push_back( std::move( task ) );
+        if ( threads.empty() )
+        {
+          threads.reserve( size );
+          for ( std::size_t i = 0; i < size; ++i ) threads.emplace_back( [this] { run(); } );
+        }
+      }
+      available.notify_one();
+    }
+
+    /// The number of tasks that may run at the same time.
+    [[nodiscard]] std::size_t workers() const { return size; }
+
+    /// The number of tasks waiting for a worker.
+    [[nodiscard]] std::size_t pending() const
+    {
+      auto lock = std::lock_guard{ mutex };
+      return tasks.size();
+    }
+
+  private:
+    void run()
+    {
+      while ( true )
+      {
+        auto lock = std::unique_lock{ mutex };
+        available.wait( lock, [this] { return stopping || !tasks.empty(); } );
+        if ( tasks.empty() ) return;
+
+        auto task = std::move( tasks.front() );
+        tasks.pop_front();
+        lock.unlock();
+        task();
+      }
+    }
+
+    mutable std::mutex mutex;
+    std::condition_variable available;
+    std::deque<std::move_only_function<void()>> tasks;
+    std::vector<std::thread> threads;
+    std::size_t size;
+    bool stopping{ false };
+  };
+}
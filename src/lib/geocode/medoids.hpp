@@ -0,0 +1,467 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "geocode.hpp"
+#include "impl/parallel.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+
+namespace spt::geocode
+{
+  /**
+   * Tuning options for the k-medoids clustering engine.
+   */
+  struct MedoidsOptions
+  {
+    /// Maximum number of full passes over the swap candidates.
+    std::size_t maxIterations{ 100 };
+    /// Inputs larger than this are clustered using CLARA sampling instead of a full distance matrix.
+    std::size_t claraThreshold{ 2048 };
+    /// Number of CLARA samples to evaluate.  The best set of medoids over all the samples is retained.
+    std::size_t samples{ 5 };
+    /// Size of each CLARA sample.  Defaults to `80 + 4k` if not specified.
+    std::size_t sampleSize{ 0 };
+    /// Seed for the random number generator.  A random seed is used if not specified.
+    std::uint32_t seed{ 0 };
+  };
+
+  namespace impl
+  {
+    /**
+     * Symmetric dissimilarity matrix of geodesic distances, computed once and shared by all the swap evaluations.
+     */
+    struct DistanceMatrix
+    {
+      template <LatLng P>
+      DistanceMatrix( const std::vector<P>& points, std::span<const std::size_t> indices ) :
+        n{ indices.size() }, values( indices.size() * indices.size(), 0.0 )
+      {
+        const auto row = [&points, &indices, this]( std::size_t i )
+        {
+          for ( auto j = i + 1; j < n; ++j )
+          {
+            // Vincenty does not converge for coincident points.
+            auto d = distance( points[indices[i]], points[indices[j]] ).distance;
+            if ( std::isnan( d ) ) d = 0.0;
+            values[i * n + j] = d;
+            values[j * n + i] = d;
+          }
+        };
+
+        // Rows i and n - 1 - i are paired so that each unit of work evaluates the same number of pairs.
+        parallelFor( ( n + 1 ) / 2, 16, [&row, this]( std::size_t begin, std::size_t end )
+        {
+          for ( auto i = begin; i < end; ++i )
+          {
+            row( i );
+            if ( n - 1 - i != i ) row( n - 1 - i );
+          }
+        } );
+      }
+
+      [[nodiscard]] double operator()( std::size_t i, std::size_t j ) const { return values[i * n + j]; }
+
+      std::size_t n;
+      std::vector<double> values;
+    };
+
+    /**
+     * Draw `k` distinct indices from `[0, n)` using a partial Fisher-Yates shuffle.
+     */
+    inline std::vector<std::size_t> sampleIndices( std::size_t n, std::size_t k, std::mt19937& rng )
+    {
+      auto indices = std::vector<std::size_t>( n );
+      std::iota( indices.begin(), indices.end(), std::size_t{ 0 } );
+      k = std::min( k, n );
+      for ( std::size_t i = 0; i < k; ++i )
+      {
+        auto dist = std::uniform_int_distribution<std::size_t>{ i, n - 1 };
+        std::swap( indices[i], indices[dist( rng )] );
+      }
+      indices.resize( k );
+      return indices;
+    }
+
+    /**
+     * Cache of the points as unit vectors on the sphere.  The nearest medoid to a point is the one with the largest
+     * dot product, which avoids the iterative Vincenty computation when sweeping the full input.
+     */
+    struct UnitVectors
+    {
+      template <LatLng P>
+      explicit UnitVectors( const std::vector<P>& points ) :
+        x( points.size() ), y( points.size() ), z( points.size() )
+      {
+        parallelFor( points.size(), 4096, [&points, this]( std::size_t begin, std::size_t end )
+        {
+          for ( auto i = begin; i < end; ++i )
+          {
+            const auto lat = degreesToRadians( points[i].latitude );
+            const auto lon = degreesToRadians( points[i].longitude );
+            x[i] = std::cos( lat ) * std::cos( lon );
+            y[i] = std::cos( lat ) * std::sin( lon );
+            z[i] = std::sin( lat );
+          }
+        } );
+      }
+
+      [[nodiscard]] double dot( std::size_t i, std::size_t j ) const { return x[i] * x[j] + y[i] * y[j] + z[i] * z[j]; }
+
+      std::vector<double> x;
+      std::vector<double> y;
+      std::vector<double> z;
+    };
+
+    /**
+     * Nearest and second-nearest medoid cache used by FasterPAM.
+     */
+    struct MedoidAssignment
+    {
+      explicit MedoidAssignment( std::size_t n ) :
+        nearest( n, 0 ), second( n, 0 ), dnearest( n, 0.0 ), dsecond( n, 0.0 ) {}
+
+      std::vector<std::size_t> nearest;
+      std::vector<std::size_t> second;
+      std::vector<double> dnearest;
+      std::vector<double> dsecond;
+    };
+
+    inline void assign( const DistanceMatrix& dist, std::span<const std::size_t> medoids, MedoidAssignment& assignment )
+    {
+      // Finite stand-in for the second nearest distance when there is only one medoid.  It cancels out of the
+      // swap deltas, but must exceed any geodesic distance.
+      constexpr auto unreachable = 1e8;
+
+      for ( std::size_t o = 0; o < dist.n; ++o )
+      {
+        auto dn = unreachable;
+        auto ds = unreachable;
+        std::size_t n{ 0 };
+        std::size_t s{ 0 };
+        for ( std::size_t i = 0; i < medoids.size(); ++i )
+        {
+          if ( const auto d = dist( o, medoids[i] ); d < dn )
+          {
+            ds = dn;
+            s = n;
+            dn = d;
+            n = i;
+          }
+          else if ( d < ds )
+          {
+            ds = d;
+            s = i;
+          }
+        }
+
+        assignment.nearest[o] = n;
+        assignment.dnearest[o] = dn;
+        assignment.second[o] = s;
+        assignment.dsecond[o] = ds;
+      }
+    }
+
+    /**
+     * Update the nearest and second nearest medoids after the medoid in `slot` has been replaced.  Only the points
+     * whose nearest or second nearest medoid was replaced need to be compared against every medoid.
+     */
+    inline void update( const DistanceMatrix& dist, std::span<const std::size_t> medoids, std::size_t slot,
+      MedoidAssignment& assignment )
+    {
+      constexpr auto unreachable = 1e8;
+
+      parallelFor( dist.n, 1024, [&]( std::size_t begin, std::size_t end )
+      {
+        for ( auto o = begin; o < end; ++o )
+        {
+          if ( assignment.nearest[o] == slot || assignment.second[o] == slot )
+          {
+            auto dn = unreachable;
+            auto ds = unreachable;
+            std::size_t n{ 0 };
+            std::size_t s{ 0 };
+            for ( std::size_t i = 0; i < medoids.size(); ++i )
+            {
+              if ( const auto d = dist( o, medoids[i] ); d < dn )
+              {
+                ds = dn;
+                s = n;
+                dn = d;
+                n = i;
+              }
+              else if ( d < ds )
+              {
+                ds = d;
+                s = i;
+              }
+            }
+
+            assignment.nearest[o] = n;
+            assignment.dnearest[o] = dn;
+            assignment.second[o] = s;
+            assignment.dsecond[o] = ds;
+          }
+          else if ( const auto d = dist( o, medoids[slot] ); d < assignment.dnearest[o] )
+          {
+            assignment.second[o] = assignment.nearest[o];
+            assignment.dsecond[o] = assignment.dnearest[o];
+            assignment.nearest[o] = slot;
+            assignment.dnearest[o] = d;
+          }
+          else if ( d < assignment.dsecond[o] )
+          {
+            assignment.second[o] = slot;
+            assignment.dsecond[o] = d;
+          }
+        }
+      } );
+    }
+
+    inline void removalLoss( const MedoidAssignment& assignment, std::vector<double>& loss )
+    {
+      std::ranges::fill( loss, 0.0 );
+      for ( std::size_t o = 0; o < assignment.nearest.size(); ++o )
+      {
+        loss[assignment.nearest[o]] += assignment.dsecond[o] - assignment.dnearest[o];
+      }
+    }
+
+    /// Swap candidates handed to a thread at a time.  Each candidate is an O(n) evaluation, so one is enough work.
+    constexpr std::size_t swapGrain{ 1 };
+
+    /// Number of batches the swap candidates are split into for each pass.
+    constexpr std::size_t swapBatches{ 8 };
+
+    /// Number of swap candidates evaluated together for *n* points and *k* medoids.
+    [[nodiscard]] constexpr std::size_t swapBatch( std::size_t n, std::size_t k )
+    {
+      return std::max<std::size_t>( 1, ( n - std::min( n, k ) + swapBatches - 1 ) / swapBatches );
+    }
+
+    /**
+     * FasterPAM (Schubert & Rousseeuw, 2021) swap search over a precomputed distance matrix.  The non-medoid
+     * candidates are split into *swapBatches* batches, sized from the number of points so that each batch has
+     * enough candidates to spread over all the threads.  The O(n) swap deltas of the candidates in a batch are
+     * evaluated in parallel, and the best improving swap in the batch is applied eagerly.  The nearest and second
+     * nearest medoids are then updated incrementally.
+     * @param initial The matrix indices of the starting medoids.  Random medoids are chosen if this is empty.
+     * @return The matrix indices of the selected medoids.
+     */
+    inline std::vector<std::size_t> fasterPam( const DistanceMatrix& dist, std::size_t k,
+      std::size_t maxIterations, std::mt19937& rng, std::span<const std::size_t> initial = {} )
+    {
+      const auto n = dist.n;
+      auto medoids = std::vector<std::size_t>{ initial.begin(), initial.end() };
+      if ( medoids.size() != k )
+      {
+        medoids = sampleIndices( n, k, rng );
+      }
+      if ( k >= n ) return medoids;
+
+      auto isMedoid = std::vector<bool>( n, false );
+      for ( const auto m : medoids ) isMedoid[m] = true;
+
+      auto assignment = MedoidAssignment{ n };
+      assign( dist, medoids, assignment );
+      auto loss = std::vector<double>( k, 0.0 );
+      removalLoss( assignment, loss );
+
+      struct Swap
+      {
+        double delta{ 0.0 };
+        std::size_t candidate{ 0 };
+        std::size_t slot{ 0 };
+      };
+
+      auto candidates = std::vector<std::size_t>{};
+      candidates.reserve( n - k );
+      for ( std::size_t xc = 0; xc < n; ++xc ) if ( !isMedoid[xc] ) candidates.push_back( xc );
+      const auto batch = swapBatch( n, k );
+      auto swaps = std::vector<Swap>( batch );
+
+      for ( std::size_t iteration = 0; iteration < maxIterations; ++iteration )
+      {
+        auto swapped = false;
+        for ( std::size_t first = 0; first < candidates.size(); first += batch )
+        {
+          const auto count = std::min( batch, candidates.size() - first );
+          parallelFor( count, swapGrain, [&]( std::size_t begin, std::size_t end )
+          {
+            auto delta = std::vector<double>( k, 0.0 );
+            for ( auto b = begin; b < end; ++b )
+            {
+              const auto xc = candidates[first + b];
+              std::ranges::copy( loss, delta.begin() );
+              auto shared = 0.0;
+              for ( std::size_t o = 0; o < n; ++o )
+              {
+                const auto doj = dist( o, xc );
+                if ( doj < assignment.dnearest[o] )
+                {
+                  shared += doj - assignment.dnearest[o];
+                  delta[assignment.nearest[o]] += assignment.dnearest[o] - assignment.dsecond[o];
+                }
+                else if ( doj < assignment.dsecond[o] )
+                {
+                  delta[assignment.nearest[o]] += doj - assignment.dsecond[o];
+                }
+              }
+
+              const auto best = std::ranges::min_element( delta );
+              swaps[b] = Swap{ .delta = *best + shared, .candidate = first + b, .slot = static_cast<std::size_t>( best - delta.begin() ) };
+            }
+          } );
+
+          const auto best = std::ranges::min_element( swaps.begin(), swaps.begin() + count, {}, &Swap::delta );
+          if ( best->delta >= -1e-9 ) continue;
+
+          // The replaced medoid takes the place of the candidate in the list of candidates.
+          const auto xc = candidates[best->candidate];
+          candidates[best->candidate] = medoids[best->slot];
+          medoids[best->slot] = xc;
+          update( dist, medoids, best->slot, assignment );
+          removalLoss( assignment, loss );
+          swapped = true;
+        }
+
+        if ( !swapped ) break;
+      }
+
+      return medoids;
+    }
+  }
+
+  /**
+   * Apply the k-medoids clustering algorithm to cluster the set of coordinates around representative members of
+   * the input, as opposed to the synthetic centroids computed by *cluster*.  The swap search uses FasterPAM over a
+   * cached matrix of geodesic distances.  Large inputs (more than `options.claraThreshold` points) are clustered
+   * using CLARA: FasterPAM is run on random samples and the medoids that minimise the total deviation over the full
+   * input are retained.  The full input is swept using cached unit vectors on the sphere, and the Vincenty distances
+   * are only computed once for the final assignment.
+   * @tparam P A type that represents a geo-coordinate that conforms to the *LatLng* concept.
+   * @param points The geo-coordinates that are to be clustered.
+   * @param numClusters The number of clusters to aggregate the coordinates into.
+   * @param options Tuning options for the algorithm.
+   * @return A vector of the clustered coordinates.  The *centroid* of each cluster is a copy of its medoid.  The
+   *   vector is sorted in descending order of density around the medoids.
+   */
+  template <LatLng P>
+  std::vector<Cluster<P>> medoids( const std::vector<P>& points, int numClusters, const MedoidsOptions& options = {} )
+  {
+    if ( points.empty() || numClusters < 1 ) return {};
+
+    const auto n = points.size();
+    const auto k = std::min( n, static_cast<std::size_t>( numClusters ) );
+    auto rng = std::mt19937{ options.seed == 0 ? std::random_device{}() : options.seed };
+
+    auto selected = std::vector<std::size_t>{};
+    auto nearest = std::vector<std::size_t>( n, 0 );
+    auto minDist = std::vector<double>( n, 0.0 );
+
+    if ( n <= options.claraThreshold )
+    {
+      auto indices = std::vector<std::size_t>( n );
+      std::iota( indices.begin(), indices.end(), std::size_t{ 0 } );
+      const auto dist = impl::DistanceMatrix{ points, indices };
+      selected = impl::fasterPam( dist, k, options.maxIterations, rng );
+
+      auto assignment = impl::MedoidAssignment{ n };
+      impl::assign( dist, selected, assignment );
+      nearest = std::move( assignment.nearest );
+      minDist = std::move( assignment.dnearest );
+    }
+    else
+    {
+      const auto sampleSize = std::min( n, std::max( options.sampleSize == 0 ? 80 + 4 * k : options.sampleSize, 2 * k ) );
+      const auto vectors = impl::UnitVectors{ points };
+      auto bestCost = std::numeric_limits<double>::max();
+      auto cnearest = std::vector<std::size_t>( n, 0 );
+      auto cangle = std::vector<double>( n, 0.0 );
+
+      for ( std::size_t s = 0; s < std::max<std::size_t>( 1, options.samples ); ++s )
+      {
+        // Seed each sample with the best medoids found so far, so that later samples can only improve on them.
+        auto sample = selected;
+        for ( const auto i : impl::sampleIndices( n, sampleSize, rng ) )
+        {
+          if ( sample.size() >= sampleSize ) break;
+          if ( std::ranges::find( selected, i ) == selected.end() ) sample.push_back( i );
+        }
+
+        auto initial = std::vector<std::size_t>( selected.size() );
+        std::iota( initial.begin(), initial.end(), std::size_t{ 0 } );
+
+        const auto dist = impl::DistanceMatrix{ points, sample };
+        auto candidates = impl::fasterPam( dist, k, options.maxIterations, rng, initial );
+        for ( auto& c : candidates ) c = sample[c];
+
+        // Evaluate the total deviation of the sample medoids over the full input on the sphere.
+        impl::parallelFor( n, 1024, [&]( std::size_t begin, std::size_t end )
+        {
+          for ( auto o = begin; o < end; ++o )
+          {
+            auto best = -2.0;
+            for ( std::size_t i = 0; i < candidates.size(); ++i )
+            {
+              if ( const auto d = vectors.dot( o, candidates[i] ); d > best )
+              {
+                best = d;
+                cnearest[o] = i;
+              }
+            }
+            cangle[o] = std::acos( std::clamp( best, -1.0, 1.0 ) );
+          }
+        } );
+
+        if ( const auto cost = std::accumulate( cangle.cbegin(), cangle.cend(), 0.0 ); cost < bestCost )
+        {
+          bestCost = cost;
+          selected = std::move( candidates );
+          std::swap( nearest, cnearest );
+        }
+      }
+
+      impl::parallelFor( n, 1024, [&]( std::size_t begin, std::size_t end )
+      {
+        for ( auto o = begin; o < end; ++o )
+        {
+          minDist[o] = distance( points[o], points[selected[nearest[o]]] ).distance;
+          if ( std::isnan( minDist[o] ) ) minDist[o] = 0.0;
+        }
+      } );
+    }
+
+    auto out = std::vector<Cluster<P>>{};
+    out.reserve( k );
+    for ( const auto m : selected )
+    {
+      out.emplace_back();
+      out.back().centroid = points[m];
+      out.back().points.reserve( n / k );
+    }
+
+    for ( std::size_t o = 0; o < n; ++o )
+    {
+      auto& c = out[nearest[o]];
+      c.points.push_back( &points[o] );
+      if ( !c.statistics ) c.statistics = ClusterStatistics{};
+      c.statistics->bounds.extend( points[o].latitude, points[o].longitude );
+      c.statistics->radius = std::max( c.statistics->radius, minDist[o] );
+      c.statistics->meanDistance += minDist[o];
+    }
+
+    for ( auto& c : out )
+    {
+      if ( c.statistics ) c.statistics->meanDistance /= static_cast<double>( c.points.size() );
+    }
+
+    std::ranges::sort( out, []( const Cluster<P>& lhs, const Cluster<P>& rhs ) { return lhs.points.size() > rhs.points.size(); } );
+    return out;
+  }
+}
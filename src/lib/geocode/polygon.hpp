@@ -0,0 +1,279 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "geocode.hpp"
+#include "impl/parallel.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace spt::geocode
+{
+  namespace impl
+  {
+    struct FenceFile;
+  }
+
+  /**
+   * A polygon with an outer ring and zero or more holes.  Rings are implicitly closed, and their winding order is
+   * not significant.
+   */
+  struct PolygonWithHoles
+  {
+    Polygon outer;
+    std::vector<Polygon> holes;
+  };
+
+  /// A set of disjoint polygons with holes that together represent a single bounding area.
+  using MultiPolygon = std::vector<PolygonWithHoles>;
+
+  /**
+   * A geo-fence prepared once for repeated containment checks.  The vertices are held in structure-of-arrays form
+   * along with the bounding box and the slope and intercept of each edge, so that *contains* does not allocate,
+   * does not divide, and rejects points outside the bounding box without walking the edges.
+   *
+   * An optional acceleration grid may be built over the bounding box.  Each cell is classified once as inside,
+   * outside or on the boundary of the polygon.  Points that fall in inside or outside cells are answered in
+   * constant time, and points in boundary cells are only tested against the edges that cross their cell.  This
+   * is worthwhile for complex fences with hundreds or thousands of vertices; a grid with roughly as many cells
+   * per side as the square root of the number of vertices is a good starting point.
+   *
+   * Polygons with holes and multipolygons are prepared as a single set of edges, and containment follows the
+   * even-odd rule across all the rings.  Longitudes are unwrapped so that no edge spans more than 180 degrees, which
+   * makes fences that cross the antimeridian work as expected.  Rings that enclose a pole are not supported.
+   *
+   * Containment semantics are the same as *within*: points that match a vertex are considered inside.
+   */
+  class PreparedPolygon
+  {
+  public:
+    PreparedPolygon() = default;
+    ~PreparedPolygon() = default;
+    PreparedPolygon( const PreparedPolygon& other );
+    PreparedPolygon& operator=( const PreparedPolygon& other );
+    PreparedPolygon( PreparedPolygon&& other ) noexcept;
+    PreparedPolygon& operator=( PreparedPolygon&& other ) noexcept;
+
+    /**
+     * Prepare the specified polygon for containment checks.
+     * @param polygon The polygon that represents the bounding area.  The ring is implicitly closed.
+     * @param grid The number of cells per side of the acceleration grid.  No grid is built if `0`.
+     */
+    explicit PreparedPolygon( const Polygon& polygon, std::size_t grid = 0 );
+
+    /**
+     * Prepare the specified polygon with holes for containment checks.
+     * @param polygon The polygon that represents the bounding area.  Points within a hole are outside the area.
+     * @param grid The number of cells per side of the acceleration grid.  No grid is built if `0`.
+     */
+    explicit PreparedPolygon( const PolygonWithHoles& polygon, std::size_t grid = 0 );
+
+    /**
+     * Prepare the specified multipolygon for containment checks.
+     * @param polygon The polygons that together represent the bounding area.
+     * @param grid The number of cells per side of the acceleration grid.  No grid is built if `0`.
+     */
+    explicit PreparedPolygon( const MultiPolygon& polygon, std::size_t grid = 0 );
+
+    /**
+     * Check whether the geo-coordinate falls within the prepared geo-fence.
+     * @param latitude The latitude in degrees of the point to check.
+     * @param longitude The longitude in degrees of the point to check.
+     * @return Returns `true` if the point falls within the bounding area.
+     */
+    [[nodiscard]] bool contains( double latitude, double longitude ) const
+    {
+      if ( containsAt( latitude, longitude ) ) return true;
+      // Rings that cross the antimeridian are held with longitudes beyond 180.
+      return box.maxLongitude > 180.0 && containsAt( latitude, longitude + 360.0 );
+    }
+
+    /**
+     * Check whether the geo-coordinate falls within the prepared geo-fence.
+     * @tparam P A geo-coordinate structure that conforms to the *LatLng* concept.
+     * @param point The point to check within bounds.
+     * @return Returns `true` if the point falls within the bounding area.
+     */
+    template <LatLng P>
+    [[nodiscard]] bool contains( const P& point ) const { return contains( point.latitude, point.longitude ); }
+
+    /**
+     * Check a batch of geo-coordinates held in structure-of-arrays form.  The points are processed in blocks, and
+     * for each block the edges are walked once with the crossing test evaluated branch free across all the points
+     * in the block, which allows the compiler to vectorise the inner loop.
+     * @param latitudes The latitudes in degrees of the points to check.
+     * @param longitudes The longitudes in degrees of the points to check.
+     * @param out Set to `1` for points that fall within the bounding area, `0` otherwise.  Only the first
+     *   `min( latitudes.size(), longitudes.size(), out.size() )` points are checked.
+     */
+    void contains( std::span<const double> latitudes, std::span<const double> longitudes, std::span<std::uint8_t> out ) const;
+
+    /// The relation of an area to the polygon.
+    enum class Relation : std::uint8_t { Disjoint, Inside, Partial };
+
+    /**
+     * Classify the area covered by a bounding box against the polygon.  With an acceleration grid, only the edges
+     * listed against the grid cells that overlap the area are checked.
+     * @param bounds The area to classify, in the same longitude range as the query points.
+     * @return `Inside` if every point of the area is within the polygon, `Disjoint` if none are, and `Partial`
+     *   if an edge of the polygon crosses the area.
+     */
+    [[nodiscard]] Relation relate( const BoundingBox& bounds ) const;
+
+    /// Padding in degrees applied to the bounding box, so that points matching a vertex are never rejected early.
+    static constexpr double tolerance{ 1e-6 };
+
+    /// The number of points processed together by the batch containment check.
+    static constexpr std::size_t blockSize{ 256 };
+
+    /// The bounding box of the vertices.  The longitudes of fences that cross the antimeridian extend beyond 180.
+    [[nodiscard]] const BoundingBox& bounds() const { return box; }
+
+    /// The number of vertices (and edges) across all the rings of the polygon.
+    [[nodiscard]] std::size_t size() const { return latitudes.size(); }
+
+    /// The number of cells per side of the acceleration grid, or `0` if there is no grid.
+    [[nodiscard]] std::size_t gridSize() const { return grid; }
+
+  private:
+    // Same comparison as geofence::isEqual, which *within* uses to match vertices.
+    static bool isEqual( double a, double b )
+    {
+      constexpr auto epsilon = static_cast<double>( 1.0e-09f );
+      const auto d = std::abs( a - b );
+      return d <= epsilon || d <= epsilon * std::max( std::abs( a ), std::abs( b ) );
+    }
+
+    [[nodiscard]] bool isVertex( std::size_t i, double latitude, double longitude ) const
+    {
+      // Cheap rejection before the relative comparison.  The relative tolerance never exceeds 1.8e-7 degrees.
+      if ( std::abs( latitude - latitudes[i] ) > 2e-7 ) return false;
+      return isEqual( latitude, latitudes[i] ) && isEqual( longitude, longitudes[i] );
+    }
+
+    [[nodiscard]] bool containsAt( double latitude, double longitude ) const
+    {
+      if ( !padded.contains( latitude, longitude ) ) return false;
+      if ( !cells.empty() ) return containsInCell( latitude, longitude );
+      return scan( latitude, longitude );
+    }
+
+    [[nodiscard]] bool scan( double latitude, double longitude ) const
+    {
+      bool inside{ false };
+      for ( std::size_t i = 0; i < latitudes.size(); ++i )
+      {
+        if ( isVertex( i, latitude, longitude ) ) return true;
+        if ( ( longitudes[i] > longitude ) != ( longitudeTo[i] > longitude ) &&
+            latitude < slopes[i] * longitude + intercepts[i] ) inside = !inside;
+      }
+      return inside;
+    }
+
+    [[nodiscard]] Relation relateAt( const BoundingBox& bounds ) const;
+    [[nodiscard]] bool containsInCell( double latitude, double longitude ) const;
+    [[nodiscard]] bool intersects( std::size_t edge, const BoundingBox& bounds ) const;
+    void addPart( const PolygonWithHoles& polygon );
+    BoundingBox addRing( const Polygon& ring, std::optional<BoundingBox> frame );
+    void prepare( std::size_t grid );
+    void buildGrid( std::size_t size );
+
+    // Point the views at the owned storage.
+    void bind();
+
+    BoundingBox box;
+    BoundingBox padded;
+
+    // Vertex i, and the edge from vertex i to the previous vertex in its ring.  Views over either the owned
+    // storage, or memory owned by a mapped file.
+    std::span<const double> latitudes;
+    std::span<const double> longitudes;
+    std::span<const double> latitudeTo;
+    std::span<const double> longitudeTo;
+    std::span<const double> slopes;
+    std::span<const double> intercepts;
+
+    // Acceleration grid.  Bit 0 of a cell is set if its centre is inside the polygon, and bit 1 if any edge
+    // crosses the cell.  The edges crossing cell i are cellEdges[cellOffsets[i], cellOffsets[i + 1]).
+    std::span<const std::uint8_t> cells;
+    std::span<const std::uint32_t> cellOffsets;
+    std::span<const std::uint32_t> cellEdges;
+    std::size_t grid{ 0 };
+    double cellLatitude{ 0.0 };
+    double cellLongitude{ 0.0 };
+
+    struct Storage
+    {
+      std::vector<double> latitudes;
+      std::vector<double> longitudes;
+      std::vector<double> latitudeTo;
+      std::vector<double> longitudeTo;
+      std::vector<double> slopes;
+      std::vector<double> intercepts;
+      std::vector<std::uint8_t> cells;
+      std::vector<std::uint32_t> cellOffsets;
+      std::vector<std::uint32_t> cellEdges;
+    };
+
+    // Empty for polygons that view memory owned by a mapped file.  Moving a vector does not move its elements,
+    // so the views are carried over as is when the polygon is moved.
+    Storage storage;
+    bool owned{ true };
+
+    friend struct impl::FenceFile;
+  };
+
+  /**
+   * Check whether the geo-coordinate falls within the specified prepared geo-fence.
+   * @tparam P A geo-coordinate structure that conforms to the *LatLng* concept.
+   * @param point The point to check within bounds.
+   * @param polygon The prepared polygon that represents the bounding area to check.
+   * @return Returns `true` if the point falls within the bounding area.
+   */
+  template <LatLng P>
+  bool within( const P& point, const PreparedPolygon& polygon ) { return polygon.contains( point ); }
+
+  /**
+   * Check a batch of geo-coordinates against a single prepared geo-fence.  The points are gathered into blocks that
+   * are checked against the whole polygon while it is hot in cache.  Large batches are split across threads.
+   * @tparam P A geo-coordinate structure that conforms to the *LatLng* concept.
+   * @param polygon The prepared polygon that represents the bounding area to check.
+   * @param points The points to check within bounds.
+   * @param out Set to `1` for points that fall within the bounding area, `0` otherwise.  Only the first
+   *   `min( points.size(), out.size() )` points are checked.
+   */
+  template <LatLng P>
+  void containsBatch( const PreparedPolygon& polygon, std::span<const P> points, std::span<std::uint8_t> out )
+  {
+    constexpr auto block = PreparedPolygon::blockSize;
+    const auto size = std::min( points.size(), out.size() );
+    const auto blocks = ( size + block - 1 ) / block;
+
+    impl::parallelFor( blocks, 16, [&]( std::size_t begin, std::size_t end )
+    {
+      auto latitudes = std::array<double, block>{};
+      auto longitudes = std::array<double, block>{};
+
+      for ( auto b = begin; b < end; ++b )
+      {
+        const auto offset = b * block;
+        const auto count = std::min( block, size - offset );
+        for ( std::size_t i = 0; i < count; ++i )
+        {
+          latitudes[i] = points[offset + i].latitude;
+          longitudes[i] = points[offset + i].longitude;
+        }
+
+        polygon.contains( std::span<const double>( latitudes.data(), count ),
+          std::span<const double>( longitudes.data(), count ), out.subspan( offset, count ) );
+      }
+    } );
+  }
+}
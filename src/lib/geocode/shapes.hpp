@@ -0,0 +1,162 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "geocode.hpp"
+#include "impl/grid.hpp"
+#include "impl/sphere.hpp"
+
+#include <vector>
+
+namespace spt::geocode
+{
+  /**
+   * A geo-fence that covers all points within a fixed distance of a centre point.  Membership is decided without
+   * approximating the circle by a polygon.  Points outside a bounding box around the circle are rejected with a
+   * few comparisons.  The remaining points are compared against the centre using the great circle distance on a
+   * spherical earth, which differs from the geodesic distance on the WGS84 ellipsoid by less than 0.6%.  Only
+   * points whose spherical distance falls within a narrow band around the radius are resolved with the geodesic
+   * *distance*.
+   *
+   * Circles that cross the antimeridian or enclose a pole are supported.
+   */
+  class CircleFence
+  {
+  public:
+    CircleFence() = default;
+    ~CircleFence() = default;
+    CircleFence( const CircleFence& ) = default;
+    CircleFence& operator=( const CircleFence& ) = default;
+    CircleFence( CircleFence&& ) = default;
+    CircleFence& operator=( CircleFence&& ) = default;
+
+    /**
+     * Create a fence around the specified centre.
+     * @param centre The centre of the circle.
+     * @param radius The radius of the circle in metres.  Negative values are treated as `0`.
+     */
+    CircleFence( const Point& centre, double radius );
+
+    /**
+     * Check whether the geo-coordinate falls within the circle.
+     * @param latitude The latitude in degrees of the point to check.
+     * @param longitude The longitude in degrees of the point to check.
+     * @return Returns `true` if the geodesic distance of the point from the centre is at most the radius.
+     */
+    [[nodiscard]] bool contains( double latitude, double longitude ) const;
+
+    /**
+     * Check whether the geo-coordinate falls within the circle.
+     * @tparam P A geo-coordinate structure that conforms to the *LatLng* concept.
+     * @param point The point to check within bounds.
+     * @return Returns `true` if the geodesic distance of the point from the centre is at most the radius.
+     */
+    template <LatLng P>
+    [[nodiscard]] bool contains( const P& point ) const { return contains( point.latitude, point.longitude ); }
+
+    /// The centre of the circle.
+    [[nodiscard]] const Point& centre() const { return origin; }
+
+    /// The radius of the circle in metres.
+    [[nodiscard]] double radius() const { return metres; }
+
+    /**
+     * The bounding box of the circle.  The longitudes of circles that cross the antimeridian extend beyond 180,
+     * and circles that enclose a pole span all longitudes.
+     */
+    [[nodiscard]] const BoundingBox& bounds() const { return box; }
+
+    /**
+     * Radii up to this many metres are resolved with the geodesic distance near the boundary.  Larger circles use
+     * the spherical distance throughout.
+     */
+    static constexpr double geodesicLimit{ 5'000'000.0 };
+
+  private:
+    BoundingBox box;
+    Point origin;
+    impl::sphere::Vector vector;
+    double metres{ 0.0 };
+    double latitudeSpan{ 0.0 };
+    double longitudeSpan{ 0.0 };
+    double cosInner{ 1.0 };
+    double cosOuter{ 1.0 };
+  };
+
+  /**
+   * A geo-fence that covers all points within a fixed distance of a route, a buffered polyline.  The route is
+   * followed along great circle arcs between its vertices.  Each segment is padded by the width into a bounding
+   * box, and the boxes are indexed in a uniform grid, so that a point is only compared against the few segments
+   * whose box contains it.  Membership is decided by the exact distance from the point to the nearest segment on
+   * a spherical earth, rather than by a polygon approximating the buffer.
+   *
+   * Longitudes are unwrapped so that no segment spans more than 180 degrees, which makes routes that cross the
+   * antimeridian work as expected.
+   */
+  class CorridorFence
+  {
+  public:
+    CorridorFence() = default;
+    ~CorridorFence() = default;
+    CorridorFence( const CorridorFence& ) = default;
+    CorridorFence& operator=( const CorridorFence& ) = default;
+    CorridorFence( CorridorFence&& ) = default;
+    CorridorFence& operator=( CorridorFence&& ) = default;
+
+    /**
+     * Create a fence around the specified route.
+     * @param route The vertices of the route, in order.  A route with a single vertex is a circle.
+     * @param width The distance in metres either side of the route that is within the corridor.  Negative values
+     *   are treated as `0`.
+     */
+    CorridorFence( std::vector<Point> route, double width );
+
+    /**
+     * Check whether the geo-coordinate falls within the corridor.
+     * @param latitude The latitude in degrees of the point to check.
+     * @param longitude The longitude in degrees of the point to check.
+     * @return Returns `true` if the distance of the point from the route is at most the width.
+     */
+    [[nodiscard]] bool contains( double latitude, double longitude ) const;
+
+    /**
+     * Check whether the geo-coordinate falls within the corridor.
+     * @tparam P A geo-coordinate structure that conforms to the *LatLng* concept.
+     * @param point The point to check within bounds.
+     * @return Returns `true` if the distance of the point from the route is at most the width.
+     */
+    template <LatLng P>
+    [[nodiscard]] bool contains( const P& point ) const { return contains( point.latitude, point.longitude ); }
+
+    /**
+     * The distance from the geo-coordinate to the route.
+     * @param latitude The latitude in degrees of the point.
+     * @param longitude The longitude in degrees of the point.
+     * @return The distance in metres to the nearest point on the route, or infinity for an empty route.
+     */
+    [[nodiscard]] double distance( double latitude, double longitude ) const;
+
+    /// The vertices of the route, as specified.
+    [[nodiscard]] const std::vector<Point>& route() const { return points; }
+
+    /// The distance in metres either side of the route that is within the corridor.
+    [[nodiscard]] double width() const { return metres; }
+
+    /**
+     * The bounding box of the corridor.  The longitudes of corridors that cross the antimeridian extend beyond 180.
+     */
+    [[nodiscard]] const BoundingBox& bounds() const { return grid.box; }
+
+  private:
+    [[nodiscard]] bool containsAt( double latitude, double longitude, const impl::sphere::Vector& vector ) const;
+
+    std::vector<Point> points;
+    std::vector<impl::sphere::Vector> vectors;
+    std::vector<BoundingBox> boxes;
+    impl::BoxGrid grid;
+    double metres{ 0.0 };
+    double angle{ 0.0 };
+  };
+}
@@ -0,0 +1,62 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include "geocode.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace spt::geocode
+{
+  /// The algorithm used to simplify a polygon.
+  enum class SimplifyMethod : std::uint8_t
+  {
+    /// Keep vertices further than the tolerance from the simplified boundary (Douglas–Peucker).
+    DouglasPeucker,
+    /// Repeatedly remove the vertex whose triangle with its neighbours has the least area (Visvalingam–Whyatt).
+    VisvalingamWhyatt
+  };
+
+  /// Options that control polygon simplification.
+  struct SimplifyOptions
+  {
+    /**
+     * The error bound in metres.  For Douglas–Peucker no removed vertex is further than this from the simplified
+     * boundary.  For Visvalingam–Whyatt vertices are removed while the area of their triangle is less than the
+     * square of this value.  `0` leaves polygons unchanged.
+     */
+    double tolerance{ 10.0 };
+
+    /// The algorithm to use.
+    SimplifyMethod method{ SimplifyMethod::DouglasPeucker };
+
+    /**
+     * Do not introduce self-intersections into a simple ring.  Vertices that would otherwise be removed are kept
+     * where removing them would cause the simplified boundary to cross itself.
+     */
+    bool preserveTopology{ false };
+  };
+
+  /**
+   * Simplify the specified polygon.  Distances and areas are computed on a spherical earth, so the tolerance has
+   * the same meaning regardless of latitude.  The simplified ring always keeps at least 3 vertices, and only
+   * contains vertices of the input ring, in the same order.  If the input ring is explicitly closed (the last
+   * vertex repeats the first), so is the output.
+   * @param polygon The polygon to simplify.  Rings with fewer than 4 vertices are returned unchanged.
+   * @param options The algorithm and error bound to use.
+   * @return The simplified polygon.
+   */
+  Polygon simplify( const Polygon& polygon, const SimplifyOptions& options = {} );
+
+  /**
+   * Simplify a batch of polygons, spreading the work across threads.
+   * @param polygons The polygons to simplify.
+   * @param options The algorithm and error bound to use.
+   * @return The simplified polygons, in the same order as the input.
+   */
+  std::vector<Polygon> simplify( std::span<const Polygon> polygons, const SimplifyOptions& options = {} );
+}
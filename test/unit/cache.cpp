@@ -0,0 +1,174 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/lib/geocode/impl/lrucache.hpp"
+#include "../../src/lib/geocode/client.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::operator ""s;
+using std::chrono_literals::operator ""ms;
+using std::chrono_literals::operator ""s;
+
+SCENARIO( "Sharded LRU cache test suite", "[cache]" )
+{
+  GIVEN( "A single shard cache with room for three entries" )
+  {
+    auto cache = spt::geocode::impl::LruCache<int, std::string>{ 300, 1 };
+
+    WHEN( "Adding entries beyond the bound" )
+    {
+      cache.put( 1, "one"s, 100, 60s );
+      cache.put( 2, "two"s, 100, 60s );
+      cache.put( 3, "three"s, 100, 60s );
+      CHECK( cache.get( 1 ) == "one"s );
+      cache.put( 4, "four"s, 100, 60s );
+
+      THEN( "The least recently used entry is evicted" )
+      {
+        CHECK( cache.get( 1 ) == "one"s );
+        CHECK_FALSE( cache.get( 2 ).has_value() );
+        CHECK( cache.get( 3 ) == "three"s );
+        CHECK( cache.get( 4 ) == "four"s );
+
+        const auto stats = cache.stats();
+        CHECK( stats.hits == 4 );
+        CHECK( stats.misses == 1 );
+        CHECK( stats.evictions == 1 );
+        CHECK( stats.entries == 3 );
+        CHECK( stats.bytes == 300 );
+      }
+    }
+
+    AND_WHEN( "Replacing an entry with a larger one" )
+    {
+      cache.put( 1, "one"s, 100, 60s );
+      cache.put( 2, "two"s, 100, 60s );
+      cache.put( 1, "uno"s, 250, 60s );
+
+      THEN( "Older entries are evicted to make room" )
+      {
+        CHECK( cache.get( 1 ) == "uno"s );
+        CHECK_FALSE( cache.get( 2 ).has_value() );
+        CHECK( cache.stats().bytes == 250 );
+      }
+    }
+
+    AND_WHEN( "Adding an entry larger than the bound" )
+    {
+      cache.put( 1, "one"s, 301, 60s );
+
+      THEN( "The entry is not cached" )
+      {
+        CHECK_FALSE( cache.get( 1 ).has_value() );
+        CHECK( cache.stats().entries == 0 );
+      }
+    }
+
+    AND_WHEN( "An entry expires" )
+    {
+      cache.put( 1, "one"s, 100, 20ms );
+      cache.put( 2, "two"s, 100, 60s );
+      std::this_thread::sleep_for( 40ms );
+
+      THEN( "It is removed on lookup and counted as a miss" )
+      {
+        CHECK_FALSE( cache.get( 1 ).has_value() );
+        CHECK( cache.get( 2 ) == "two"s );
+
+        const auto stats = cache.stats();
+        CHECK( stats.hits == 1 );
+        CHECK( stats.misses == 1 );
+        CHECK( stats.expirations == 1 );
+        CHECK( stats.entries == 1 );
+        CHECK( stats.bytes == 100 );
+      }
+    }
+
+    AND_WHEN( "Clearing the cache" )
+    {
+      cache.put( 1, "one"s, 100, 60s );
+      cache.clear();
+      CHECK_FALSE( cache.get( 1 ).has_value() );
+      CHECK( cache.stats().bytes == 0 );
+    }
+  }
+
+  GIVEN( "A cache bounded by the number of entries only" )
+  {
+    auto cache = spt::geocode::impl::LruCache<std::string, int>{ 0, 1, 2 };
+    cache.put( "a"s, 1, 1'000'000, 60s );
+    cache.put( "b"s, 2, 1'000'000, 60s );
+    cache.put( "c"s, 3, 1'000'000, 60s );
+
+    CHECK_FALSE( cache.get( "a"s ).has_value() );
+    CHECK( cache.get( "b"s ) == 2 );
+    CHECK( cache.get( "c"s ) == 3 );
+    CHECK( cache.stats().entries == 2 );
+    CHECK( cache.stats().evictions == 1 );
+  }
+
+  GIVEN( "A sharded cache used from several threads" )
+  {
+    auto cache = spt::geocode::impl::LruCache<std::uint64_t, std::uint64_t>{ 16 * 1024 * 1024, 10 };
+    CHECK( cache.shards() == 16 );
+
+    auto wrong = std::atomic<int>{ 0 };
+    auto threads = std::vector<std::thread>{};
+    for ( std::uint64_t t = 0; t < 4; ++t )
+    {
+      threads.emplace_back( [&cache, &wrong, t]
+      {
+        // Keys whose low bits are all the same, like packed cell ids, are still spread over the shards.
+        for ( std::uint64_t i = 0; i < 10'000; ++i ) cache.put( ( ( t * 10'000 + i ) << 4 ) | 10, i, 64, std::chrono::seconds{ 60 } );
+        for ( std::uint64_t i = 0; i < 10'000; ++i )
+        {
+          if ( cache.get( ( ( t * 10'000 + i ) << 4 ) | 10 ) != i ) ++wrong;
+        }
+      } );
+    }
+    for ( auto& thread : threads ) thread.join();
+
+    const auto stats = cache.stats();
+    CHECK( wrong == 0 );
+    CHECK( stats.entries == 40'000 );
+    CHECK( stats.hits == 40'000 );
+    CHECK( stats.evictions == 0 );
+  }
+}
+
+SCENARIO( "Address normalisation test suite", "[cache]" )
+{
+  GIVEN( "Differently written forms of the same address" )
+  {
+    const auto expected = std::string{ "565 5 ave manhattan new york ny us" };
+    CHECK( spt::geocode::normaliseAddress( "565 5 Ave, Manhattan, New York, NY, USA" ) == expected );
+    CHECK( spt::geocode::normaliseAddress( "565 Fifth Avenue,  MANHATTAN, New York NY, usa." ) == expected );
+    CHECK( spt::geocode::normaliseAddress( "  565 5th av.\tManhattan;New-York   NY (USA)" ) == expected );
+  }
+
+  GIVEN( "Abbreviations, ordinals and apostrophes" )
+  {
+    CHECK( spt::geocode::normaliseAddress( "2100 North Western Boulevard" ) == "2100 n western blvd" );
+    CHECK( spt::geocode::normaliseAddress( "1 W 21st Street, Suite 300" ) == "1 w 21 st ste 300" );
+    CHECK( spt::geocode::normaliseAddress( "10000 W O'Hare Ave" ) == "10000 w ohare ave" );
+    CHECK( spt::geocode::normaliseAddress( "1st" ) == "1" );
+    CHECK( spt::geocode::normaliseAddress( "St" ) == "st" );
+  }
+
+  GIVEN( "Addresses without letters or digits" )
+  {
+    CHECK( spt::geocode::normaliseAddress( "" ).empty() );
+    CHECK( spt::geocode::normaliseAddress( " ,.; " ).empty() );
+  }
+
+  GIVEN( "Addresses outside ASCII" )
+  {
+    CHECK( spt::geocode::normaliseAddress( "Straße 5, MÜNCHEN" ) == "straße 5 mÜnchen" );
+  }
+}
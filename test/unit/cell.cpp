@@ -0,0 +1,379 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "../../src/lib/geocode/cell.hpp"
+
+#include <random>
+#include <set>
+
+using std::operator ""sv;
+
+SCENARIO( "Open Location Code cell test suite", "[cell]" )
+{
+  GIVEN( "The google example geo-coordinate" )
+  {
+    const auto cell = spt::geocode::CellId::fromPoint( 47.0000625, 8.0000625 );
+
+    WHEN( "Inspecting the cell" )
+    {
+      CHECK( cell.length() == 10 );
+      CHECK( cell.code().view() == "8FVC2222+22"sv );
+      CHECK( cell.parent( 4 ).code().view() == "8FVC0000+"sv );
+      CHECK( cell.parent( 4 ).contains( cell ) );
+      CHECK_FALSE( cell.contains( cell.parent( 4 ) ) );
+      CHECK( cell.parent( 11 ) == cell );
+      CHECK( cell.parent( 3 ).code().view() == "8FVC0000+"sv );
+      CHECK( spt::geocode::CellId::fromPoint( 47.0000625, 8.0000625, 9 ) == cell );
+      CHECK( spt::geocode::CellId::fromPoint( 47.0000625, 8.0000625, 9 ).code() == spt::geocode::FixedCode( 47.0000625, 8.0000625, 9 ) );
+      CHECK( spt::geocode::CellId::fromPoint( 47.0000625, 8.0000625, 0 ).length() == 2 );
+
+      const auto box = cell.bounds();
+      CHECK_THAT( box.minLatitude, Catch::Matchers::WithinAbs( 47.0, 1e-9 ) );
+      CHECK_THAT( box.maxLongitude, Catch::Matchers::WithinAbs( 8.000125, 1e-9 ) );
+    }
+
+    AND_WHEN( "Packing codes" )
+    {
+      const auto packed = spt::geocode::CellId::fromCode( "8fvc2222+22"sv );
+      REQUIRE( packed.has_value() );
+      CHECK( *packed == cell );
+
+      const auto padded = spt::geocode::CellId::fromCode( "8FVC0000+"sv );
+      REQUIRE( padded.has_value() );
+      CHECK( padded->length() == 4 );
+      CHECK( *padded == cell.parent( 4 ) );
+
+      const auto longer = spt::geocode::CellId::fromCode( "8FVC2222+22GCCCC"sv );
+      REQUIRE( longer.has_value() );
+      CHECK( longer->length() == spt::geocode::CellId::maxLength );
+      CHECK( cell.contains( *longer ) );
+
+      CHECK_FALSE( spt::geocode::CellId::fromCode( "9G8F+6X"sv ).has_value() );
+      CHECK_FALSE( spt::geocode::CellId::fromCode( "8FVC2222+2"sv ).has_value() );
+    }
+
+    AND_WHEN( "Computing neighbours" )
+    {
+      const auto neighbours = cell.neighbours();
+      const auto box = cell.bounds();
+      for ( const auto& n : neighbours )
+      {
+        REQUIRE( n.valid() );
+        CHECK( n.length() == cell.length() );
+        const auto b = n.bounds();
+        CHECK( std::abs( b.minLatitude - box.minLatitude ) < 0.000126 );
+        CHECK( std::abs( b.minLongitude - box.minLongitude ) < 0.000126 );
+        CHECK( n != cell );
+      }
+      CHECK( std::set<spt::geocode::CellId>( neighbours.begin(), neighbours.end() ).size() == 8 );
+    }
+  }
+
+  GIVEN( "Cells at the edges of the world" )
+  {
+    WHEN( "A cell at the antimeridian" )
+    {
+      const auto cell = spt::geocode::CellId::fromPoint( 10.0, 179.99999, 8 );
+      const auto neighbours = cell.neighbours();
+      for ( const auto& n : neighbours ) REQUIRE( n.valid() );
+      CHECK_THAT( neighbours[2].bounds().minLongitude, Catch::Matchers::WithinAbs( -180.0, 1e-9 ) );
+      CHECK( neighbours[4] == spt::geocode::CellId::fromPoint( 10.0, -179.99999, 8 ) );
+    }
+
+    AND_WHEN( "A cell at the north pole" )
+    {
+      const auto cell = spt::geocode::CellId::fromPoint( 90.0, 0.0, 6 );
+      const auto neighbours = cell.neighbours();
+      for ( std::size_t i = 0; i < 5; ++i ) CHECK( neighbours[i].valid() );
+      for ( std::size_t i = 5; i < 8; ++i ) CHECK_FALSE( neighbours[i].valid() );
+    }
+  }
+
+  GIVEN( "Random geo-coordinates" )
+  {
+    auto engine = std::mt19937_64{ 41 };
+    auto latitude = std::uniform_real_distribution<double>{ -90.0, 90.0 };
+    auto longitude = std::uniform_real_distribution<double>{ -180.0, 180.0 };
+    auto lengths = std::uniform_int_distribution<std::size_t>{ 0, 6 };
+    constexpr auto levels = std::array<std::size_t, 7>{ 2, 4, 6, 8, 10, 11, 12 };
+
+    WHEN( "Comparing cells with their codes" )
+    {
+      std::size_t mismatches{ 0 };
+      auto cells = std::vector<spt::geocode::CellId>{};
+      auto codes = std::vector<std::string>{};
+      for ( int i = 0; i < 20000; ++i )
+      {
+        const auto lat = latitude( engine );
+        const auto lng = longitude( engine );
+        const auto length = levels[lengths( engine )];
+        const auto cell = spt::geocode::CellId::fromPoint( lat, lng, length );
+        const auto code = spt::geocode::FixedCode{ lat, lng, length };
+        if ( cell.code() != code || !cell.bounds().contains( lat, lng ) ) ++mismatches;
+        if ( *spt::geocode::CellId::fromCode( code ) != cell ) ++mismatches;
+        cells.push_back( cell );
+        codes.push_back( code.str() );
+      }
+      CHECK( mismatches == 0 );
+
+      // Packed cells sort in the same order as their codes, with padding sorting before digits.
+      std::ranges::sort( cells );
+      for ( auto& code : codes )
+      {
+        for ( auto& c : code ) if ( c == '0' || c == '+' ) c = ' ';
+      }
+      std::ranges::sort( codes );
+      for ( std::size_t i = 0; i < cells.size(); ++i )
+      {
+        auto code = cells[i].code().str();
+        for ( auto& c : code ) if ( c == '0' || c == '+' ) c = ' ';
+        if ( code != codes[i] ) ++mismatches;
+      }
+      CHECK( mismatches == 0 );
+    }
+  }
+}
+
+SCENARIO( "Open Location Code cell index test suite", "[cell]" )
+{
+  GIVEN( "An index over random points around a city" )
+  {
+    auto engine = std::mt19937_64{ 41 };
+    auto latitude = std::uniform_real_distribution<double>{ 41.5, 42.5 };
+    auto longitude = std::uniform_real_distribution<double>{ -88.5, -87.5 };
+
+    auto points = std::vector<spt::geocode::Point>{};
+    auto entries = std::vector<spt::geocode::CellIndex<std::uint32_t>::Entry>{};
+    for ( std::uint32_t i = 0; i < 100000; ++i )
+    {
+      points.push_back( spt::geocode::Point{ .latitude = latitude( engine ), .longitude = longitude( engine ) } );
+      entries.emplace_back( spt::geocode::CellId::fromPoint( points.back(), 12 ), i );
+    }
+    const auto index = spt::geocode::CellIndex<std::uint32_t>{ entries };
+    REQUIRE( index.size() == points.size() );
+    REQUIRE( std::ranges::is_sorted( index.keys() ) );
+
+    WHEN( "Looking up the points within cells at each level" )
+    {
+      std::size_t mismatches{ 0 };
+      for ( int i = 0; i < 50; ++i )
+      {
+        const auto& p = points[static_cast<std::size_t>( i ) * 997];
+        for ( std::size_t length : { 4, 6, 8 } )
+        {
+          const auto cell = spt::geocode::CellId::fromPoint( p, length );
+          const auto found = index.within( cell );
+          std::size_t expected{ 0 };
+          for ( const auto& q : points ) if ( spt::geocode::CellId::fromPoint( q, length ) == cell ) ++expected;
+          if ( found.size() != expected ) ++mismatches;
+          for ( const auto id : found ) if ( !cell.contains( spt::geocode::CellId::fromPoint( points[id], 12 ) ) ) ++mismatches;
+        }
+      }
+      CHECK( mismatches == 0 );
+    }
+
+    AND_WHEN( "Looking up the neighbourhood of a cell" )
+    {
+      const auto cell = spt::geocode::CellId::fromPoint( 42.0, -88.0, 8 );
+      const auto neighbourhood = index.neighbourhood( cell );
+      std::size_t found{ 0 };
+      for ( const auto& values : neighbourhood ) found += values.size();
+
+      auto box = cell.bounds();
+      const auto height = box.maxLatitude - box.minLatitude;
+      const auto width = box.maxLongitude - box.minLongitude;
+      std::size_t expected{ 0 };
+      for ( const auto& p : points )
+      {
+        if ( p.latitude >= box.minLatitude - height && p.latitude < box.maxLatitude + height &&
+          p.longitude >= box.minLongitude - width && p.longitude < box.maxLongitude + width ) ++expected;
+      }
+      CHECK( found == expected );
+      CHECK( found > 0 );
+    }
+  }
+
+  GIVEN( "An index with entries at several levels" )
+  {
+    const auto point = spt::geocode::Point{ .latitude = 47.0000625, .longitude = 8.0000625 };
+    auto entries = std::vector<spt::geocode::CellIndex<std::string>::Entry>{};
+    entries.emplace_back( spt::geocode::CellId::fromPoint( point, 4 ), "region" );
+    entries.emplace_back( spt::geocode::CellId::fromPoint( point, 8 ), "block" );
+    entries.emplace_back( spt::geocode::CellId::fromPoint( point, 12 ), "building" );
+    entries.emplace_back( spt::geocode::CellId::fromPoint( 47.5, 8.5, 8 ), "elsewhere" );
+    entries.emplace_back( spt::geocode::CellId{}, "invalid" );
+    const auto index = spt::geocode::CellIndex<std::string>{ entries };
+    CHECK( index.size() == 4 );
+
+    WHEN( "Looking up the entries that contain a cell" )
+    {
+      auto found = std::vector<std::string>{};
+      index.containing( spt::geocode::CellId::fromPoint( point, 10 ), [&found]( spt::geocode::CellId, std::span<const std::string> values )
+      {
+        found.insert( found.end(), values.begin(), values.end() );
+      } );
+      CHECK( found == std::vector<std::string>{ "region", "block" } );
+      CHECK( index.within( spt::geocode::CellId::fromPoint( point, 4 ) ).size() == 4 );
+      CHECK( index.within( spt::geocode::CellId::fromPoint( point, 8 ) ).size() == 2 );
+    }
+  }
+}
+
+SCENARIO( "Open Location Code region covering test suite", "[cell]" )
+{
+  // Every cell in the covering is distinct, and none contains another.
+  const auto disjoint = []( const std::vector<spt::geocode::CellId>& cells )
+  {
+    for ( std::size_t i = 1; i < cells.size(); ++i )
+    {
+      if ( cells[i - 1].contains( cells[i] ) || cells[i - 1] >= cells[i] ) return false;
+    }
+    return true;
+  };
+
+  // Whether a point lies in one of the cells of the covering.
+  const auto covered = []( const std::vector<spt::geocode::CellId>& cells, double latitude, double longitude )
+  {
+    const auto cell = spt::geocode::CellId::fromPoint( latitude, longitude, spt::geocode::CellId::maxLength );
+    return std::ranges::any_of( cells, [cell]( spt::geocode::CellId c ) { return c.contains( cell ); } );
+  };
+
+  GIVEN( "A bounding box that matches a cell" )
+  {
+    const auto cell = spt::geocode::CellId::fromPoint( 47.0000625, 8.0000625, 6 );
+
+    WHEN( "Covering the box" )
+    {
+      const auto cells = spt::geocode::cover( cell.bounds() );
+      REQUIRE( cells.size() == 1 );
+      CHECK( cells.front() == cell );
+    }
+
+    AND_WHEN( "Covering the box with a minimum length" )
+    {
+      const auto cells = spt::geocode::cover( cell.bounds(), 8, 8 );
+      CHECK( cells.size() == 400 );
+      CHECK( std::ranges::all_of( cells, [cell]( spt::geocode::CellId c ) { return c.length() == 8 && cell.contains( c ); } ) );
+    }
+  }
+
+  GIVEN( "A bounding box around a city" )
+  {
+    auto box = spt::geocode::BoundingBox{};
+    box.extend( 41.64, -87.94 );
+    box.extend( 42.02, -87.52 );
+
+    WHEN( "Covering the box with a range of limits" )
+    {
+      auto engine = std::mt19937_64{ 42 };
+      auto latitude = std::uniform_real_distribution<double>{ box.minLatitude, box.maxLatitude };
+      auto longitude = std::uniform_real_distribution<double>{ box.minLongitude, box.maxLongitude };
+
+      for ( std::size_t maxCells : { 8, 32, 256 } )
+      {
+        const auto cells = spt::geocode::cover( box, maxCells, 4, 10 );
+        CHECK( !cells.empty() );
+        CHECK( cells.size() <= maxCells );
+        CHECK( disjoint( cells ) );
+
+        std::size_t missed{ 0 };
+        for ( int i = 0; i < 10000; ++i ) if ( !covered( cells, latitude( engine ), longitude( engine ) ) ) ++missed;
+        CHECK( missed == 0 );
+      }
+
+      // More cells hug the box more closely.
+      const auto area = []( const std::vector<spt::geocode::CellId>& cells )
+      {
+        auto total = 0.0;
+        for ( const auto& c : cells )
+        {
+          const auto b = c.bounds();
+          total += ( b.maxLatitude - b.minLatitude ) * ( b.maxLongitude - b.minLongitude );
+        }
+        return total;
+      };
+      CHECK( area( spt::geocode::cover( box, 256, 4, 10 ) ) < area( spt::geocode::cover( box, 8, 4, 10 ) ) );
+    }
+  }
+
+  GIVEN( "A bounding box that crosses the antimeridian" )
+  {
+    auto box = spt::geocode::BoundingBox{};
+    box.extend( -17.5, 178.5 );
+    box.extend( -16.0, 181.0 );
+
+    WHEN( "Covering the box" )
+    {
+      const auto cells = spt::geocode::cover( box, 64, 2, 8 );
+      CHECK( cells.size() <= 64 );
+      CHECK( disjoint( cells ) );
+      CHECK( covered( cells, -17.0, 179.5 ) );
+      CHECK( covered( cells, -17.0, -179.5 ) );
+      CHECK_FALSE( covered( cells, -17.0, -178.0 ) );
+      CHECK_FALSE( covered( cells, -17.0, 175.0 ) );
+    }
+  }
+
+  GIVEN( "A polygon" )
+  {
+    const auto polygon = spt::geocode::Polygon{
+      { .latitude = 40.70, .longitude = -74.02 }, { .latitude = 40.88, .longitude = -73.93 },
+      { .latitude = 40.80, .longitude = -73.90 }, { .latitude = 40.70, .longitude = -73.97 } };
+    const auto prepared = spt::geocode::PreparedPolygon{ polygon };
+
+    WHEN( "Covering the polygon" )
+    {
+      const auto cells = spt::geocode::cover( prepared, 64, 2, 10 );
+      CHECK( cells.size() <= 64 );
+      CHECK( disjoint( cells ) );
+      CHECK( cells == spt::geocode::cover( polygon, 64, 2, 10 ) );
+
+      auto engine = std::mt19937_64{ 42 };
+      auto latitude = std::uniform_real_distribution<double>{ 40.69, 40.89 };
+      auto longitude = std::uniform_real_distribution<double>{ -74.03, -73.89 };
+      std::size_t inside{ 0 };
+      std::size_t missed{ 0 };
+      std::size_t outside{ 0 };
+      for ( int i = 0; i < 20000; ++i )
+      {
+        const auto lat = latitude( engine );
+        const auto lng = longitude( engine );
+        if ( prepared.contains( lat, lng ) )
+        {
+          ++inside;
+          if ( !covered( cells, lat, lng ) ) ++missed;
+        }
+        else if ( !covered( cells, lat, lng ) ) ++outside;
+      }
+      CHECK( inside > 0 );
+      CHECK( missed == 0 );
+      CHECK( outside > 0 );
+    }
+
+    AND_WHEN( "Querying an index with the covering" )
+    {
+      auto engine = std::mt19937_64{ 43 };
+      auto latitude = std::uniform_real_distribution<double>{ 40.6, 41.0 };
+      auto longitude = std::uniform_real_distribution<double>{ -74.1, -73.8 };
+      auto points = std::vector<spt::geocode::Point>{};
+      auto entries = std::vector<spt::geocode::CellIndex<std::uint32_t>::Entry>{};
+      for ( std::uint32_t i = 0; i < 20000; ++i )
+      {
+        points.push_back( spt::geocode::Point{ .latitude = latitude( engine ), .longitude = longitude( engine ) } );
+        entries.emplace_back( spt::geocode::CellId::fromPoint( points.back(), 12 ), i );
+      }
+      const auto index = spt::geocode::CellIndex<std::uint32_t>{ entries };
+
+      std::size_t found{ 0 };
+      for ( const auto cell : spt::geocode::cover( prepared, 32, 2, 10 ) )
+      {
+        for ( const auto id : index.within( cell ) ) if ( prepared.contains( points[id] ) ) ++found;
+      }
+      const auto expected = std::ranges::count_if( points, [&prepared]( const auto& p ) { return prepared.contains( p ); } );
+      CHECK( found == static_cast<std::size_t>( expected ) );
+    }
+  }
+}
@@ -0,0 +1,551 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "mockserver.hpp"
+#include "../../src/lib/geocode/client.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <format>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  namespace ptest
+  {
+    spt::geocode::test::MockServer::Response positionstack( std::string_view target, std::string_view )
+    {
+      if ( target.find( "access_key=test" ) == std::string_view::npos ) return { 401, R"({"error":{"code":"invalid_access_key"}})" };
+      if ( target.starts_with( "/v1/reverse" ) )
+      {
+        return { 200, R"({"data":[{"name":"2100 N Western Ave","locality":"Chicago","region":"Illinois","county":"Cook County",)"
+          R"("postal_code":"60647","country":"United States","label":"2100 N Western Ave, Chicago, IL, USA","distance":0.012}]})" };
+      }
+      if ( target.starts_with( "/v1/forward" ) && target.find( "query=nowhere" ) != std::string_view::npos ) return { 200, R"({"data":[]})" };
+      if ( target.starts_with( "/v1/forward" ) )
+      {
+        return { 200, R"({"data":[{"latitude":40.755884,"longitude":-73.978504,"distance":0.5}]})" };
+      }
+      return { 404, R"({"error":{"code":"not_found"}})" };
+    }
+
+    // Answers batch requests with a result per query.  Reverse results echo the query as the label, forward results
+    // use the number after "address " as the latitude, and "0,0" and "unknown" have no results.
+    spt::geocode::test::MockServer::Response batch( std::string_view target, std::string_view body )
+    {
+      if ( body.empty() || target.find( "access_key=test" ) == std::string_view::npos ) return positionstack( target, body );
+
+      auto data = std::string{};
+      for ( auto at = body.find( R"("query":")" ); at != std::string_view::npos; at = body.find( R"("query":")", at ) )
+      {
+        at += 9;
+        const auto query = body.substr( at, body.find( '"', at ) - at );
+        if ( !data.empty() ) data.push_back( ',' );
+
+        if ( query == "0,0" || query == "unknown" ) data.append( "[]" );
+        else if ( target.starts_with( "/v1/reverse" ) ) data.append( std::format( R"([{{"locality":"Chicago","label":"{}"}}])", query ) );
+        else data.append( std::format( R"([{{"latitude":{}.5,"longitude":-73.5}}])", query.substr( 8 ) ) );
+      }
+      return { 200, std::format( R"({{"data":[{}]}})", data ) };
+    }
+
+    // A coroutine that starts immediately and is not awaited, which is enough to drive an *AsyncLookup*.
+    struct Task
+    {
+      struct promise_type
+      {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+      };
+    };
+
+    Task lookup( const spt::geocode::Client& client, std::promise<std::pair<std::string, double>>& result )
+    {
+      const auto address = co_await client.awaitAddress( 41.92, -87.69 );
+      const auto point = co_await client.awaitFromAddress( "565 5 Ave, Manhattan, New York, NY, USA" );
+      result.set_value( { address ? address->city : address.error(), point ? point->latitude : 0.0 } );
+    }
+
+    spt::geocode::ClientOptions options( const spt::geocode::test::MockServer& server, std::size_t poolSize )
+    {
+      auto opts = spt::geocode::ClientOptions{};
+      opts.key = "test";
+      opts.baseUrl = server.url();
+      opts.poolSize = poolSize;
+      opts.connectTimeout = std::chrono::milliseconds{ 1'000 };
+      opts.timeout = std::chrono::milliseconds{ 2'000 };
+      return opts;
+    }
+  }
+}
+
+SCENARIO( "positionstack client with a session pool", "[client]" )
+{
+  GIVEN( "A mock positionstack server" )
+  {
+    auto server = spt::geocode::test::MockServer{ ptest::positionstack };
+
+    WHEN( "Making sequential lookups" )
+    {
+      const auto client = spt::geocode::Client{ ptest::options( server, 4 ) };
+      for ( int i = 0; i < 20; ++i )
+      {
+        const auto address = client.address( 41.9215927, -87.6953278 );
+        REQUIRE( address.has_value() );
+        CHECK( address->city == "Chicago" );
+        CHECK( address->state == "Illinois" );
+        CHECK( address->postalCode == "60647" );
+        REQUIRE( address->location.has_value() );
+        CHECK_THAT( address->location->accuracy, Catch::Matchers::WithinAbs( 0.012, 1e-9 ) );
+      }
+
+      THEN( "A single connection is reused" )
+      {
+        CHECK( server.requests() == 20 );
+        CHECK( server.connections() == 1 );
+        CHECK( client.sessions() == 1 );
+      }
+    }
+
+    AND_WHEN( "Looking up coordinates for an address" )
+    {
+      const auto client = spt::geocode::Client{ ptest::options( server, 1 ) };
+      const auto point = client.fromAddress( "565 5 Ave, Manhattan, New York, NY, USA" );
+      REQUIRE( point.has_value() );
+      CHECK_THAT( point->latitude, Catch::Matchers::WithinAbs( 40.755884, 1e-9 ) );
+      CHECK_THAT( point->longitude, Catch::Matchers::WithinAbs( -73.978504, 1e-9 ) );
+
+      const auto address = client.address( spt::geocode::Point{ .latitude = 41.92, .longitude = -87.69 } );
+      REQUIRE( address.has_value() );
+      CHECK( server.connections() == 1 );
+
+      CHECK_FALSE( client.fromAddress( std::string{} ).has_value() );
+      CHECK( server.requests() == 2 );
+    }
+
+    AND_WHEN( "Making concurrent lookups from several threads" )
+    {
+      const auto client = spt::geocode::Client{ ptest::options( server, 2 ) };
+      auto failures = std::atomic<int>{ 0 };
+      auto threads = std::vector<std::thread>{};
+      for ( int t = 0; t < 4; ++t )
+      {
+        threads.emplace_back( [&client, &failures]
+        {
+          for ( int i = 0; i < 10; ++i ) if ( !client.address( 41.92, -87.69 ).has_value() ) ++failures;
+        } );
+      }
+      for ( auto& thread : threads ) thread.join();
+
+      THEN( "No more connections than the pool size are opened" )
+      {
+        CHECK( failures == 0 );
+        CHECK( server.requests() == 40 );
+        CHECK( server.connections() <= 2 );
+        CHECK( server.concurrency() <= 2 );
+        CHECK( client.sessions() <= 2 );
+      }
+    }
+
+    AND_WHEN( "Caching reverse lookups by Open Location Code cell" )
+    {
+      auto opts = ptest::options( server, 2 );
+      opts.reverseCache = spt::geocode::ReverseCacheOptions{};
+      const auto client = spt::geocode::Client{ opts };
+
+      // All within the same 10 digit cell.
+      for ( int i = 0; i < 50; ++i )
+      {
+        const auto latitude = 41.92151 + i * 1e-6;
+        const auto address = client.address( latitude, -87.69531 );
+        REQUIRE( address.has_value() );
+        CHECK( address->city == "Chicago" );
+        REQUIRE( address->location.has_value() );
+        CHECK( address->location->latitude == latitude );
+      }
+      CHECK( client.addressAsync( 41.92152, -87.69531 ).get().has_value() );
+
+      THEN( "Only the first lookup is sent" )
+      {
+        CHECK( server.requests() == 1 );
+        const auto stats = client.reverseCacheStats();
+        CHECK( stats.hits == 50 );
+        CHECK( stats.misses == 1 );
+        CHECK( stats.entries == 1 );
+        CHECK( stats.bytes > 0 );
+      }
+
+      AND_THEN( "Locations in other cells are looked up" )
+      {
+        CHECK( client.address( 41.93, -87.69531 ).has_value() );
+        CHECK( server.requests() == 2 );
+        CHECK( client.reverseCacheStats().entries == 2 );
+      }
+    }
+
+    AND_WHEN( "Caching reverse lookups by Hilbert cell" )
+    {
+      auto opts = ptest::options( server, 1 );
+      opts.reverseCache = spt::geocode::ReverseCacheOptions{ .cell = spt::geocode::ReverseCacheOptions::Cell::Hilbert, .level = 20 };
+      const auto client = spt::geocode::Client{ opts };
+
+      for ( int i = 0; i < 50; ++i ) CHECK( client.address( 41.92151 + i * 1e-6, -87.69531 ).has_value() );
+      CHECK( server.requests() == 1 );
+      CHECK( client.reverseCacheStats().hits == 49 );
+    }
+
+    AND_WHEN( "Errors are not cached" )
+    {
+      auto opts = ptest::options( server, 1 );
+      opts.key = "invalid";
+      opts.reverseCache = spt::geocode::ReverseCacheOptions{};
+      const auto client = spt::geocode::Client{ opts };
+
+      CHECK_FALSE( client.address( 41.92, -87.69 ).has_value() );
+      CHECK_FALSE( client.address( 41.92, -87.69 ).has_value() );
+      CHECK( server.requests() == 2 );
+      CHECK( client.reverseCacheStats().entries == 0 );
+    }
+
+    AND_WHEN( "Caching forward lookups" )
+    {
+      auto opts = ptest::options( server, 2 );
+      opts.forwardCache = spt::geocode::ForwardCacheOptions{};
+      const auto client = spt::geocode::Client{ opts };
+
+      const auto first = client.fromAddress( "565 5 Ave, Manhattan, New York, NY, USA" );
+      const auto second = client.fromAddress( "565 Fifth Avenue,  MANHATTAN, New York NY, usa." );
+      const auto third = client.fromAddressAsync( "565 5th ave manhattan new york ny usa" ).get();
+
+      THEN( "Differently written forms of the address share one lookup" )
+      {
+        REQUIRE( first.has_value() );
+        REQUIRE( second.has_value() );
+        REQUIRE( third.has_value() );
+        CHECK( second->latitude == first->latitude );
+        CHECK( third->longitude == first->longitude );
+        CHECK( server.requests() == 1 );
+
+        const auto stats = client.forwardCacheStats();
+        CHECK( stats.hits == 2 );
+        CHECK( stats.misses == 1 );
+        CHECK( stats.entries == 1 );
+      }
+
+      AND_THEN( "Addresses without results are cached" )
+      {
+        CHECK( client.fromAddress( "nowhere" ).error() == "Empty response data" );
+        CHECK( client.fromAddress( "NOWHERE!" ).error() == "Empty response data" );
+        CHECK( server.requests() == 2 );
+        CHECK( client.forwardCacheStats().entries == 2 );
+      }
+    }
+
+    AND_WHEN( "Negative results expire immediately" )
+    {
+      auto opts = ptest::options( server, 1 );
+      opts.forwardCache = spt::geocode::ForwardCacheOptions{ .negativeTtl = std::chrono::seconds{ 0 } };
+      const auto client = spt::geocode::Client{ opts };
+
+      CHECK_FALSE( client.fromAddress( "nowhere" ).has_value() );
+      CHECK_FALSE( client.fromAddress( "nowhere" ).has_value() );
+      CHECK( client.fromAddress( "565 5 Ave" ).has_value() );
+      CHECK( client.fromAddress( "565 5 Ave" ).has_value() );
+      CHECK( server.requests() == 3 );
+      CHECK( client.forwardCacheStats().expirations == 1 );
+    }
+
+    AND_WHEN( "Errors other than missing results are not cached" )
+    {
+      auto opts = ptest::options( server, 1 );
+      opts.key = "invalid";
+      opts.forwardCache = spt::geocode::ForwardCacheOptions{};
+      const auto client = spt::geocode::Client{ opts };
+
+      CHECK_FALSE( client.fromAddress( "565 5 Ave" ).has_value() );
+      CHECK_FALSE( client.fromAddress( "565 5 Ave" ).has_value() );
+      CHECK( server.requests() == 2 );
+      CHECK( client.forwardCacheStats().entries == 0 );
+    }
+
+    AND_WHEN( "Using an invalid key" )
+    {
+      auto opts = ptest::options( server, 1 );
+      opts.key = "invalid";
+      const auto client = spt::geocode::Client{ opts };
+      const auto address = client.address( 41.92, -87.69 );
+      REQUIRE_FALSE( address.has_value() );
+      CHECK( address.error().contains( "invalid_access_key" ) );
+
+      // Error responses do not close the connection.
+      CHECK( client.address( 41.92, -87.69 ).error().contains( "invalid_access_key" ) );
+      CHECK( server.connections() == 1 );
+    }
+  }
+
+  GIVEN( "A mock positionstack server that responds slowly" )
+  {
+    auto server = spt::geocode::test::MockServer{ ptest::positionstack, std::chrono::milliseconds{ 500 } };
+
+    WHEN( "The request timeout is shorter than the response time" )
+    {
+      auto opts = ptest::options( server, 1 );
+      opts.timeout = std::chrono::milliseconds{ 100 };
+      const auto client = spt::geocode::Client{ opts };
+      const auto address = client.address( 41.92, -87.69 );
+      REQUIRE_FALSE( address.has_value() );
+      CHECK_FALSE( address.error().empty() );
+    }
+  }
+
+  GIVEN( "A mock positionstack server that takes 100ms per request" )
+  {
+    auto server = spt::geocode::test::MockServer{ ptest::positionstack, std::chrono::milliseconds{ 100 } };
+
+    WHEN( "Making asynchronous lookups" )
+    {
+      auto opts = ptest::options( server, 4 );
+      opts.maxInFlight = 4;
+      const auto client = spt::geocode::Client{ opts };
+
+      auto addresses = std::vector<std::future<std::expected<spt::geocode::Address, std::string>>>{};
+      auto points = std::vector<std::future<std::expected<spt::geocode::Point, std::string>>>{};
+      for ( int i = 0; i < 8; ++i )
+      {
+        addresses.push_back( client.addressAsync( 41.92, -87.69 ) );
+        points.push_back( client.fromAddressAsync( "565 5 Ave, Manhattan, New York, NY, USA" ) );
+      }
+
+      auto failures = 0;
+      for ( auto& future : addresses ) if ( const auto address = future.get(); !address || address->city != "Chicago" ) ++failures;
+      for ( auto& future : points ) if ( const auto point = future.get(); !point || point->latitude != 40.755884 ) ++failures;
+
+      THEN( "The lookups run concurrently up to the in-flight limit" )
+      {
+        CHECK( failures == 0 );
+        CHECK( server.requests() == 16 );
+        CHECK( server.concurrency() > 1 );
+        CHECK( server.concurrency() <= 4 );
+        CHECK( server.connections() <= 4 );
+      }
+    }
+
+    AND_WHEN( "Awaiting lookups in a coroutine" )
+    {
+      const auto client = spt::geocode::Client{ ptest::options( server, 2 ) };
+      auto promise = std::promise<std::pair<std::string, double>>{};
+      auto future = promise.get_future();
+      ptest::lookup( client, promise );
+
+      const auto [city, latitude] = future.get();
+      CHECK( city == "Chicago" );
+      CHECK_THAT( latitude, Catch::Matchers::WithinAbs( 40.755884, 1e-9 ) );
+      CHECK( server.requests() == 2 );
+    }
+  }
+
+  GIVEN( "A mock positionstack server that answers batch requests" )
+  {
+    auto server = spt::geocode::test::MockServer{ ptest::batch, std::chrono::milliseconds{ 50 } };
+
+    WHEN( "Looking up addresses for a set of points" )
+    {
+      auto opts = ptest::options( server, 4 );
+      opts.batchSize = 10;
+      const auto client = spt::geocode::Client{ opts };
+
+      auto points = std::vector<spt::geocode::Point>{};
+      for ( int i = 0; i < 95; ++i ) points.push_back( { .latitude = 1.0 + i, .longitude = -87.25 } );
+      points[42] = spt::geocode::Point{};
+
+      const auto addresses = client.addresses( points );
+
+      THEN( "Results are returned in input order, with an error for the point without an address" )
+      {
+        REQUIRE( addresses.size() == points.size() );
+        for ( std::size_t i = 0; i < points.size(); ++i )
+        {
+          if ( i == 42 )
+          {
+            REQUIRE_FALSE( addresses[i].has_value() );
+            CHECK( addresses[i].error() == "Empty response data" );
+            continue;
+          }
+
+          REQUIRE( addresses[i].has_value() );
+          CHECK( addresses[i]->city == "Chicago" );
+          CHECK( addresses[i]->text == std::format( "{},{}", points[i].latitude, points[i].longitude ) );
+          REQUIRE( addresses[i]->location.has_value() );
+          CHECK( addresses[i]->location->latitude == points[i].latitude );
+        }
+      }
+
+      AND_THEN( "The points are sent in concurrent batch requests" )
+      {
+        CHECK( server.requests() == 10 );
+        CHECK( server.concurrency() > 1 );
+        CHECK( server.concurrency() <= 4 );
+      }
+    }
+
+    AND_WHEN( "Looking up coordinates for a set of addresses" )
+    {
+      auto opts = ptest::options( server, 2 );
+      opts.batchSize = 10;
+      const auto client = spt::geocode::Client{ opts };
+
+      auto addresses = std::vector<std::string>{};
+      for ( int i = 0; i < 25; ++i ) addresses.push_back( std::format( "address {}", i ) );
+      addresses[3].clear();
+      addresses[7] = "unknown";
+
+      const auto points = client.fromAddresses( addresses );
+      REQUIRE( points.size() == addresses.size() );
+      CHECK( points[3].error() == "Empty address" );
+      CHECK( points[7].error() == "Empty response data" );
+      for ( std::size_t i = 0; i < points.size(); ++i )
+      {
+        if ( i == 3 || i == 7 ) continue;
+        REQUIRE( points[i].has_value() );
+        CHECK( points[i]->latitude == static_cast<double>( i ) + 0.5 );
+      }
+      CHECK( server.requests() == 3 );
+      CHECK( client.fromAddresses( {} ).empty() );
+    }
+
+    AND_WHEN( "Looking up a set of points with a reverse cache" )
+    {
+      auto opts = ptest::options( server, 2 );
+      opts.reverseCache = spt::geocode::ReverseCacheOptions{};
+      const auto client = spt::geocode::Client{ opts };
+
+      auto points = std::vector<spt::geocode::Point>{};
+      for ( int i = 0; i < 30; ++i ) points.push_back( { .latitude = 40.0 + i % 3, .longitude = -87.25 } );
+
+      const auto first = client.addresses( points );
+      const auto second = client.addresses( points );
+
+      THEN( "Each cell is looked up once" )
+      {
+        for ( std::size_t i = 0; i < points.size(); ++i )
+        {
+          REQUIRE( first[i].has_value() );
+          REQUIRE( second[i].has_value() );
+          CHECK( first[i]->text == std::format( "{},{}", points[i].latitude, points[i].longitude ) );
+          CHECK( second[i]->text == first[i]->text );
+        }
+
+        CHECK( server.requests() == 1 );
+        const auto stats = client.reverseCacheStats();
+        CHECK( stats.entries == 3 );
+        CHECK( stats.hits == 30 );
+        CHECK( stats.misses == 30 );
+      }
+    }
+
+    AND_WHEN( "Looking up a set of addresses with a forward cache" )
+    {
+      auto opts = ptest::options( server, 2 );
+      opts.forwardCache = spt::geocode::ForwardCacheOptions{};
+      const auto client = spt::geocode::Client{ opts };
+
+      const auto addresses = std::vector<std::string>{ "address 1", "ADDRESS 1", "address  1!", "address 2", "unknown", "Unknown" };
+      const auto first = client.fromAddresses( addresses );
+      const auto second = client.fromAddresses( addresses );
+
+      THEN( "Each normalised address is looked up once" )
+      {
+        for ( const auto& results : { first, second } )
+        {
+          REQUIRE( results.size() == addresses.size() );
+          for ( std::size_t i = 0; i < 3; ++i )
+          {
+            REQUIRE( results[i].has_value() );
+            CHECK( results[i]->latitude == 1.5 );
+          }
+          REQUIRE( results[3].has_value() );
+          CHECK( results[3]->latitude == 2.5 );
+          CHECK( results[4].error() == "Empty response data" );
+          CHECK( results[5].error() == "Empty response data" );
+        }
+
+        CHECK( server.requests() == 1 );
+        const auto stats = client.forwardCacheStats();
+        CHECK( stats.entries == 3 );
+        CHECK( stats.hits == 6 );
+      }
+    }
+
+    AND_WHEN( "Making a single lookup after a batch with one session" )
+    {
+      const auto client = spt::geocode::Client{ ptest::options( server, 1 ) };
+      const auto points = std::vector<spt::geocode::Point>{ { .latitude = 41.5, .longitude = -87.25 }, { .latitude = 42.5, .longitude = -87.25 } };
+      const auto addresses = client.addresses( points );
+      REQUIRE( addresses.size() == 2 );
+      CHECK( addresses[0].has_value() );
+
+      const auto address = client.address( 41.9215927, -87.6953278 );
+      REQUIRE( address.has_value() );
+      CHECK( address->postalCode == "60647" );
+
+      THEN( "The lookup is a GET without the body or headers of the batch" )
+      {
+        const auto received = server.received();
+        REQUIRE( received.size() == 2 );
+        CHECK( received[0].method == "POST" );
+        CHECK( received[0].headers.contains( "Content-Type: application/json" ) );
+        CHECK( received[1].method == "GET" );
+        CHECK( received[1].target.starts_with( "/v1/reverse" ) );
+        CHECK( received[1].body.empty() );
+        CHECK_FALSE( received[1].headers.contains( "Content-Type" ) );
+        CHECK_FALSE( received[1].headers.contains( "Content-Length" ) );
+        CHECK( client.sessions() == 1 );
+      }
+    }
+
+    AND_WHEN( "A batch request fails" )
+    {
+      auto opts = ptest::options( server, 1 );
+      opts.key = "invalid";
+      const auto client = spt::geocode::Client{ opts };
+      const auto points = std::vector<spt::geocode::Point>( 3, spt::geocode::Point{ .latitude = 41.92, .longitude = -87.69 } );
+      const auto addresses = client.addresses( points );
+
+      REQUIRE( addresses.size() == 3 );
+      for ( const auto& address : addresses )
+      {
+        REQUIRE_FALSE( address.has_value() );
+        CHECK( address.error().contains( "invalid_access_key" ) );
+      }
+    }
+  }
+
+  GIVEN( "No server listening" )
+  {
+    auto port = std::uint16_t{ 0 };
+    {
+      auto server = spt::geocode::test::MockServer{ ptest::positionstack };
+      port = server.port();
+    }
+
+    WHEN( "Looking up an address" )
+    {
+      auto opts = spt::geocode::ClientOptions{};
+      opts.key = "test";
+      opts.baseUrl = std::format( "http://127.0.0.1:{}/v1", port );
+      const auto client = spt::geocode::Client{ opts };
+      const auto address = client.address( 41.92, -87.69 );
+      REQUIRE_FALSE( address.has_value() );
+      CHECK_FALSE( address.error().empty() );
+    }
+  }
+}
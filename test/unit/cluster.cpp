@@ -6,6 +6,8 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include "../../src/lib/geocode/geocode.hpp"
 
+#include <cmath>
+
 namespace
 {
   namespace itest
@@ -101,6 +103,34 @@ SCENARIO( "Clustering test suite", "[cluster]" )
     const auto clustered = spt::geocode::cluster( points, 32, 3 );
     REQUIRE( clustered.size() > 1 );
     CHECK( clustered[0].points.size() > 2 );
+
+    AND_THEN( "Cluster statistics are populated from the final assignment" )
+    {
+      for ( const auto& c : clustered )
+      {
+        if ( c.points.empty() )
+        {
+          CHECK_FALSE( c.statistics.has_value() );
+          continue;
+        }
+
+        REQUIRE( c.statistics.has_value() );
+
+        auto radius = 0.0;
+        auto total = 0.0;
+        for ( const auto& p : c.points )
+        {
+          CHECK( c.statistics->bounds.contains( p->latitude, p->longitude ) );
+          // The distance is not a number when the centroid coincides with the point.
+          auto d = spt::geocode::distance( c.centroid, *p ).distance;
+          if ( std::isnan( d ) ) d = 0.0;
+          radius = std::max( radius, d );
+          total += d;
+        }
+        CHECK_THAT( c.statistics->radius, Catch::Matchers::WithinAbs( radius, 0.001 ) );
+        CHECK_THAT( c.statistics->meanDistance, Catch::Matchers::WithinAbs( total / static_cast<double>( c.points.size() ), 0.001 ) );
+      }
+    }
   }
 
   GIVEN( "An empty set of geo coordinates" )
@@ -118,5 +148,8 @@ SCENARIO( "Clustering test suite", "[cluster]" )
     REQUIRE( clustered.size() == 1 );
     CHECK_THAT( clustered.front().centroid.latitude, Catch::Matchers::WithinAbs( points.front().latitude, 0.0001 ) );
     CHECK_THAT( clustered.front().centroid.longitude, Catch::Matchers::WithinAbs( points.front().longitude, 0.0001 ) );
+    REQUIRE( clustered.front().statistics.has_value() );
+    CHECK( clustered.front().points.size() == 1 );
+    CHECK( clustered.front().statistics->radius == 0.0 );
   }
 }
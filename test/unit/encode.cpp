@@ -3,8 +3,15 @@
 //
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include "../../src/lib/geocode/geocode.hpp"
+#include "../../src/lib/geocode/impl/codearea.hpp"
+#include "../../src/lib/geocode/impl/openlocationcode.hpp"
+
+#include <array>
+#include <random>
+#include <unordered_set>
 
 using std::operator ""sv;
 
@@ -38,4 +45,398 @@ SCENARIO( "Open Location Code suite", "[olc]" )
     CHECK_THAT( p.value().latitude, Catch::Matchers::WithinAbs( point.latitude, 0.0001 ) );
     CHECK_THAT( p.value().longitude, Catch::Matchers::WithinAbs( point.longitude, 0.0001 ) );
   }
-}
\ No newline at end of file
+}
+
+SCENARIO( "Open Location Code into caller buffers", "[olc]" )
+{
+  GIVEN( "Geo-coordinates with known codes at several lengths" )
+  {
+    const auto point = spt::geocode::Point{ .latitude = -41.2730625, .longitude = 174.7859375 };
+
+    WHEN( "Encoding into a buffer" )
+    {
+      auto buffer = std::array<char, spt::geocode::FixedCode::capacity>{};
+      auto n = spt::geocode::toLocationCode( point.latitude, point.longitude, buffer );
+      CHECK( std::string_view{ buffer.data(), n } == "4VCPPQGP+Q9"sv );
+
+      n = spt::geocode::toLocationCode( point.latitude, point.longitude, buffer, 4 );
+      CHECK( std::string_view{ buffer.data(), n } == "4VCP0000+"sv );
+
+      n = spt::geocode::toLocationCode( point.latitude, point.longitude, buffer, 15 );
+      CHECK( std::string_view{ buffer.data(), n } == "4VCPPQGP+Q9GCCCC"sv );
+    }
+
+    AND_WHEN( "Encoding with lengths that are not valid code lengths" )
+    {
+      auto buffer = std::array<char, spt::geocode::FixedCode::capacity>{};
+      auto n = spt::geocode::toLocationCode( point.latitude, point.longitude, buffer, 0 );
+      CHECK( std::string_view{ buffer.data(), n } == "4V000000+"sv );
+
+      n = spt::geocode::toLocationCode( 90.0, 0.0, buffer, 1 );
+      CHECK( std::string_view{ buffer.data(), n } == "CF000000+"sv );
+
+      n = spt::geocode::toLocationCode( point.latitude, point.longitude, buffer, 7 );
+      CHECK( std::string_view{ buffer.data(), n } == "4VCPPQGP+"sv );
+
+      n = spt::geocode::toLocationCode( point.latitude, point.longitude, buffer, 9 );
+      CHECK( std::string_view{ buffer.data(), n } == "4VCPPQGP+Q9"sv );
+      CHECK( spt::geocode::locationCodeSize( 9 ) == 11 );
+      CHECK( spt::geocode::FixedCode{ 90.0, 0.0, 0 }.view() == "CF000000+"sv );
+    }
+
+    AND_WHEN( "Encoding into a buffer that is too small" )
+    {
+      auto buffer = std::array<char, 10>{};
+      CHECK( spt::geocode::toLocationCode( point.latitude, point.longitude, buffer, 11 ) == 0 );
+      CHECK( spt::geocode::toLocationCode( point.latitude, point.longitude, buffer, 8 ) == 9 );
+    }
+
+    AND_WHEN( "Encoding as a fixed code" )
+    {
+      const auto code = spt::geocode::FixedCode{ point };
+      CHECK( code.view() == "4VCPPQGP+Q9"sv );
+      CHECK( code == spt::geocode::FixedCode{ "4VCPPQGP+Q9"sv } );
+      CHECK( spt::geocode::FixedCode{ 90.0, -180.0, 11 }.view() == "C2X2X2X2+X2R"sv );
+      CHECK( spt::geocode::FixedCode{ 47.0000625, 8.0000625, 15 }.view() == "8FVC2222+22GCCCC"sv );
+      CHECK( spt::geocode::FixedCode{}.empty() );
+    }
+  }
+
+  GIVEN( "Random geo-coordinates" )
+  {
+    auto engine = std::mt19937_64{ 38 };
+    auto latitude = std::uniform_real_distribution<double>{ -90.0, 90.0 };
+    auto longitude = std::uniform_real_distribution<double>{ -180.0, 180.0 };
+
+    WHEN( "Comparing fixed codes with string codes" )
+    {
+      auto codes = std::unordered_set<spt::geocode::FixedCode>{};
+      for ( int i = 0; i < 10000; ++i )
+      {
+        const auto lat = latitude( engine );
+        const auto lng = longitude( engine );
+        const auto code = spt::geocode::FixedCode{ lat, lng };
+        CHECK( code.view() == spt::geocode::toLocationCode( lat, lng ) );
+        codes.insert( code );
+      }
+      CHECK( codes.size() == 10000 );
+    }
+  }
+}
+
+SCENARIO( "Open Location Code batch encoding", "[olc]" )
+{
+  GIVEN( "Random geo-coordinates and edge cases" )
+  {
+    auto engine = std::mt19937_64{ 39 };
+    auto latitude = std::uniform_real_distribution<double>{ -91.0, 91.0 };
+    auto longitude = std::uniform_real_distribution<double>{ -200.0, 200.0 };
+    auto latitudes = std::vector<double>{ 90.0, -90.0, 0.0, 47.0000625, 89.9999999999, -41.2730625 };
+    auto longitudes = std::vector<double>{ 180.0, -180.0, 0.0, 8.0000625, 540.0, 174.7859375 };
+    for ( int i = 0; i < 100000; ++i )
+    {
+      latitudes.push_back( latitude( engine ) );
+      longitudes.push_back( longitude( engine ) );
+    }
+
+    WHEN( "Encoding at each code length" )
+    {
+      for ( std::size_t length : { 0, 3, 4, 8, 9, 10, 11, 13, 15 } )
+      {
+        const auto width = spt::geocode::locationCodeSize( length );
+        auto out = std::vector<char>( latitudes.size() * width );
+        REQUIRE( spt::geocode::encodeBatch( latitudes, longitudes, out, length ) == latitudes.size() );
+
+        std::size_t mismatches{ 0 };
+        for ( std::size_t i = 0; i < latitudes.size(); ++i )
+        {
+          auto buffer = std::array<char, spt::geocode::FixedCode::capacity>{};
+          const auto n = spt::geocode::toLocationCode( latitudes[i], longitudes[i], buffer, length );
+          if ( std::string_view{ buffer.data(), n } != std::string_view{ out.data() + i * width, width } ) ++mismatches;
+        }
+        CHECK( mismatches == 0 );
+      }
+    }
+
+    AND_WHEN( "The output buffer is smaller than the input" )
+    {
+      auto out = std::vector<char>( 10 * spt::geocode::locationCodeSize( 10 ) + 5 );
+      CHECK( spt::geocode::encodeBatch( latitudes, longitudes, out ) == 10 );
+      CHECK( std::string_view{ out.data() + 33, 11 } == "8FVC2222+22"sv );
+    }
+  }
+}
+
+SCENARIO( "Open Location Code single pass decoding", "[olc]" )
+{
+  GIVEN( "Codes with known areas" )
+  {
+    WHEN( "Decoding a code with pair digits only" )
+    {
+      const auto area = spt::geocode::decodeLocationCode( "8FVC2222+22"sv );
+      REQUIRE( area.has_value() );
+      CHECK_THAT( area->bounds.minLatitude, Catch::Matchers::WithinAbs( 47.0, 1e-12 ) );
+      CHECK_THAT( area->bounds.minLongitude, Catch::Matchers::WithinAbs( 8.0, 1e-12 ) );
+      CHECK_THAT( area->bounds.maxLatitude, Catch::Matchers::WithinAbs( 47.000125, 1e-12 ) );
+      CHECK_THAT( area->bounds.maxLongitude, Catch::Matchers::WithinAbs( 8.000125, 1e-12 ) );
+      CHECK_THAT( area->centre.latitude, Catch::Matchers::WithinAbs( 47.0000625, 1e-12 ) );
+      CHECK_THAT( area->centre.longitude, Catch::Matchers::WithinAbs( 8.0000625, 1e-12 ) );
+      CHECK( area->length == 10 );
+    }
+
+    AND_WHEN( "Decoding padded, grid and lower case codes" )
+    {
+      const auto padded = spt::geocode::decodeLocationCode( "8FVC0000+"sv );
+      REQUIRE( padded.has_value() );
+      CHECK_THAT( padded->bounds.maxLatitude - padded->bounds.minLatitude, Catch::Matchers::WithinAbs( 1.0, 1e-12 ) );
+      CHECK( padded->length == 4 );
+
+      const auto grid = spt::geocode::decodeLocationCode( "8FVC2222+22GCCCC"sv );
+      REQUIRE( grid.has_value() );
+      CHECK_THAT( grid->bounds.maxLatitude - grid->bounds.minLatitude, Catch::Matchers::WithinAbs( 0.000125 / 3125, 1e-14 ) );
+      CHECK_THAT( grid->bounds.maxLongitude - grid->bounds.minLongitude, Catch::Matchers::WithinAbs( 0.000125 / 1024, 1e-14 ) );
+      CHECK( grid->length == 15 );
+
+      const auto lower = spt::geocode::decodeLocationCode( "8fvc2222+22"sv );
+      REQUIRE( lower.has_value() );
+      CHECK( lower->bounds.minLatitude == 47.0 );
+    }
+
+    AND_WHEN( "Decoding invalid and short codes" )
+    {
+      for ( const auto code : { ""sv, "+"sv, "8FVC2222"sv, "8FVC2222+2"sv, "8FVC2222++22"sv, "8FV00000+"sv, "8FVC0000+22"sv,
+        "80000000+"sv, "8FVC22O2+22"sv, "8FVC2222+0"sv, "X2X2X2X2+"sv, "2X2X2X2X+"sv, "8FVC222+22"sv } )
+      {
+        const auto area = spt::geocode::decodeLocationCode( code );
+        CHECK_FALSE( area.has_value() );
+      }
+
+      const auto area = spt::geocode::decodeLocationCode( "9G8F+6X"sv );
+      REQUIRE_FALSE( area.has_value() );
+      CHECK( area.error().starts_with( "Short code" ) );
+      CHECK_FALSE( spt::geocode::fromLocationCode( "9G8F+6X"sv ).has_value() );
+    }
+  }
+
+  GIVEN( "Random geo-coordinates" )
+  {
+    auto engine = std::mt19937_64{ 40 };
+    auto latitude = std::uniform_real_distribution<double>{ -90.0, 90.0 };
+    auto longitude = std::uniform_real_distribution<double>{ -180.0, 180.0 };
+
+    WHEN( "Decoding the codes for the points" )
+    {
+      std::size_t outside{ 0 };
+      for ( int i = 0; i < 10000; ++i )
+      {
+        const auto lat = latitude( engine );
+        const auto lng = longitude( engine );
+        for ( std::size_t length : { 2, 4, 6, 8, 10, 11, 12, 15 } )
+        {
+          const auto code = spt::geocode::FixedCode{ lat, lng, length };
+          const auto area = spt::geocode::decodeLocationCode( code );
+          REQUIRE( area.has_value() );
+          CHECK( area->length == length );
+          if ( !area->bounds.contains( lat, lng ) || !area->bounds.contains( area->centre.latitude, area->centre.longitude ) ) ++outside;
+        }
+      }
+      CHECK( outside == 0 );
+    }
+
+    AND_WHEN( "Comparing with the reference decoder" )
+    {
+      std::size_t mismatches{ 0 };
+      for ( int i = 0; i < 10000; ++i )
+      {
+        const auto lat = latitude( engine );
+        const auto lng = longitude( engine );
+        for ( std::size_t length : { 2, 4, 6, 8, 10, 11, 12, 13, 14, 15 } )
+        {
+          const auto code = spt::geocode::FixedCode{ lat, lng, length };
+          const auto area = spt::geocode::decodeLocationCode( code );
+          const auto expected = openlocationcode::Decode( std::string{ code.view() } );
+          REQUIRE( area.has_value() );
+          if ( area->bounds.minLatitude != expected.GetLatitudeLo() || area->bounds.minLongitude != expected.GetLongitudeLo() ||
+            area->bounds.maxLatitude != expected.GetLatitudeHi() || area->bounds.maxLongitude != expected.GetLongitudeHi() ||
+            area->centre.latitude != expected.GetCenter().latitude || area->centre.longitude != expected.GetCenter().longitude ) ++mismatches;
+        }
+      }
+      CHECK( mismatches == 0 );
+    }
+  }
+}
+
+SCENARIO( "Open Location Code at compile time", "[olc]" )
+{
+  GIVEN( "Constant geo-coordinates and codes" )
+  {
+    static constexpr auto code = spt::geocode::FixedCode{ 47.0000625, 8.0000625 };
+    static_assert( code.view() == "8FVC2222+22"sv );
+    static_assert( spt::geocode::FixedCode{ 47.0000625, 8.0000625, 15 }.view() == "8FVC2222+22GCCCC"sv );
+    static_assert( spt::geocode::FixedCode{ 90.0, 540.0, 4 }.view() == "C2X20000+"sv );
+    static_assert( spt::geocode::FixedCode{ 90.0, 540.0, 1 }.view() == "C2000000+"sv );
+    static_assert( spt::geocode::decodeLocationCode( "8FVC2222+22"sv )->bounds.minLatitude == 47.0 );
+    static_assert( spt::geocode::decodeLocationCode( "8FVC2222+22"sv )->length == 10 );
+    static_assert( !spt::geocode::decodeLocationCode( "9G8F+6X"sv ).has_value() );
+
+    WHEN( "Comparing with the codes computed at runtime" )
+    {
+      auto latitude = 47.0000625;
+      auto longitude = 8.0000625;
+      CHECK( spt::geocode::FixedCode{ latitude, longitude } == code );
+      CHECK( spt::geocode::toLocationCode( latitude, longitude ) == code.view() );
+      CHECK( spt::geocode::FixedCode{ 90.0, 540.0, 4 } == spt::geocode::FixedCode{ 89.5, -180.0, 4 } );
+      CHECK( spt::geocode::decodeLocationCode( code )->bounds.minLongitude == 8.0 );
+    }
+  }
+}
+
+SCENARIO( "Open Location Code shortening and recovery", "[olc]" )
+{
+  GIVEN( "Codes with known short forms" )
+  {
+    WHEN( "Shortening full codes" )
+    {
+      const auto near = spt::geocode::LocationCodeReference{ 51.3701125, -1.217765625 };
+      CHECK( near.shorten( "9C3W9QCJ+2VX"sv )->view() == "+2VX"sv );
+      CHECK( spt::geocode::LocationCodeReference{ 51.3708675, -1.217765625 }.shorten( "9C3W9QCJ+2VX"sv )->view() == "CJ+2VX"sv );
+      CHECK( spt::geocode::LocationCodeReference{ 51.5, -1.0 }.shorten( "9C3W9QCJ+2VX"sv )->view() == "9QCJ+2VX"sv );
+      CHECK( spt::geocode::LocationCodeReference{ 52.5, -1.0 }.shorten( "9C3W9QCJ+2VX"sv )->view() == "9C3W9QCJ+2VX"sv );
+      CHECK( spt::geocode::LocationCodeReference{ 42.899, 9.012 }.shorten( "8FJFW222+"sv )->view() == "22+"sv );
+      CHECK( near.shorten( "9C3W0000+"sv )->view() == "9C3W0000+"sv );
+      CHECK( near.shorten( "9C3W+2V"sv ).error() == "Only full codes can be shortened" );
+      CHECK( near.shorten( "9C3W9QCJ+2"sv ).error() == "Invalid code" );
+    }
+
+    AND_WHEN( "Recovering short codes" )
+    {
+      CHECK( spt::geocode::LocationCodeReference{ 51.3701125, -1.217765625 }.recover( "+2VX"sv )->view() == "9C3W9QCJ+2VX"sv );
+      CHECK( spt::geocode::LocationCodeReference{ 51.3, -1.2 }.recover( "9QCJ+2VX"sv )->view() == "9C3W9QCJ+2VX"sv );
+      CHECK( spt::geocode::LocationCodeReference{ 0.0, 179.99 }.recover( "22+22"sv )->view() == "62G22222+22"sv );
+      CHECK( spt::geocode::LocationCodeReference{ 0.001, 180.001 }.recover( "22+"sv )->view() == "62G22222+"sv );
+      CHECK( spt::geocode::LocationCodeReference{ -81.0, 0.0 }.recover( "XQP5+"sv )->view() == "2CCXXQP5+"sv );
+      CHECK( spt::geocode::LocationCodeReference{ 89.9999, 0.0 }.recover( "xxxx+xx"sv )->view() == "CCXXXXXX+XX"sv );
+      CHECK( spt::geocode::LocationCodeReference{ 0.0, 0.0 }.recover( "2cxxxxxx+xx"sv )->view() == "2CXXXXXX+XX"sv );
+      CHECK( spt::geocode::LocationCodeReference{ 0.0, 0.0 }.recover( "2CXX+X"sv ).error() == "Invalid code" );
+    }
+  }
+
+  GIVEN( "A batch of codes around a depot" )
+  {
+    const auto depot = spt::geocode::Point{ .latitude = 41.8781, .longitude = -87.6298 };
+    auto engine = std::mt19937_64{ 43 };
+    auto offset = std::uniform_real_distribution<double>{ -0.05, 0.05 };
+
+    auto full = std::vector<std::string>{};
+    for ( int i = 0; i < 10000; ++i )
+    {
+      full.push_back( spt::geocode::toLocationCode( depot.latitude + offset( engine ), depot.longitude + offset( engine ) ) );
+    }
+    full.emplace_back( "invalid" );
+
+    WHEN( "Shortening and recovering the batch" )
+    {
+      auto shortened = std::vector<std::expected<spt::geocode::FixedCode, std::string>>( full.size() );
+      REQUIRE( spt::geocode::shortenLocationCodes( depot, std::span<const std::string>{ full }, shortened ) == full.size() );
+      CHECK_FALSE( shortened.back().has_value() );
+
+      auto codes = std::vector<std::string_view>{};
+      for ( std::size_t i = 0; i + 1 < shortened.size(); ++i )
+      {
+        REQUIRE( shortened[i].has_value() );
+        codes.push_back( shortened[i]->view() );
+      }
+      CHECK( std::ranges::all_of( codes, []( std::string_view code ) { return code.size() < 11; } ) );
+
+      auto recovered = std::vector<std::expected<spt::geocode::FixedCode, std::string>>( codes.size() );
+      REQUIRE( spt::geocode::recoverLocationCodes( depot, std::span<const std::string_view>{ codes }, recovered ) == codes.size() );
+
+      std::size_t mismatches{ 0 };
+      for ( std::size_t i = 0; i < recovered.size(); ++i )
+      {
+        if ( !recovered[i] || recovered[i]->view() != full[i] ) ++mismatches;
+      }
+      CHECK( mismatches == 0 );
+    }
+  }
+}
+
+SCENARIO( "Open Location Code encoding benchmark", "[.][benchmark][olc]" )
+{
+  auto engine = std::mt19937_64{ 38 };
+  auto latitude = std::uniform_real_distribution<double>{ -90.0, 90.0 };
+  auto longitude = std::uniform_real_distribution<double>{ -180.0, 180.0 };
+  auto points = std::vector<spt::geocode::Point>{};
+  for ( int i = 0; i < 1024; ++i ) points.push_back( spt::geocode::Point{ .latitude = latitude( engine ), .longitude = longitude( engine ) } );
+  std::size_t index{ 0 };
+
+  BENCHMARK( "toLocationCode as std::string" )
+  {
+    const auto& p = points[++index & 1023];
+    return spt::geocode::toLocationCode( p.latitude, p.longitude );
+  };
+
+  BENCHMARK( "toLocationCode into buffer" )
+  {
+    const auto& p = points[++index & 1023];
+    auto buffer = std::array<char, spt::geocode::FixedCode::capacity>{};
+    spt::geocode::toLocationCode( p.latitude, p.longitude, buffer );
+    return buffer;
+  };
+
+  BENCHMARK( "FixedCode" )
+  {
+    const auto& p = points[++index & 1023];
+    return spt::geocode::FixedCode{ p.latitude, p.longitude };
+  };
+
+  auto latitudes = std::vector<double>{};
+  auto longitudes = std::vector<double>{};
+  for ( const auto& p : points )
+  {
+    latitudes.push_back( p.latitude );
+    longitudes.push_back( p.longitude );
+  }
+  auto out = std::vector<char>( points.size() * spt::geocode::locationCodeSize( 10 ) );
+
+  BENCHMARK( "encodeBatch of 1024 points" )
+  {
+    return spt::geocode::encodeBatch( latitudes, longitudes, out );
+  };
+
+  auto codes = std::vector<std::string>{};
+  for ( const auto& p : points ) codes.push_back( spt::geocode::toLocationCode( p ) );
+
+  BENCHMARK( "decodeLocationCode" )
+  {
+    return spt::geocode::decodeLocationCode( codes[++index & 1023] );
+  };
+
+  auto longCodes = std::vector<std::string>{};
+  for ( const auto& p : points ) longCodes.push_back( spt::geocode::FixedCode{ p.latitude, p.longitude, 15 }.str() );
+
+  BENCHMARK( "FixedCode with 15 digits" )
+  {
+    const auto& p = points[++index & 1023];
+    return spt::geocode::FixedCode{ p.latitude, p.longitude, 15 };
+  };
+
+  BENCHMARK( "decodeLocationCode with 15 digits" )
+  {
+    return spt::geocode::decodeLocationCode( longCodes[++index & 1023] );
+  };
+
+  const auto reference = spt::geocode::LocationCodeReference{ 41.8781, -87.6298 };
+  auto shortCodes = std::vector<std::string>{};
+  for ( const auto& p : points )
+  {
+    const auto lat = 41.8781 + ( p.latitude / 90.0 ) * 0.05;
+    const auto lng = -87.6298 + ( p.longitude / 180.0 ) * 0.05;
+    shortCodes.push_back( reference.shorten( spt::geocode::FixedCode{ lat, lng } )->str() );
+  }
+
+  BENCHMARK( "LocationCodeReference::recover" )
+  {
+    return reference.recover( shortCodes[++index & 1023] );
+  };
+}
@@ -0,0 +1,217 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/lib/geocode/fencefile.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <random>
+
+namespace
+{
+  namespace ptest
+  {
+    spt::geocode::Polygon star( double latitude, double longitude, double size, int vertices )
+    {
+      auto polygon = spt::geocode::Polygon{};
+      for ( int i = 0; i < vertices; ++i )
+      {
+        const auto angle = i * 2 * 3.14159265358979 / vertices;
+        const auto radius = size * ( 1 + 0.4 * std::sin( 5 * angle ) );
+        polygon.push_back( spt::geocode::Point{ latitude + radius * std::cos( angle ), longitude + radius * std::sin( angle ) } );
+      }
+      return polygon;
+    }
+
+    template <typename T>
+    T read( const std::filesystem::path& path, std::uint64_t offset )
+    {
+      auto value = T{};
+      auto in = std::ifstream{ path, std::ios::binary };
+      in.seekg( static_cast<std::streamoff>( offset ) );
+      in.read( reinterpret_cast<char*>( &value ), sizeof( value ) );
+      return value;
+    }
+
+    template <typename T>
+    void patch( const std::filesystem::path& path, std::uint64_t offset, T value )
+    {
+      auto out = std::fstream{ path, std::ios::binary | std::ios::in | std::ios::out };
+      out.seekp( static_cast<std::streamoff>( offset ) );
+      out.write( reinterpret_cast<const char*>( &value ), sizeof( value ) );
+    }
+  }
+}
+
+SCENARIO( "Memory mapped fence file test suite", "[fencefile]" )
+{
+  const auto path = std::filesystem::temp_directory_path() / "geocode-fencefile-test.bin";
+
+  GIVEN( "An index over a mix of prepared fences" )
+  {
+    auto fences = std::vector<spt::geocode::PreparedPolygon>{};
+    for ( int i = 0; i < 200; ++i )
+    {
+      const auto polygon = ptest::star( 40.0 + ( i % 20 ) * 0.05, -88.0 + ( i / 20 ) * 0.05, 0.04, 50 + i );
+      fences.emplace_back( polygon, i % 2 == 0 ? 0 : 8 );
+    }
+    fences.emplace_back( spt::geocode::Polygon{ { -20.0, 170.0 }, { -10.0, 170.0 }, { -10.0, -170.0 }, { -20.0, -170.0 } } );
+    fences.emplace_back( spt::geocode::Polygon{ { 1.0, 1.0 }, { 2.0, 2.0 } } );
+    fences.emplace_back( spt::geocode::PolygonWithHoles{
+      .outer = { { 30.0, 30.0 }, { 31.0, 30.0 }, { 31.0, 31.0 }, { 30.0, 31.0 } },
+      .holes = { { { 30.4, 30.4 }, { 30.6, 30.4 }, { 30.6, 30.6 }, { 30.4, 30.6 } } } }, 4 );
+    const auto index = spt::geocode::FenceIndex{ std::move( fences ) };
+
+    WHEN( "Writing and mapping the index" )
+    {
+      const auto written = spt::geocode::writeFenceFile( index, path );
+      REQUIRE( written.has_value() );
+
+      const auto mapped = spt::geocode::MappedFenceIndex::open( path );
+      REQUIRE( mapped.has_value() );
+      CHECK( mapped->bytes() == std::filesystem::file_size( path ) );
+      CHECK( mapped->index().size() == index.size() );
+      CHECK( mapped->index().fence( 1 ).gridSize() == 8 );
+
+      THEN( "Queries match the in memory index" )
+      {
+        auto engine = std::mt19937_64{ 3 };
+        auto latitude = std::uniform_real_distribution<double>{ 39.9, 41.1 };
+        auto longitude = std::uniform_real_distribution<double>{ -88.1, -87.4 };
+        auto mismatches = 0;
+        auto found = 0;
+        for ( int i = 0; i < 20'000; ++i )
+        {
+          const auto point = spt::geocode::Point{ latitude( engine ), longitude( engine ) };
+          auto expected = index.query( point );
+          auto actual = mapped->index().query( point );
+          std::ranges::sort( expected );
+          std::ranges::sort( actual );
+          if ( expected != actual ) ++mismatches;
+          if ( !actual.empty() ) ++found;
+        }
+        CHECK( found > 0 );
+        CHECK( mismatches == 0 );
+
+        CHECK( mapped->index().query( spt::geocode::Point{ -15.0, -175.0 } ) == std::vector<std::size_t>{ 200 } );
+        CHECK( mapped->index().query( spt::geocode::Point{ 30.2, 30.2 } ) == std::vector<std::size_t>{ 202 } );
+        CHECK( mapped->index().query( spt::geocode::Point{ 30.5, 30.5 } ).empty() );
+      }
+
+      AND_THEN( "A copy of the mapped index views the same data" )
+      {
+        const auto copy = mapped->index();
+        CHECK( copy.query( spt::geocode::Point{ 30.2, 30.2 } ) == std::vector<std::size_t>{ 202 } );
+      }
+    }
+  }
+
+  GIVEN( "Invalid files" )
+  {
+    std::filesystem::remove( path );
+    CHECK_FALSE( spt::geocode::MappedFenceIndex::open( path ).has_value() );
+
+    {
+      auto out = std::ofstream{ path, std::ios::binary };
+      out << "not a fence file, but long enough to hold a header of the expected size for the format";
+    }
+    const auto garbage = spt::geocode::MappedFenceIndex::open( path );
+    REQUIRE_FALSE( garbage.has_value() );
+    CHECK( garbage.error().find( "Not a fence file" ) != std::string::npos );
+
+    const auto index = spt::geocode::FenceIndex{ std::vector<spt::geocode::Polygon>{
+      { { 30.0, 30.0 }, { 31.0, 30.0 }, { 31.0, 31.0 }, { 30.0, 31.0 } } } };
+    REQUIRE( spt::geocode::writeFenceFile( index, path ).has_value() );
+    std::filesystem::resize_file( path, std::filesystem::file_size( path ) - 8 );
+    CHECK_FALSE( spt::geocode::MappedFenceIndex::open( path ).has_value() );
+  }
+
+  GIVEN( "Files with corrupt tree nodes or grids" )
+  {
+    // Offsets of the fields patched below, from the layout of the header, records and nodes.
+    constexpr std::uint64_t nodesOffset = 48;
+    constexpr std::uint64_t recordsOffset = 64;
+    constexpr std::uint64_t verticesCount = 32;
+    constexpr std::uint64_t cellsOffset = 72;
+    constexpr std::uint64_t cellOffsetsOffset = 80;
+    constexpr std::uint64_t nodeSize = 40;
+    constexpr std::uint64_t nodeFirst = 32;
+    constexpr std::uint64_t nodeCount = 36;
+
+    const auto error = [&path]
+    {
+      const auto mapped = spt::geocode::MappedFenceIndex::open( path );
+      return mapped.has_value() ? std::string{} : mapped.error();
+    };
+    const auto invalid = [&path]
+    {
+      const auto mapped = spt::geocode::MappedFenceIndex::open( path );
+      REQUIRE( mapped.has_value() );
+      const auto valid = mapped->validate();
+      return valid.has_value() ? std::string{} : valid.error();
+    };
+
+    auto fences = std::vector<spt::geocode::PreparedPolygon>{};
+    for ( int i = 0; i < 300; ++i ) fences.emplace_back( ptest::star( 40.0 + ( i % 20 ) * 0.05, -88.0 + ( i / 20 ) * 0.05, 0.04, 50 ), 4 );
+    const auto index = spt::geocode::FenceIndex{ std::move( fences ) };
+
+    WHEN( "A node has more children than the fanout" )
+    {
+      REQUIRE( spt::geocode::writeFenceFile( index, path ).has_value() );
+      const auto nodes = ptest::read<std::uint64_t>( path, 32 );
+      const auto root = ptest::read<std::uint64_t>( path, nodesOffset ) + ( nodes - 1 ) * nodeSize;
+      ptest::patch( path, root + nodeFirst, std::uint32_t{ 0 } );
+      ptest::patch( path, root + nodeCount, static_cast<std::uint32_t>( nodes - 1 ) );
+      CHECK( error().ends_with( "Invalid tree node" ) );
+    }
+
+    AND_WHEN( "The grid offsets decrease" )
+    {
+      REQUIRE( spt::geocode::writeFenceFile( index, path ).has_value() );
+      const auto record = ptest::read<std::uint64_t>( path, recordsOffset );
+      const auto offsets = ptest::read<std::uint64_t>( path, record + cellOffsetsOffset );
+      ptest::patch( path, offsets + sizeof( std::uint32_t ), std::numeric_limits<std::uint32_t>::max() );
+      CHECK( invalid().starts_with( "Invalid grid offsets" ) );
+    }
+
+    AND_WHEN( "A grid cell has unknown flags" )
+    {
+      REQUIRE( spt::geocode::writeFenceFile( index, path ).has_value() );
+      const auto record = ptest::read<std::uint64_t>( path, recordsOffset );
+      ptest::patch( path, ptest::read<std::uint64_t>( path, record + cellsOffset ), std::uint8_t{ 0xff } );
+      CHECK( invalid().starts_with( "Invalid grid cell" ) );
+    }
+
+    AND_WHEN( "A record has a vertex count that overflows the array size" )
+    {
+      REQUIRE( spt::geocode::writeFenceFile( index, path ).has_value() );
+      const auto record = ptest::read<std::uint64_t>( path, recordsOffset );
+      ptest::patch( path, record + verticesCount, std::uint64_t{ 0x2AAAAAAAAAAAAAAB } );
+      CHECK( error().ends_with( "Invalid vertex count" ) );
+    }
+
+    AND_WHEN( "The file is not corrupt" )
+    {
+      REQUIRE( spt::geocode::writeFenceFile( index, path ).has_value() );
+      CHECK( invalid().empty() );
+    }
+
+    AND_WHEN( "The file cannot be renamed into place" )
+    {
+      std::filesystem::remove( path );
+      std::filesystem::create_directories( path / "child" );
+      CHECK_FALSE( spt::geocode::writeFenceFile( index, path ).has_value() );
+
+      auto temporary = path;
+      temporary += ".tmp";
+      CHECK_FALSE( std::filesystem::exists( temporary ) );
+      std::filesystem::remove_all( path );
+    }
+  }
+
+  std::filesystem::remove( path );
+}
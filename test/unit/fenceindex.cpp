@@ -0,0 +1,106 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/lib/geocode/fenceindex.hpp"
+
+#include <algorithm>
+#include <random>
+
+namespace
+{
+  namespace ptest
+  {
+    spt::geocode::Polygon square( double latitude, double longitude, double size )
+    {
+      return spt::geocode::Polygon{
+        { latitude, longitude }, { latitude + size, longitude },
+        { latitude + size, longitude + size }, { latitude, longitude + size }
+      };
+    }
+  }
+}
+
+SCENARIO( "Fence index test suite", "[fenceindex]" )
+{
+  GIVEN( "A grid of overlapping geo-fences" )
+  {
+    auto polygons = std::vector<spt::geocode::Polygon>{};
+    for ( int i = 0; i < 40; ++i )
+    {
+      for ( int j = 0; j < 40; ++j ) polygons.push_back( ptest::square( 40.0 + i * 0.01, -88.0 + j * 0.01, 0.015 ) );
+    }
+    polygons.push_back( spt::geocode::Polygon{ { 40.0, -88.0 }, { 40.1, -88.0 } } );
+
+    const auto index = spt::geocode::FenceIndex{ std::span<const spt::geocode::Polygon>( polygons ) };
+    REQUIRE( index.size() == polygons.size() );
+
+    WHEN( "Querying random points" )
+    {
+      auto rng = std::mt19937{ 42 };
+      auto lat = std::uniform_real_distribution<double>{ 39.95, 40.45 };
+      auto lng = std::uniform_real_distribution<double>{ -88.05, -87.55 };
+
+      auto mismatches = 0;
+      auto found = std::vector<std::size_t>{};
+      for ( int n = 0; n < 2000; ++n )
+      {
+        const auto point = spt::geocode::Point{ lat( rng ), lng( rng ) };
+        found.clear();
+        index.query( point, found );
+        std::ranges::sort( found );
+
+        auto expected = std::vector<std::size_t>{};
+        for ( std::size_t i = 0; i < polygons.size(); ++i )
+        {
+          if ( spt::geocode::within( point, polygons[i] ) ) expected.push_back( i );
+        }
+        if ( found != expected ) ++mismatches;
+      }
+      CHECK( mismatches == 0 );
+    }
+
+    AND_WHEN( "Querying a point inside a known fence" )
+    {
+      const auto found = index.query( spt::geocode::Point{ 40.001, -87.999 } );
+      REQUIRE( found.size() == 1 );
+      CHECK( found.front() == 0 );
+      CHECK( index.fence( found.front() ).contains( 40.001, -87.999 ) );
+    }
+
+    AND_WHEN( "Querying a point outside all fences" )
+    {
+      CHECK( index.query( spt::geocode::Point{ 10.0, 10.0 } ).empty() );
+    }
+  }
+
+  GIVEN( "Geo-fences on either side of and across the antimeridian" )
+  {
+    auto fences = std::vector<spt::geocode::PreparedPolygon>{};
+    fences.emplace_back( spt::geocode::Polygon{ { -20.0, 170.0 }, { -10.0, 170.0 }, { -10.0, -170.0 }, { -20.0, -170.0 } } );
+    fences.emplace_back( spt::geocode::Polygon{ { -20.0, 160.0 }, { -10.0, 160.0 }, { -10.0, 175.0 }, { -20.0, 175.0 } } );
+    fences.emplace_back( spt::geocode::Polygon{ { -20.0, -175.0 }, { -10.0, -175.0 }, { -10.0, -160.0 }, { -20.0, -160.0 } } );
+    const auto index = spt::geocode::FenceIndex{ std::move( fences ) };
+
+    WHEN( "Querying points on either side of the antimeridian" )
+    {
+      auto east = index.query( spt::geocode::Point{ -15.0, 172.0 } );
+      std::ranges::sort( east );
+      CHECK( east == std::vector<std::size_t>{ 0, 1 } );
+
+      auto west = index.query( spt::geocode::Point{ -15.0, -172.0 } );
+      std::ranges::sort( west );
+      CHECK( west == std::vector<std::size_t>{ 0, 2 } );
+
+      CHECK( index.query( spt::geocode::Point{ -15.0, 179.0 } ) == std::vector<std::size_t>{ 0 } );
+      CHECK( index.query( spt::geocode::Point{ -15.0, 0.0 } ).empty() );
+    }
+  }
+
+  GIVEN( "An empty index" )
+  {
+    const auto index = spt::geocode::FenceIndex{};
+    CHECK( index.query( spt::geocode::Point{ 10.0, 10.0 } ).empty() );
+  }
+}
@@ -0,0 +1,104 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/lib/geocode/fencemonitor.hpp"
+
+#include <string>
+
+SCENARIO( "Fence monitor test suite", "[fencemonitor]" )
+{
+  using Monitor = spt::geocode::FenceMonitor<std::string>;
+  using spt::geocode::FenceTransition;
+  using spt::geocode::Point;
+
+  const auto polygons = std::vector<spt::geocode::Polygon>{
+    { { 40.00, -88.00 }, { 40.10, -88.00 }, { 40.10, -87.90 }, { 40.00, -87.90 } },
+    { { 40.05, -87.95 }, { 40.15, -87.95 }, { 40.15, -87.85 }, { 40.05, -87.85 } }
+  };
+  const auto start = Monitor::Clock::now();
+  auto events = std::vector<Monitor::Event>{};
+
+  GIVEN( "A monitor over two overlapping geo-fences" )
+  {
+    auto monitor = Monitor{ spt::geocode::FenceIndex{ std::span<const spt::geocode::Polygon>{ polygons } } };
+
+    WHEN( "A device moves through both fences" )
+    {
+      CHECK( monitor.update( "a", Point{ 39.95, -87.99 }, start, events ) == 0 );
+      CHECK( monitor.fences( "a" ).empty() );
+
+      CHECK( monitor.update( "a", Point{ 40.02, -87.98 }, start + std::chrono::seconds{ 1 }, events ) == 1 );
+      REQUIRE( events.size() == 1 );
+      CHECK( events.back().device == "a" );
+      CHECK( events.back().fence == 0 );
+      CHECK( events.back().transition == FenceTransition::Enter );
+
+      CHECK( monitor.update( "a", Point{ 40.07, -87.92 }, start + std::chrono::seconds{ 2 }, events ) == 1 );
+      CHECK( events.back().fence == 1 );
+      CHECK( monitor.fences( "a" ).size() == 2 );
+
+      CHECK( monitor.update( "a", Point{ 40.12, -87.88 }, start + std::chrono::seconds{ 3 }, events ) == 1 );
+      CHECK( events.back().fence == 0 );
+      CHECK( events.back().transition == FenceTransition::Exit );
+
+      CHECK( monitor.remove( "a", start + std::chrono::seconds{ 4 }, events ) == 1 );
+      CHECK( events.back().fence == 1 );
+      CHECK( events.back().transition == FenceTransition::Exit );
+      CHECK( monitor.size() == 0 );
+    }
+
+    AND_WHEN( "Updates arrive out of order" )
+    {
+      CHECK( monitor.update( "b", Point{ 40.02, -87.98 }, start + std::chrono::seconds{ 10 }, events ) == 1 );
+      CHECK( monitor.update( "b", Point{ 39.90, -87.98 }, start + std::chrono::seconds{ 5 }, events ) == 0 );
+      CHECK( monitor.fences( "b" ).size() == 1 );
+    }
+
+    AND_WHEN( "Devices are tracked independently" )
+    {
+      CHECK( monitor.update( "c", Point{ 40.02, -87.98 }, start, events ) == 1 );
+      CHECK( monitor.update( "d", Point{ 40.12, -87.88 }, start, events ) == 1 );
+      CHECK( monitor.fences( "c" ).size() == 1 );
+      CHECK( monitor.fences( "c" ).front() == 0 );
+      CHECK( monitor.fences( "d" ).front() == 1 );
+    }
+  }
+
+  GIVEN( "A monitor with hysteresis and no cells" )
+  {
+    auto monitor = Monitor{ spt::geocode::FenceIndex{ std::span<const spt::geocode::Polygon>{ polygons } },
+      spt::geocode::FenceMonitorOptions{ .hysteresis = 50.0, .cellSize = 0.0 } };
+
+    WHEN( "A device jitters across a boundary" )
+    {
+      CHECK( monitor.update( "a", Point{ 40.0001, -87.98 }, start, events ) == 1 );
+      CHECK( monitor.update( "a", Point{ 39.9999, -87.98 }, start + std::chrono::seconds{ 1 }, events ) == 0 );
+      CHECK( monitor.fences( "a" ).size() == 1 );
+
+      CHECK( monitor.update( "a", Point{ 39.999, -87.98 }, start + std::chrono::seconds{ 2 }, events ) == 1 );
+      CHECK( events.back().transition == FenceTransition::Exit );
+    }
+  }
+
+  GIVEN( "A monitor with coarse cells" )
+  {
+    auto monitor = Monitor{ spt::geocode::FenceIndex{ std::span<const spt::geocode::Polygon>{ polygons } },
+      spt::geocode::FenceMonitorOptions{ .hysteresis = 0.0, .cellSize = 0.5 } };
+
+    WHEN( "A device moves within a cell crossed by fence boundaries" )
+    {
+      CHECK( monitor.update( "a", Point{ 40.2, -87.98 }, start, events ) == 0 );
+      CHECK( monitor.update( "a", Point{ 40.02, -87.98 }, start + std::chrono::seconds{ 1 }, events ) == 1 );
+      CHECK( monitor.update( "a", Point{ 40.2, -87.98 }, start + std::chrono::seconds{ 2 }, events ) == 1 );
+    }
+
+    AND_WHEN( "A device moves within a cell clear of all fences" )
+    {
+      CHECK( monitor.update( "b", Point{ 10.1, 10.1 }, start, events ) == 0 );
+      CHECK( monitor.update( "b", Point{ 10.4, 10.4 }, start + std::chrono::seconds{ 1 }, events ) == 0 );
+      CHECK( monitor.update( "b", Point{ 40.02, -87.98 }, start + std::chrono::seconds{ 2 }, events ) == 1 );
+    }
+  }
+}
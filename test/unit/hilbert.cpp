@@ -0,0 +1,177 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "../../src/lib/geocode/hilbert.hpp"
+
+#include <random>
+
+SCENARIO( "Hilbert curve cell test suite", "[hilbert]" )
+{
+  GIVEN( "A cell at the finest level" )
+  {
+    const auto cell = spt::geocode::HilbertId::fromPoint( 47.0000625, 8.0000625 );
+
+    WHEN( "Inspecting the cell" )
+    {
+      REQUIRE( cell.valid() );
+      CHECK( cell.level() == spt::geocode::HilbertId::maxLevel );
+      CHECK( cell.bounds().contains( 47.0000625, 8.0000625 ) );
+      CHECK_THAT( cell.centre().latitude, Catch::Matchers::WithinAbs( 47.0000625, 2e-7 ) );
+      CHECK( spt::geocode::HilbertId::fromPosition( cell.position(), cell.level() ) == cell );
+      CHECK( cell.children()[0] == spt::geocode::HilbertId{} );
+    }
+
+    AND_WHEN( "Walking up the levels" )
+    {
+      for ( std::size_t level = 0; level < spt::geocode::HilbertId::maxLevel; ++level )
+      {
+        const auto parent = cell.parent( level );
+        CHECK( parent.level() == level );
+        CHECK( parent.contains( cell ) );
+        CHECK_FALSE( cell.contains( parent ) );
+        CHECK( parent == spt::geocode::HilbertId::fromPoint( 47.0000625, 8.0000625, level ) );
+        CHECK( parent.bounds().contains( 47.0000625, 8.0000625 ) );
+        CHECK( parent.position() == cell.position() >> ( 2 * ( spt::geocode::HilbertId::maxLevel - level ) ) );
+
+        const auto children = parent.children();
+        CHECK( std::ranges::is_sorted( children ) );
+        CHECK( std::ranges::count_if( children, [&cell]( const auto& c ) { return c.contains( cell ); } ) == 1 );
+        for ( const auto& c : children ) CHECK( c.parent( level ) == parent );
+      }
+    }
+  }
+
+  GIVEN( "Every cell at a coarse level" )
+  {
+    constexpr std::size_t level = 5;
+    constexpr auto side = std::size_t{ 1 } << level;
+    auto cells = std::vector<spt::geocode::HilbertId>{};
+    for ( std::size_t row = 0; row < side; ++row )
+    {
+      for ( std::size_t column = 0; column < side; ++column )
+      {
+        const auto lat = -90.0 + ( static_cast<double>( row ) + 0.5 ) * 180.0 / side;
+        const auto lng = -180.0 + ( static_cast<double>( column ) + 0.5 ) * 360.0 / side;
+        cells.push_back( spt::geocode::HilbertId::fromPoint( lat, lng, level ) );
+      }
+    }
+    std::ranges::sort( cells );
+
+    WHEN( "Following the curve" )
+    {
+      std::size_t gaps{ 0 };
+      for ( std::size_t i = 0; i < cells.size(); ++i )
+      {
+        if ( cells[i].position() != i ) ++gaps;
+        if ( i == 0 ) continue;
+
+        // Consecutive cells share an edge.
+        const auto a = cells[i - 1].bounds();
+        const auto b = cells[i].bounds();
+        const auto rows = std::abs( a.minLatitude - b.minLatitude ) / ( 180.0 / side );
+        const auto columns = std::abs( a.minLongitude - b.minLongitude ) / ( 360.0 / side );
+        if ( std::abs( rows + columns - 1.0 ) > 1e-9 ) ++gaps;
+      }
+      CHECK( gaps == 0 );
+    }
+
+    AND_WHEN( "Assigning cells to shards" )
+    {
+      auto counts = std::vector<std::size_t>( 7 );
+      for ( const auto& c : cells ) ++counts[c.shard( counts.size() )];
+      CHECK( std::ranges::is_sorted( cells, {}, []( const auto& c ) { return c.shard( 7 ); } ) );
+      CHECK( std::ranges::all_of( counts, []( std::size_t n ) { return n >= 146 && n <= 147; } ) );
+    }
+  }
+
+  GIVEN( "Points at the edges of the world" )
+  {
+    WHEN( "Encoding the points" )
+    {
+      CHECK( spt::geocode::HilbertId::fromPoint( 90.0, 180.0 ).bounds().maxLatitude == 90.0 );
+      CHECK( spt::geocode::HilbertId::fromPoint( 0.0, 180.0 ) == spt::geocode::HilbertId::fromPoint( 0.0, -180.0 ) );
+      CHECK( spt::geocode::HilbertId::fromPoint( 10.0, 190.0 ) == spt::geocode::HilbertId::fromPoint( 10.0, -170.0 ) );
+      CHECK( spt::geocode::HilbertId::fromPoint( -95.0, 0.0 ) == spt::geocode::HilbertId::fromPoint( -90.0, 0.0 ) );
+      CHECK( spt::geocode::HilbertId::fromPoint( std::nan( "" ), std::nan( "" ) ).valid() );
+    }
+  }
+}
+
+SCENARIO( "Locality sort test suite", "[hilbert]" )
+{
+  GIVEN( "Random points" )
+  {
+    auto engine = std::mt19937_64{ 44 };
+    auto latitude = std::uniform_real_distribution<double>{ -90.0, 90.0 };
+    auto longitude = std::uniform_real_distribution<double>{ -180.0, 180.0 };
+    auto points = std::vector<spt::geocode::Point>{};
+    for ( int i = 0; i < 200000; ++i )
+    {
+      points.push_back( spt::geocode::Point{ .latitude = latitude( engine ), .longitude = longitude( engine ), .accuracy = static_cast<double>( i ) } );
+    }
+    // Duplicates keep their relative order.
+    for ( int i = 0; i < 1000; ++i )
+    {
+      points.push_back( points[static_cast<std::size_t>( i )] );
+      points.back().accuracy = static_cast<double>( points.size() );
+    }
+
+    WHEN( "Sorting the points by locality" )
+    {
+      auto expected = points;
+      std::ranges::stable_sort( expected, {}, []( const auto& p ) { return spt::geocode::HilbertId::fromPoint( p ); } );
+
+      spt::geocode::sortByLocality( std::span{ points } );
+      std::size_t mismatches{ 0 };
+      for ( std::size_t i = 0; i < points.size(); ++i )
+      {
+        if ( points[i].accuracy != expected[i].accuracy ) ++mismatches;
+      }
+      CHECK( mismatches == 0 );
+    }
+
+    AND_WHEN( "Computing the locality order" )
+    {
+      const auto order = spt::geocode::localityOrder( std::span<const spt::geocode::Point>{ points } );
+      REQUIRE( order.size() == points.size() );
+      CHECK( std::ranges::is_sorted( order, {}, [&points]( std::size_t i ) { return spt::geocode::HilbertId::fromPoint( points[i] ); } ) );
+
+      auto seen = std::vector<bool>( points.size() );
+      for ( const auto i : order ) seen[i] = true;
+      CHECK( std::ranges::all_of( seen, []( bool b ) { return b; } ) );
+    }
+  }
+}
+
+SCENARIO( "Locality sort benchmark", "[.][benchmark][hilbert]" )
+{
+  auto engine = std::mt19937_64{ 44 };
+  auto latitude = std::uniform_real_distribution<double>{ -90.0, 90.0 };
+  auto longitude = std::uniform_real_distribution<double>{ -180.0, 180.0 };
+  auto points = std::vector<spt::geocode::Point>{};
+  for ( int i = 0; i < 1000000; ++i ) points.push_back( spt::geocode::Point{ .latitude = latitude( engine ), .longitude = longitude( engine ) } );
+
+  BENCHMARK( "HilbertId::fromPoint" )
+  {
+    return spt::geocode::HilbertId::fromPoint( points[engine() % points.size()] );
+  };
+
+  BENCHMARK( "sortByLocality of 1M points" )
+  {
+    auto copy = points;
+    spt::geocode::sortByLocality( std::span{ copy } );
+    return copy.front().latitude;
+  };
+
+  BENCHMARK( "std::sort of 1M precomputed HilbertId keys" )
+  {
+    auto keys = std::vector<std::pair<std::uint64_t, std::size_t>>( points.size() );
+    for ( std::size_t i = 0; i < points.size(); ++i ) keys[i] = { spt::geocode::HilbertId::fromPoint( points[i] ).value(), i };
+    std::ranges::sort( keys );
+    return keys.front().second;
+  };
+}
@@ -0,0 +1,73 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/lib/geocode/hull.hpp"
+#include "../../src/lib/geocode/impl/geofence.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+SCENARIO( "Convex hull test suite", "[hull]" )
+{
+  const auto sorted = []( const spt::geocode::Polygon& polygon )
+  {
+    auto result = std::vector<std::array<double, 2>>{};
+    for ( const auto& p : polygon ) result.push_back( { p.latitude, p.longitude } );
+    std::ranges::sort( result );
+    return result;
+  };
+
+  GIVEN( "A large set of random points" )
+  {
+    auto engine = std::mt19937_64{ 42 };
+    auto angle = std::uniform_real_distribution<double>{ 0.0, 2 * 3.14159265358979 };
+    auto radius = std::uniform_real_distribution<double>{ 0.0, 1.0 };
+    auto points = std::vector<spt::geocode::Point>{};
+    points.reserve( 300'000 );
+    for ( int i = 0; i < 300'000; ++i )
+    {
+      const auto a = angle( engine );
+      const auto r = std::sqrt( radius( engine ) ) * 0.5;
+      points.push_back( spt::geocode::Point{ 40.0 + r * std::cos( a ), -87.0 + r * std::sin( a ) } );
+    }
+
+    WHEN( "Computing the hull" )
+    {
+      const auto hull = spt::geocode::convexHull( points );
+      REQUIRE( hull.size() >= 3 );
+
+      auto input = std::vector<std::array<double, 2>>{};
+      input.reserve( points.size() );
+      for ( const auto& p : points ) input.push_back( { p.latitude, p.longitude } );
+      auto expected = geofence::getConvexHull( input );
+      std::ranges::sort( expected );
+      CHECK( sorted( hull ) == expected );
+
+      auto outside = 0;
+      for ( std::size_t i = 0; i < points.size(); i += 97 )
+      {
+        if ( !spt::geocode::within( points[i], hull ) ) ++outside;
+      }
+      CHECK( outside == 0 );
+    }
+  }
+
+  GIVEN( "A square with interior points" )
+  {
+    const auto points = std::vector<spt::geocode::Point>{
+      { 0.0, 0.0 }, { 0.5, 0.5 }, { 1.0, 0.0 }, { 0.2, 0.7 }, { 1.0, 1.0 }, { 0.0, 1.0 }, { 0.5, 0.0 }, { 0.0, 0.0 }
+    };
+    const auto hull = spt::geocode::convexHull( points );
+    CHECK( sorted( hull ) == std::vector<std::array<double, 2>>{ { 0.0, 0.0 }, { 0.0, 1.0 }, { 1.0, 0.0 }, { 1.0, 1.0 } } );
+  }
+
+  GIVEN( "Degenerate inputs" )
+  {
+    CHECK( spt::geocode::convexHull( std::vector<spt::geocode::Point>{} ).empty() );
+    CHECK( spt::geocode::convexHull( std::vector<spt::geocode::Point>{ { 1.0, 2.0 }, { 1.0, 2.0 } } ).size() == 1 );
+    CHECK( spt::geocode::convexHull( std::vector<spt::geocode::Point>{ { 1.0, 2.0 }, { 3.0, 4.0 } } ).size() == 2 );
+  }
+}
@@ -0,0 +1,214 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "../../src/lib/geocode/medoids.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <set>
+#include <thread>
+
+namespace
+{
+  namespace itest
+  {
+    struct Store
+    {
+      double latitude{ 0.0 };
+      double longitude{ 0.0 };
+      std::string text;
+    };
+
+    std::vector<spt::geocode::Point> random( std::size_t n, std::uint32_t seed )
+    {
+      auto engine = std::mt19937{ seed };
+      auto latitude = std::uniform_real_distribution<double>{ 41.6, 42.1 };
+      auto longitude = std::uniform_real_distribution<double>{ -88.0, -87.5 };
+      auto points = std::vector<spt::geocode::Point>{};
+      points.reserve( n );
+      for ( std::size_t i = 0; i < n; ++i ) points.push_back( { latitude( engine ), longitude( engine ) } );
+      return points;
+    }
+  }
+}
+
+SCENARIO( "k-medoids clustering test suite", "[medoids]" )
+{
+  GIVEN( "A list of coordinates with custom struct" )
+  {
+    const auto points = std::vector<itest::Store>{
+      {63.8066559, -83.6791916, "Far"},
+      {41.9461021, -87.6977005, "Dense"},
+      {41.9215927, -87.6953278, "Dense"},
+      {41.9121971, -87.6807251, "Dense"},
+      {60.244442, -149.6915436, "Far"},
+      {41.8827209, -87.6352386, "Dense"},
+      {41.8839951, -87.6347198, "Dense"},
+      {41.8830872, -87.6359787, "Dense"},
+      {41.883255, -87.6354523, "Dense"},
+      {41.8830147, -87.6354752, "Dense"},
+      {41.881218, -87.6351395, "Dense"},
+      {41.8841934, -87.6364594, "Dense"},
+      {41.8837547, -87.6352844, "Dense"},
+      {41.8826141, -87.6353912, "Dense"},
+      {41.8827934, -87.6357727, "Dense"},
+      {41.8830872, -87.6352005, "Dense"},
+      {41.8839989, -87.632843, "Dense"},
+      {41.8855286, -87.6347198, "Dense"},
+      {41.8848267, -87.6368179, "Dense"},
+      {41.943203, -87.7009201, "Dense"}
+    };
+
+    const auto isMember = [&points]( const itest::Store& s )
+    {
+      return std::ranges::any_of( points, [&s]( const itest::Store& p )
+      {
+        return p.latitude == s.latitude && p.longitude == s.longitude && p.text == s.text;
+      } );
+    };
+
+    WHEN( "Clustering with a full distance matrix" )
+    {
+      const auto clustered = spt::geocode::medoids( points, 3, { .seed = 42 } );
+      REQUIRE( clustered.size() == 3 );
+      CHECK( clustered[0].points.size() > 2 );
+      for ( const auto& c : clustered ) CHECK( isMember( c.centroid ) );
+      for ( const auto& p : clustered[0].points ) CHECK( p->text == "Dense" );
+      CHECK( clustered[0].centroid.text == "Dense" );
+
+      auto total = std::size_t{ 0 };
+      for ( const auto& c : clustered )
+      {
+        REQUIRE( c.statistics.has_value() );
+        total += c.points.size();
+      }
+      CHECK( total == points.size() );
+    }
+
+    AND_WHEN( "Clustering with CLARA sampling" )
+    {
+      const auto clustered = spt::geocode::medoids( points, 3,
+        { .claraThreshold = 8, .samples = 3, .sampleSize = 12, .seed = 42 } );
+      REQUIRE( clustered.size() == 3 );
+      for ( const auto& c : clustered ) CHECK( isMember( c.centroid ) );
+
+      auto total = std::size_t{ 0 };
+      for ( const auto& c : clustered ) total += c.points.size();
+      CHECK( total == points.size() );
+    }
+  }
+
+  GIVEN( "An empty set of geo coordinates" )
+  {
+    const auto points = std::vector<spt::geocode::Point>{};
+    const auto clustered = spt::geocode::medoids( points, 3 );
+    CHECK( clustered.empty() );
+  }
+
+  GIVEN( "A single geo coordinate" )
+  {
+    const auto points = std::vector<spt::geocode::Point>{ {41.9441223, -87.7002258} };
+    const auto clustered = spt::geocode::medoids( points, 3 );
+    REQUIRE( clustered.size() == 1 );
+    CHECK( clustered.front().centroid.latitude == points.front().latitude );
+    CHECK( clustered.front().centroid.longitude == points.front().longitude );
+    REQUIRE( clustered.front().points.size() == 1 );
+  }
+
+  GIVEN( "A single cluster" )
+  {
+    const auto points = std::vector<spt::geocode::Point>{
+      {41.8827209, -87.6352386}, {41.8839951, -87.6347198}, {41.8830872, -87.6359787}, {63.8066559, -83.6791916} };
+    const auto clustered = spt::geocode::medoids( points, 1, { .seed = 7 } );
+    REQUIRE( clustered.size() == 1 );
+    CHECK( clustered.front().points.size() == points.size() );
+    CHECK( clustered.front().centroid.latitude < 50.0 );
+  }
+}
+
+SCENARIO( "k-medoids swap step test suite", "[medoids]" )
+{
+  GIVEN( "A sample of the size CLARA clusters" )
+  {
+    constexpr std::size_t n = 480;
+    constexpr std::size_t k = 100;
+    const auto batch = spt::geocode::impl::swapBatch( n, k );
+
+    WHEN( "Evaluating a batch of swap candidates" )
+    {
+      auto mutex = std::mutex{};
+      auto threads = std::set<std::thread::id>{};
+      auto evaluated = std::size_t{ 0 };
+      spt::geocode::impl::parallelFor( batch, spt::geocode::impl::swapGrain, [&]( std::size_t begin, std::size_t end )
+      {
+        auto lock = std::lock_guard{ mutex };
+        threads.insert( std::this_thread::get_id() );
+        evaluated += end - begin;
+      } );
+
+      THEN( "The batch is spread over all the threads" )
+      {
+        CHECK( batch * spt::geocode::impl::swapBatches >= n - k );
+        CHECK( evaluated == batch );
+        CHECK( threads.size() == std::min( spt::geocode::impl::concurrency(), batch ) );
+      }
+    }
+  }
+
+  GIVEN( "A distance matrix and an initial assignment" )
+  {
+    const auto points = itest::random( 200, 11 );
+    auto indices = std::vector<std::size_t>( points.size() );
+    std::iota( indices.begin(), indices.end(), 0 );
+    const auto dist = spt::geocode::impl::DistanceMatrix{ points, indices };
+
+    auto medoids = std::vector<std::size_t>{ 0, 10, 20, 30, 40 };
+    auto assignment = spt::geocode::impl::MedoidAssignment{ points.size() };
+    spt::geocode::impl::assign( dist, medoids, assignment );
+
+    WHEN( "Replacing medoids one at a time" )
+    {
+      auto engine = std::mt19937{ 5 };
+      auto mismatches = 0;
+      for ( std::size_t swap = 0; swap < 50; ++swap )
+      {
+        const auto slot = engine() % medoids.size();
+        auto candidate = std::size_t{ engine() % points.size() };
+        while ( std::ranges::find( medoids, candidate ) != medoids.end() ) candidate = engine() % points.size();
+        medoids[slot] = candidate;
+        spt::geocode::impl::update( dist, medoids, slot, assignment );
+
+        auto expected = spt::geocode::impl::MedoidAssignment{ points.size() };
+        spt::geocode::impl::assign( dist, medoids, expected );
+        if ( assignment.dnearest != expected.dnearest || assignment.dsecond != expected.dsecond ) ++mismatches;
+      }
+
+      THEN( "The incremental update matches a full assignment" )
+      {
+        CHECK( mismatches == 0 );
+      }
+    }
+  }
+}
+
+SCENARIO( "k-medoids benchmark", "[.][benchmark][medoids]" )
+{
+  const auto small = itest::random( 2000, 3 );
+  const auto large = itest::random( 100000, 4 );
+
+  BENCHMARK( "medoids of 2k points with k=100" )
+  {
+    return spt::geocode::medoids( small, 100, { .seed = 42 } ).size();
+  };
+
+  BENCHMARK( "medoids of 100k points with k=100 using CLARA" )
+  {
+    return spt::geocode::medoids( large, 100, { .seed = 42 } ).size();
+  };
+}
@@ -0,0 +1,209 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace spt::geocode::test
+{
+  /**
+   * A minimal HTTP/1.1 server on the loopback interface for exercising the *positionstack* client without network
+   * access.  Connections are kept alive, and the number of connections accepted and requests served are counted,
+   * so tests can check that the client reuses connections.  Requests are recorded, so tests can check the method
+   * and headers that were sent.
+   */
+  class MockServer
+  {
+  public:
+    struct Response
+    {
+      int status{ 200 };
+      std::string body;
+    };
+
+    struct Request
+    {
+      std::string method;
+      std::string target;
+      // The header lines, without the request line.
+      std::string headers;
+      std::string body;
+    };
+
+    /// Produces the response for the request target (path and query string) and body of each request.
+    using Handler = std::function<Response( std::string_view target, std::string_view body )>;
+
+    /**
+     * Start the server on an ephemeral port.
+     * @param handler The function that produces the response for each request.
+     * @param delay Time to wait before responding to each request.
+     */
+    explicit MockServer( Handler handler, std::chrono::milliseconds delay = {} ) :
+      handler{ std::move( handler ) }, delay{ delay }
+    {
+      listener = ::socket( AF_INET, SOCK_STREAM, 0 );
+      const int yes{ 1 };
+      ::setsockopt( listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof( yes ) );
+
+      auto address = sockaddr_in{};
+      address.sin_family = AF_INET;
+      address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+      address.sin_port = 0;
+      ::bind( listener, reinterpret_cast<sockaddr*>( &address ), sizeof( address ) );
+      ::listen( listener, 64 );
+
+      auto length = socklen_t{ sizeof( address ) };
+      ::getsockname( listener, reinterpret_cast<sockaddr*>( &address ), &length );
+      portNumber = ntohs( address.sin_port );
+
+      acceptor = std::thread{ [this] { accept(); } };
+    }
+
+    ~MockServer()
+    {
+      stopping = true;
+      acceptor.join();
+      auto lock = std::lock_guard{ mutex };
+      for ( auto& worker : workers ) worker.join();
+      ::close( listener );
+    }
+
+    MockServer( const MockServer& ) = delete;
+    MockServer& operator=( const MockServer& ) = delete;
+
+    [[nodiscard]] std::uint16_t port() const { return portNumber; }
+    [[nodiscard]] std::string url() const { return std::format( "http://127.0.0.1:{}/v1", portNumber ); }
+
+    /// The number of connections accepted.
+    [[nodiscard]] std::size_t connections() const { return accepted.load(); }
+
+    /// The number of requests served.
+    [[nodiscard]] std::size_t requests() const { return served.load(); }
+
+    /// The largest number of requests being handled at the same time.
+    [[nodiscard]] std::size_t concurrency() const { return peak.load(); }
+
+    /// The requests received so far, in the order they were read.
+    [[nodiscard]] std::vector<Request> received() const
+    {
+      auto lock = std::lock_guard{ logMutex };
+      return log;
+    }
+
+  private:
+    // Wait for the socket to become readable, waking periodically to check whether the server is stopping.
+    bool readable( int fd ) const
+    {
+      auto entry = pollfd{ .fd = fd, .events = POLLIN, .revents = 0 };
+      while ( !stopping )
+      {
+        if ( ::poll( &entry, 1, 50 ) > 0 ) return true;
+      }
+      return false;
+    }
+
+    void accept()
+    {
+      while ( readable( listener ) )
+      {
+        const auto fd = ::accept( listener, nullptr, nullptr );
+        if ( fd < 0 ) continue;
+        ++accepted;
+        auto lock = std::lock_guard{ mutex };
+        workers.emplace_back( [this, fd] { serve( fd ); } );
+      }
+    }
+
+    void serve( int fd )
+    {
+      auto buffer = std::string{};
+      auto chunk = std::array<char, 4096>{};
+
+      while ( true )
+      {
+        auto end = buffer.find( "\r\n\r\n" );
+        while ( end == std::string::npos )
+        {
+          if ( !readable( fd ) ) return close( fd );
+          const auto count = ::recv( fd, chunk.data(), chunk.size(), 0 );
+          if ( count <= 0 ) return close( fd );
+          buffer.append( chunk.data(), static_cast<std::size_t>( count ) );
+          end = buffer.find( "\r\n\r\n" );
+        }
+
+        // Read the body, if the request has one.
+        std::size_t size{ 0 };
+        if ( const auto at = buffer.find( "Content-Length: " ); at < end )
+        {
+          size = std::stoul( buffer.substr( at + 16, buffer.find( "\r\n", at ) - at - 16 ) );
+        }
+        while ( buffer.size() < end + 4 + size )
+        {
+          if ( !readable( fd ) ) return close( fd );
+          const auto count = ::recv( fd, chunk.data(), chunk.size(), 0 );
+          if ( count <= 0 ) return close( fd );
+          buffer.append( chunk.data(), static_cast<std::size_t>( count ) );
+        }
+
+        const auto line = std::string_view{ buffer }.substr( 0, buffer.find( "\r\n" ) );
+        const auto first = line.find( ' ' );
+        const auto target = line.substr( first + 1, line.rfind( ' ' ) - first - 1 );
+        const auto body = std::string_view{ buffer }.substr( end + 4, size );
+        {
+          const auto headers = buffer.find( "\r\n" ) + 2;
+          auto lock = std::lock_guard{ logMutex };
+          log.push_back( Request{ .method = std::string{ line.substr( 0, first ) }, .target = std::string{ target },
+            .headers = buffer.substr( headers, end + 2 - headers ), .body = std::string{ body } } );
+        }
+
+        const auto active = ++current;
+        for ( auto previous = peak.load(); active > previous && !peak.compare_exchange_weak( previous, active ); ) {}
+        if ( delay.count() > 0 ) std::this_thread::sleep_for( delay );
+        const auto response = handler( target, body );
+        ++served;
+        --current;
+
+        const auto text = std::format( "HTTP/1.1 {} {}\r\nContent-Type: application/json\r\nContent-Length: {}\r\n"
+          "Connection: keep-alive\r\n\r\n{}", response.status, response.status == 200 ? "OK" : "Error",
+          response.body.size(), response.body );
+        if ( ::send( fd, text.data(), text.size(), MSG_NOSIGNAL ) < 0 ) return close( fd );
+        buffer.erase( 0, end + 4 + size );
+      }
+    }
+
+    static void close( int fd ) { ::close( fd ); }
+
+    Handler handler;
+    std::chrono::milliseconds delay;
+    std::thread acceptor;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    mutable std::mutex logMutex;
+    std::vector<Request> log;
+    std::atomic<std::size_t> accepted{ 0 };
+    std::atomic<std::size_t> served{ 0 };
+    std::atomic<std::size_t> current{ 0 };
+    std::atomic<std::size_t> peak{ 0 };
+    std::atomic<bool> stopping{ false };
+    int listener{ -1 };
+    std::uint16_t portNumber{ 0 };
+  };
+}
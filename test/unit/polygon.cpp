@@ -0,0 +1,258 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/lib/geocode/polygon.hpp"
+
+#include <cmath>
+
+SCENARIO( "Prepared polygon test suite", "[polygon]" )
+{
+  GIVEN( "A concave geo-fence" )
+  {
+    const auto polygon = spt::geocode::Polygon{
+      { 41.88, -87.64 }, { 41.90, -87.64 }, { 41.90, -87.62 },
+      { 41.89, -87.63 }, { 41.88, -87.62 }
+    };
+    const auto prepared = spt::geocode::PreparedPolygon{ polygon };
+    CHECK( prepared.size() == polygon.size() );
+    CHECK( prepared.bounds().minLatitude == 41.88 );
+    CHECK( prepared.bounds().maxLongitude == -87.62 );
+
+    WHEN( "Checking points inside and outside" )
+    {
+      CHECK( prepared.contains( spt::geocode::Point{ 41.885, -87.635 } ) );
+      CHECK_FALSE( prepared.contains( spt::geocode::Point{ 41.89, -87.622 } ) );
+      CHECK_FALSE( spt::geocode::within( spt::geocode::Point{ 41.89, -87.622 }, polygon ) );
+      CHECK_FALSE( prepared.contains( spt::geocode::Point{ 42.0, -87.0 } ) );
+      CHECK( spt::geocode::within( spt::geocode::Point{ 41.885, -87.635 }, prepared ) );
+    }
+
+    AND_WHEN( "Checking a vertex" )
+    {
+      CHECK( prepared.contains( polygon[3] ) );
+      CHECK( spt::geocode::within( polygon[3], polygon ) );
+    }
+
+    AND_WHEN( "Comparing against within for a grid of points" )
+    {
+      auto mismatches = 0;
+      for ( int i = 0; i <= 50; ++i )
+      {
+        for ( int j = 0; j <= 50; ++j )
+        {
+          const auto point = spt::geocode::Point{ 41.875 + i * 0.0005123, -87.645 + j * 0.0005321 };
+          if ( prepared.contains( point ) != spt::geocode::within( point, polygon ) ) ++mismatches;
+        }
+      }
+      CHECK( mismatches == 0 );
+    }
+  }
+
+  GIVEN( "A degenerate geo-fence" )
+  {
+    const auto prepared = spt::geocode::PreparedPolygon{ spt::geocode::Polygon{ { 41.88, -87.64 }, { 41.90, -87.64 } } };
+    CHECK( prepared.size() == 0 );
+    CHECK_FALSE( prepared.contains( spt::geocode::Point{ 41.88, -87.64 } ) );
+  }
+}
+
+SCENARIO( "Batch point in polygon test suite", "[polygon]" )
+{
+  GIVEN( "A concave geo-fence and a batch of points" )
+  {
+    const auto polygon = spt::geocode::Polygon{
+      { 41.88, -87.64 }, { 41.90, -87.64 }, { 41.90, -87.62 },
+      { 41.89, -87.63 }, { 41.88, -87.62 }
+    };
+    const auto prepared = spt::geocode::PreparedPolygon{ polygon };
+
+    auto points = std::vector<spt::geocode::Point>{};
+    for ( int i = 0; i <= 120; ++i )
+    {
+      for ( int j = 0; j <= 120; ++j ) points.push_back( { 41.875 + i * 0.0002123, -87.645 + j * 0.0002321 } );
+    }
+    points.push_back( polygon[3] );
+
+    WHEN( "Checking the batch" )
+    {
+      auto out = std::vector<std::uint8_t>( points.size(), 2 );
+      spt::geocode::containsBatch( prepared, std::span<const spt::geocode::Point>( points ), std::span<std::uint8_t>( out ) );
+
+      auto mismatches = 0;
+      for ( std::size_t i = 0; i < points.size(); ++i )
+      {
+        if ( ( out[i] == 1 ) != spt::geocode::within( points[i], polygon ) ) ++mismatches;
+      }
+      CHECK( mismatches == 0 );
+      CHECK( out.back() == 1 );
+    }
+
+    AND_WHEN( "The output is shorter than the batch" )
+    {
+      auto out = std::vector<std::uint8_t>( 10, 2 );
+      spt::geocode::containsBatch( prepared, std::span<const spt::geocode::Point>( points ), std::span<std::uint8_t>( out ) );
+      for ( const auto o : out ) CHECK( o < 2 );
+    }
+  }
+}
+
+SCENARIO( "Prepared polygon grid test suite", "[polygon]" )
+{
+  GIVEN( "A complex star shaped geo-fence" )
+  {
+    auto polygon = spt::geocode::Polygon{};
+    polygon.reserve( 1000 );
+    for ( int i = 0; i < 1000; ++i )
+    {
+      const auto angle = i * 2 * 3.14159265358979 / 1000;
+      const auto radius = 1 + 0.3 * std::sin( 7 * angle ) + ( i % 2 == 0 ? 0.05 : 0.0 );
+      polygon.push_back( spt::geocode::Point{ 40 + radius * std::cos( angle ), -87 + radius * std::sin( angle ) } );
+    }
+
+    const auto plain = spt::geocode::PreparedPolygon{ polygon };
+    const auto gridded = spt::geocode::PreparedPolygon{ polygon, 32 };
+    CHECK( plain.gridSize() == 0 );
+    CHECK( gridded.gridSize() == 32 );
+
+    WHEN( "Comparing against the full scan for a grid of points" )
+    {
+      auto mismatches = 0;
+      auto inside = 0;
+      for ( int i = 0; i <= 300; ++i )
+      {
+        for ( int j = 0; j <= 300; ++j )
+        {
+          const auto lat = 38.6 + i * 0.00931;
+          const auto lng = -88.4 + j * 0.00931;
+          const auto expected = plain.contains( lat, lng );
+          if ( expected ) ++inside;
+          if ( gridded.contains( lat, lng ) != expected ) ++mismatches;
+        }
+      }
+      CHECK( inside > 0 );
+      CHECK( mismatches == 0 );
+    }
+
+    AND_WHEN( "Checking vertices" )
+    {
+      auto missed = 0;
+      for ( const auto& p : polygon ) if ( !gridded.contains( p ) ) ++missed;
+      CHECK( missed == 0 );
+    }
+
+    AND_WHEN( "Checking a batch" )
+    {
+      auto lats = std::vector<double>{ 40.0, 41.5, 38.0, polygon[10].latitude };
+      auto lngs = std::vector<double>{ -87.0, -87.0, -87.0, polygon[10].longitude };
+      auto out = std::vector<std::uint8_t>( lats.size(), 2 );
+      gridded.contains( lats, lngs, out );
+      for ( std::size_t i = 0; i < out.size(); ++i ) CHECK( out[i] == static_cast<std::uint8_t>( plain.contains( lats[i], lngs[i] ) ) );
+      CHECK( out[3] == 1 );
+    }
+
+    AND_WHEN( "Relating areas of several sizes to the polygon" )
+    {
+      auto mismatches = 0;
+      auto partial = 0;
+      for ( const auto size : { 0.001, 0.01, 0.1, 0.5, 3.0 } )
+      {
+        for ( int i = 0; i <= 60; ++i )
+        {
+          for ( int j = 0; j <= 60; ++j )
+          {
+            const auto lat = 38.5 + i * 0.05;
+            const auto lng = -88.5 + j * 0.05;
+            const auto bounds = spt::geocode::BoundingBox{ .minLatitude = lat, .minLongitude = lng, .maxLatitude = lat + size, .maxLongitude = lng + size };
+            const auto expected = plain.relate( bounds );
+            if ( expected == spt::geocode::PreparedPolygon::Relation::Partial ) ++partial;
+            if ( gridded.relate( bounds ) != expected ) ++mismatches;
+          }
+        }
+      }
+      CHECK( partial > 0 );
+      CHECK( mismatches == 0 );
+    }
+  }
+}
+
+SCENARIO( "Polygon with holes and multipolygon test suite", "[polygon]" )
+{
+  GIVEN( "A geo-fence with a hole" )
+  {
+    const auto polygon = spt::geocode::PolygonWithHoles{
+      .outer = { { 41.80, -87.70 }, { 41.90, -87.70 }, { 41.90, -87.60 }, { 41.80, -87.60 } },
+      .holes = { { { 41.84, -87.66 }, { 41.86, -87.66 }, { 41.86, -87.64 }, { 41.84, -87.64 } } }
+    };
+    const auto prepared = spt::geocode::PreparedPolygon{ polygon };
+    const auto gridded = spt::geocode::PreparedPolygon{ polygon, 8 };
+    CHECK( prepared.size() == 8 );
+
+    WHEN( "Checking points in the outer ring and in the hole" )
+    {
+      for ( const auto* p : { &prepared, &gridded } )
+      {
+        CHECK( p->contains( 41.82, -87.68 ) );
+        CHECK_FALSE( p->contains( 41.85, -87.65 ) );
+        CHECK_FALSE( p->contains( 41.95, -87.65 ) );
+        CHECK( p->contains( polygon.holes.front()[2] ) );
+      }
+    }
+  }
+
+  GIVEN( "A multipolygon with two parts" )
+  {
+    const auto polygon = spt::geocode::MultiPolygon{
+      { .outer = { { 10.0, 10.0 }, { 11.0, 10.0 }, { 11.0, 11.0 }, { 10.0, 11.0 } }, .holes = {} },
+      { .outer = { { 20.0, 20.0 }, { 21.0, 20.0 }, { 21.0, 21.0 }, { 20.0, 21.0 } }, .holes = {} }
+    };
+    const auto prepared = spt::geocode::PreparedPolygon{ polygon };
+
+    WHEN( "Checking points in each part and between the parts" )
+    {
+      CHECK( prepared.contains( 10.5, 10.5 ) );
+      CHECK( prepared.contains( 20.5, 20.5 ) );
+      CHECK_FALSE( prepared.contains( 15.0, 15.0 ) );
+
+      auto lats = std::vector<double>{ 10.5, 20.5, 15.0 };
+      auto lngs = std::vector<double>{ 10.5, 20.5, 15.0 };
+      auto out = std::vector<std::uint8_t>( 3, 2 );
+      prepared.contains( lats, lngs, out );
+      CHECK( out == std::vector<std::uint8_t>{ 1, 1, 0 } );
+    }
+  }
+
+  GIVEN( "A geo-fence with a hole that crosses the antimeridian" )
+  {
+    const auto polygon = spt::geocode::PolygonWithHoles{
+      .outer = { { -20.0, 170.0 }, { -10.0, 170.0 }, { -10.0, -170.0 }, { -20.0, -170.0 } },
+      .holes = { { { -16.0, -178.0 }, { -14.0, -178.0 }, { -14.0, -172.0 }, { -16.0, -172.0 } } }
+    };
+    const auto prepared = spt::geocode::PreparedPolygon{ polygon };
+    CHECK( prepared.bounds().minLongitude == 170.0 );
+    CHECK( prepared.bounds().maxLongitude == 190.0 );
+
+    WHEN( "Checking points on either side of the antimeridian" )
+    {
+      CHECK( prepared.contains( -12.0, 175.0 ) );
+      CHECK( prepared.contains( -12.0, -175.0 ) );
+      CHECK( prepared.contains( -12.0, 180.0 ) );
+      CHECK( prepared.contains( -12.0, -180.0 ) );
+      CHECK_FALSE( prepared.contains( -15.0, -175.0 ) );
+      CHECK_FALSE( prepared.contains( -12.0, 0.0 ) );
+      CHECK_FALSE( prepared.contains( -12.0, 165.0 ) );
+      CHECK_FALSE( prepared.contains( -12.0, -165.0 ) );
+      CHECK( prepared.contains( polygon.outer[2] ) );
+    }
+
+    AND_WHEN( "Checking a batch" )
+    {
+      auto lats = std::vector<double>{ -12.0, -12.0, -15.0, -12.0 };
+      auto lngs = std::vector<double>{ 175.0, -175.0, -175.0, 0.0 };
+      auto out = std::vector<std::uint8_t>( 4, 2 );
+      prepared.contains( lats, lngs, out );
+      CHECK( out == std::vector<std::uint8_t>{ 1, 1, 0, 0 } );
+    }
+  }
+}
@@ -0,0 +1,149 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "../../src/lib/geocode/shapes.hpp"
+
+#include <cmath>
+#include <random>
+
+SCENARIO( "Circle fence test suite", "[shapes]" )
+{
+  GIVEN( "A circle with a radius of 1km" )
+  {
+    const auto centre = spt::geocode::Point{ .latitude = 51.5073, .longitude = -0.1277 };
+    const auto fence = spt::geocode::CircleFence{ centre, 1000.0 };
+
+    WHEN( "Checking random points around the centre" )
+    {
+      auto engine = std::mt19937_64{ 37 };
+      auto offset = std::uniform_real_distribution<double>{ -0.02, 0.02 };
+      std::size_t inside{ 0 };
+      for ( int i = 0; i < 20000; ++i )
+      {
+        const auto p = spt::geocode::Point{ .latitude = centre.latitude + offset( engine ), .longitude = centre.longitude + offset( engine ) };
+        const auto expected = spt::geocode::distance( centre, p ).distance <= 1000.0;
+        CHECK( fence.contains( p ) == expected );
+        if ( expected ) ++inside;
+      }
+      CHECK( inside > 0 );
+    }
+
+    AND_WHEN( "Checking the bounding box" )
+    {
+      CHECK( fence.bounds().contains( centre.latitude, centre.longitude ) );
+      CHECK_FALSE( fence.contains( centre.latitude + 0.01, centre.longitude ) );
+      CHECK( fence.contains( centre.latitude + 0.008, centre.longitude ) );
+      CHECK( fence.contains( centre ) );
+    }
+  }
+
+  GIVEN( "A circle that crosses the antimeridian" )
+  {
+    const auto fence = spt::geocode::CircleFence{ spt::geocode::Point{ .latitude = 0.0, .longitude = 179.99 }, 5000.0 };
+    CHECK( fence.contains( 0.0, -179.99 ) );
+    CHECK( fence.contains( 0.0, 180.0 ) );
+    CHECK_FALSE( fence.contains( 0.0, -179.9 ) );
+    CHECK( fence.bounds().maxLongitude > 180.0 );
+  }
+
+  GIVEN( "A circle that encloses the north pole" )
+  {
+    const auto fence = spt::geocode::CircleFence{ spt::geocode::Point{ .latitude = 89.99, .longitude = 0.0 }, 10000.0 };
+    CHECK( fence.contains( 89.99, 180.0 ) );
+    CHECK( fence.contains( 90.0, 0.0 ) );
+    CHECK_FALSE( fence.contains( 89.8, 45.0 ) );
+  }
+}
+
+SCENARIO( "Corridor fence test suite", "[shapes]" )
+{
+  GIVEN( "A route along the equator with a width of 100m" )
+  {
+    const auto fence = spt::geocode::CorridorFence{ { { .latitude = 0.0, .longitude = 0.0 }, { .latitude = 0.0, .longitude = 1.0 } }, 100.0 };
+    CHECK( fence.contains( 0.0008, 0.5 ) );
+    CHECK( fence.contains( -0.0008, 0.5 ) );
+    CHECK_FALSE( fence.contains( 0.001, 0.5 ) );
+    CHECK( fence.contains( 0.0, 1.0008 ) );
+    CHECK_FALSE( fence.contains( 0.0, 1.001 ) );
+    CHECK_FALSE( fence.contains( 0.0, -0.001 ) );
+    CHECK( std::abs( fence.distance( 0.001, 0.5 ) - 111.2 ) < 0.1 );
+  }
+
+  GIVEN( "A route whose great circle bulges towards the pole" )
+  {
+    const auto fence = spt::geocode::CorridorFence{ { { .latitude = 50.0, .longitude = -30.0 }, { .latitude = 50.0, .longitude = 30.0 } }, 100.0 };
+    const auto vertex = spt::geocode::radiansToDegrees( std::atan( std::tan( spt::geocode::degreesToRadians( 50.0 ) ) /
+      std::cos( spt::geocode::degreesToRadians( 30.0 ) ) ) );
+    CHECK( fence.contains( vertex, 0.0 ) );
+    CHECK_FALSE( fence.contains( 50.0, 0.0 ) );
+  }
+
+  GIVEN( "A route that crosses the antimeridian" )
+  {
+    const auto fence = spt::geocode::CorridorFence{ { { .latitude = 10.0, .longitude = 179.9 }, { .latitude = 10.0, .longitude = -179.9 } }, 100.0 };
+    CHECK( fence.contains( 10.0, 180.0 ) );
+    CHECK( fence.contains( 10.0, -180.0 ) );
+    CHECK( fence.contains( 10.0, -179.95 ) );
+    CHECK_FALSE( fence.contains( 10.0, 0.0 ) );
+    CHECK( fence.bounds().maxLongitude > 180.0 );
+  }
+
+  GIVEN( "A winding route with many segments" )
+  {
+    auto engine = std::mt19937_64{ 41 };
+    auto step = std::uniform_real_distribution<double>{ -0.002, 0.002 };
+    auto route = std::vector<spt::geocode::Point>{};
+    route.push_back( spt::geocode::Point{ .latitude = 41.88, .longitude = -87.63 } );
+    for ( int i = 0; i < 2000; ++i )
+    {
+      const auto& last = route.back();
+      route.push_back( spt::geocode::Point{ .latitude = last.latitude + step( engine ), .longitude = last.longitude + 0.001 + step( engine ) } );
+    }
+    const auto fence = spt::geocode::CorridorFence{ route, 250.0 };
+    const auto& box = fence.bounds();
+
+    WHEN( "Checking random points against the distance to every segment" )
+    {
+      auto latitude = std::uniform_real_distribution<double>{ box.minLatitude, box.maxLatitude };
+      auto longitude = std::uniform_real_distribution<double>{ box.minLongitude, box.maxLongitude };
+      std::size_t inside{ 0 };
+      for ( int i = 0; i < 20000; ++i )
+      {
+        const auto lat = latitude( engine );
+        const auto lng = longitude( engine );
+        const auto expected = fence.distance( lat, lng ) <= 250.0;
+        CHECK( fence.contains( lat, lng ) == expected );
+        if ( expected ) ++inside;
+      }
+      CHECK( inside > 0 );
+    }
+  }
+}
+
+SCENARIO( "Corridor fence benchmark", "[.][benchmark][shapes]" )
+{
+  auto engine = std::mt19937_64{ 41 };
+  auto step = std::uniform_real_distribution<double>{ -0.002, 0.002 };
+  auto route = std::vector<spt::geocode::Point>{};
+  route.push_back( spt::geocode::Point{ .latitude = 41.88, .longitude = -87.63 } );
+  for ( int i = 0; i < 2000; ++i )
+  {
+    const auto& last = route.back();
+    route.push_back( spt::geocode::Point{ .latitude = last.latitude + step( engine ), .longitude = last.longitude + 0.001 + step( engine ) } );
+  }
+  const auto fence = spt::geocode::CorridorFence{ route, 250.0 };
+  const auto& box = fence.bounds();
+
+  auto latitude = std::uniform_real_distribution<double>{ box.minLatitude, box.maxLatitude };
+  auto longitude = std::uniform_real_distribution<double>{ box.minLongitude, box.maxLongitude };
+  auto points = std::vector<spt::geocode::Point>{};
+  for ( int i = 0; i < 100000; ++i ) points.push_back( spt::geocode::Point{ .latitude = latitude( engine ), .longitude = longitude( engine ) } );
+
+  BENCHMARK( "CorridorFence::contains with 2001 vertices" )
+  {
+    return fence.contains( points[engine() % points.size()] );
+  };
+}
@@ -0,0 +1,140 @@
+//
+// Created by Rakesh on 18/10/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/lib/geocode/simplify.hpp"
+
+#include <cmath>
+#include <random>
+#include <utility>
+
+namespace
+{
+  namespace psimplify
+  {
+    bool crosses( const spt::geocode::Polygon& polygon )
+    {
+      const auto orient = []( const spt::geocode::Point& a, const spt::geocode::Point& b, const spt::geocode::Point& c )
+      {
+        const auto o = ( b.latitude - a.latitude ) * ( c.longitude - a.longitude ) - ( b.longitude - a.longitude ) * ( c.latitude - a.latitude );
+        return o > 0 ? 1 : ( o < 0 ? -1 : 0 );
+      };
+
+      const auto n = polygon.size();
+      for ( std::size_t i = 0; i < n; ++i )
+      {
+        for ( std::size_t j = i + 2; j < n; ++j )
+        {
+          if ( i == 0 && j == n - 1 ) continue;
+          const auto& a = polygon[i];
+          const auto& b = polygon[( i + 1 ) % n];
+          const auto& c = polygon[j];
+          const auto& d = polygon[( j + 1 ) % n];
+          if ( orient( a, b, c ) * orient( a, b, d ) < 0 && orient( c, d, a ) * orient( c, d, b ) < 0 ) return true;
+        }
+      }
+      return false;
+    }
+
+    spt::geocode::Polygon star( std::mt19937_64& engine, std::size_t size, double noise )
+    {
+      auto jitter = std::uniform_real_distribution<double>{ -noise, noise };
+      auto polygon = spt::geocode::Polygon{};
+      polygon.reserve( size );
+      for ( std::size_t i = 0; i < size; ++i )
+      {
+        const auto angle = static_cast<double>( i ) * 2 * 3.14159265358979 / static_cast<double>( size );
+        const auto radius = 0.01 * ( 1 + 0.5 * std::sin( 9 * angle ) ) + jitter( engine );
+        polygon.push_back( spt::geocode::Point{ 40.0 + radius * std::cos( angle ), -87.0 + radius * std::sin( angle ) } );
+      }
+      return polygon;
+    }
+  }
+}
+
+SCENARIO( "Polygon simplification test suite", "[simplify]" )
+{
+  using spt::geocode::SimplifyMethod;
+  using spt::geocode::SimplifyOptions;
+
+  GIVEN( "A square with collinear vertices along each side" )
+  {
+    const auto polygon = spt::geocode::Polygon{
+      { 40.0, -87.0 }, { 40.005, -87.0 }, { 40.01, -87.0 }, { 40.01, -86.995 }, { 40.01, -86.99 },
+      { 40.005, -86.99 }, { 40.0, -86.99 }, { 40.0, -86.995 }
+    };
+
+    for ( const auto method : { SimplifyMethod::DouglasPeucker, SimplifyMethod::VisvalingamWhyatt } )
+    {
+      const auto result = spt::geocode::simplify( polygon, SimplifyOptions{ .tolerance = 5.0, .method = method } );
+      REQUIRE( result.size() == 4 );
+      for ( const auto& p : result ) CHECK( ( p.latitude == 40.0 || p.latitude == 40.01 ) );
+      for ( const auto& p : result ) CHECK( ( p.longitude == -87.0 || p.longitude == -86.99 ) );
+    }
+
+    CHECK( spt::geocode::simplify( polygon, SimplifyOptions{ .tolerance = 0.0 } ).size() == polygon.size() );
+
+    auto closed = polygon;
+    closed.push_back( polygon.front() );
+    const auto result = spt::geocode::simplify( closed, SimplifyOptions{ .tolerance = 1.0 } );
+    REQUIRE( result.size() == 5 );
+    CHECK( result.front().latitude == result.back().latitude );
+    CHECK( result.front().longitude == result.back().longitude );
+  }
+
+  GIVEN( "A noisy star shaped polygon" )
+  {
+    auto engine = std::mt19937_64{ 7 };
+    const auto polygon = psimplify::star( engine, 2000, 0.00002 );
+
+    WHEN( "Simplifying with a tolerance above the noise" )
+    {
+      for ( const auto method : { SimplifyMethod::DouglasPeucker, SimplifyMethod::VisvalingamWhyatt } )
+      {
+        const auto result = spt::geocode::simplify( polygon, SimplifyOptions{ .tolerance = 10.0, .method = method } );
+        CHECK( result.size() >= 3 );
+        CHECK( result.size() < polygon.size() / 4 );
+
+        // Output vertices are input vertices in the same order
+        std::size_t j{ 0 };
+        for ( const auto& p : result )
+        {
+          while ( j < polygon.size() && ( polygon[j].latitude != p.latitude || polygon[j].longitude != p.longitude ) ) ++j;
+          CHECK( j < polygon.size() );
+        }
+      }
+    }
+
+    AND_WHEN( "Simplifying a batch" )
+    {
+      const auto polygons = std::vector<spt::geocode::Polygon>( 50, polygon );
+      const auto results = spt::geocode::simplify( polygons, SimplifyOptions{ .tolerance = 10.0 } );
+      const auto expected = spt::geocode::simplify( polygon, SimplifyOptions{ .tolerance = 10.0 } );
+      REQUIRE( results.size() == polygons.size() );
+      for ( const auto& r : results ) CHECK( r.size() == expected.size() );
+    }
+  }
+
+  GIVEN( "A polygon with a finger that reaches into a shallow notch" )
+  {
+    // Dropping the bottom of the notch alone pulls the boundary through the finger.
+    auto polygon = spt::geocode::Polygon{};
+    for ( const auto& [x, y] : std::vector<std::pair<double, double>>{ { 0, 0 }, { 5, -3 }, { 10, 0 }, { 20, 0 }, { 20, 6 },
+      { 6.5, 6 }, { 6.5, -1 }, { 3.5, -1 }, { 3.5, 7 }, { -5, 7 }, { -5, 0 } } )
+    {
+      polygon.push_back( spt::geocode::Point{ y * 0.001, x * 0.001 } );
+    }
+    REQUIRE_FALSE( psimplify::crosses( polygon ) );
+
+    WHEN( "Simplifying with and without preserving topology" )
+    {
+      const auto simplified = spt::geocode::simplify( polygon, SimplifyOptions{ .tolerance = 400.0 } );
+      CHECK( psimplify::crosses( simplified ) );
+
+      const auto preserved = spt::geocode::simplify( polygon, SimplifyOptions{ .tolerance = 400.0, .preserveTopology = true } );
+      CHECK_FALSE( psimplify::crosses( preserved ) );
+      CHECK( preserved.size() < polygon.size() );
+    }
+  }
+}